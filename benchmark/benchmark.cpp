@@ -0,0 +1,335 @@
+// Standalone micro-benchmark of the engine-independent core.
+// Build with `scons benchmark` and run bin/benchmark/big_number_benchmark.
+// Optional arguments: <samples> <operations per sample>.
+
+#include "core/batch.hpp"
+#include "core/big_number_core.hpp"
+#include "core/compensated_sum.hpp"
+#include "core/log_domain.hpp"
+#include "core/number_format.hpp"
+#include "core/sort_key.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+struct Input {
+	std::vector<double> mantissas;
+	std::vector<int64_t> exponents;
+	std::vector<double> other_mantissas;
+	std::vector<int64_t> other_exponents;
+	std::vector<double> raw;
+};
+
+// Keeps results alive so the compiler cannot drop the work
+volatile double sink_double = 0.0;
+volatile int64_t sink_int = 0;
+
+Input make_input(size_t p_count) {
+	std::mt19937_64 rng(12345);
+	std::uniform_real_distribution<double> mantissa(1.0, 10.0);
+	std::uniform_int_distribution<int64_t> exponent(0, 300);
+	std::uniform_real_distribution<double> raw(-12.0, 12.0);
+
+	Input input;
+	for (size_t i = 0; i < p_count; i++) {
+		input.mantissas.push_back(mantissa(rng));
+		input.exponents.push_back(exponent(rng));
+		input.other_mantissas.push_back(mantissa(rng));
+		input.other_exponents.push_back(exponent(rng));
+		// Unnormalized values spread over many decades
+		input.raw.push_back(mantissa(rng) * std::pow(10.0, raw(rng)));
+	}
+	return input;
+}
+
+double percentile(const std::vector<double> &p_sorted, double p_fraction) {
+	size_t index = (size_t)(p_fraction * (double)(p_sorted.size() - 1) + 0.5);
+	return p_sorted[index];
+}
+
+// Runs p_operation p_ops times per sample and prints the ns/op spread
+void run(const char *p_name, int p_samples, int p_ops, const std::function<void(int)> &p_operation) {
+	// Warm up caches and branch predictors
+	p_operation(p_ops);
+
+	std::vector<double> results;
+	results.reserve(p_samples);
+	for (int s = 0; s < p_samples; s++) {
+		auto start = std::chrono::steady_clock::now();
+		p_operation(p_ops);
+		auto end = std::chrono::steady_clock::now();
+		double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		results.push_back(ns / (double)p_ops);
+	}
+	std::sort(results.begin(), results.end());
+
+	printf("%-16s %10.2f %10.2f %10.2f %10.2f %10.2f\n", p_name,
+			percentile(results, 0.0), percentile(results, 0.5), percentile(results, 0.9),
+			percentile(results, 0.99), percentile(results, 1.0));
+}
+} // namespace
+
+int main(int argc, char **argv) {
+	int samples = argc > 1 ? atoi(argv[1]) : 200;
+	int ops = argc > 2 ? atoi(argv[2]) : 10000;
+	if (samples < 1 || ops < 1) {
+		fprintf(stderr, "usage: %s [samples] [operations per sample]\n", argv[0]);
+		return 1;
+	}
+
+	const size_t count = 4096;
+	const Input input = make_input(count);
+	const size_t mask = count - 1;
+
+	printf("%d samples of %d operations, ns/op, %s batch kernels\n", samples, ops, BigNumberBatch::get_kernel_name());
+	printf("%-16s %10s %10s %10s %10s %10s\n", "operation", "min", "p50", "p90", "p99", "max");
+
+	run("normalize", samples, ops, [&](int p_ops) {
+		double total = 0.0;
+		for (int i = 0; i < p_ops; i++) {
+			double m = input.raw[i & mask];
+			int64_t e = 0;
+			BigNumberCore::normalize(m, e);
+			total += m + (double)e;
+		}
+		sink_double = total;
+	});
+
+	run("add", samples, ops, [&](int p_ops) {
+		double m = 1.0;
+		int64_t e = 0;
+		for (int i = 0; i < p_ops; i++) {
+			BigNumberCore::add(m, e, input.mantissas[i & mask], input.exponents[i & mask]);
+		}
+		sink_double = m + (double)e;
+	});
+
+	run("accumulate", samples, ops, [&](int p_ops) {
+		CompensatedSum::Accumulator sum;
+		for (int i = 0; i < p_ops; i++) {
+			sum.add(input.mantissas[i & mask], input.exponents[i & mask]);
+		}
+		double m;
+		int64_t e;
+		sum.get_total(m, e);
+		sink_double = m + (double)e;
+	});
+
+	run("multiply_add", samples, ops, [&](int p_ops) {
+		double m = 1.0;
+		int64_t e = 0;
+		for (int i = 0; i < p_ops; i++) {
+			double product_m = input.mantissas[i & mask];
+			int64_t product_e = input.exponents[i & mask];
+			BigNumberCore::multiply(product_m, product_e, input.other_mantissas[i & mask], input.other_exponents[i & mask]);
+			BigNumberCore::add(m, e, product_m, product_e);
+		}
+		sink_double = m + (double)e;
+	});
+
+	run("fma", samples, ops, [&](int p_ops) {
+		double m = 1.0;
+		int64_t e = 0;
+		for (int i = 0; i < p_ops; i++) {
+			BigNumberCore::fma(m, e, input.mantissas[i & mask], input.exponents[i & mask], input.other_mantissas[i & mask], input.other_exponents[i & mask]);
+		}
+		sink_double = m + (double)e;
+	});
+
+	run("multiply", samples, ops, [&](int p_ops) {
+		double total = 0.0;
+		for (int i = 0; i < p_ops; i++) {
+			double m = input.mantissas[i & mask];
+			int64_t e = input.exponents[i & mask];
+			BigNumberCore::multiply(m, e, input.other_mantissas[i & mask], input.other_exponents[i & mask]);
+			total += m + (double)e;
+		}
+		sink_double = total;
+	});
+
+	run("divide", samples, ops, [&](int p_ops) {
+		double total = 0.0;
+		for (int i = 0; i < p_ops; i++) {
+			double m = input.mantissas[i & mask];
+			int64_t e = input.exponents[i & mask];
+			BigNumberCore::divide(m, e, input.other_mantissas[i & mask], input.other_exponents[i & mask]);
+			total += m + (double)e;
+		}
+		sink_double = total;
+	});
+
+	run("power_int", samples, ops, [&](int p_ops) {
+		double total = 0.0;
+		for (int i = 0; i < p_ops; i++) {
+			double m = input.mantissas[i & mask];
+			int64_t e = input.exponents[i & mask];
+			BigNumberCore::power_int(m, e, 3);
+			total += m + (double)e;
+		}
+		sink_double = total;
+	});
+
+	run("power_float", samples, ops, [&](int p_ops) {
+		double total = 0.0;
+		for (int i = 0; i < p_ops; i++) {
+			double m = input.mantissas[i & mask];
+			int64_t e = input.exponents[i & mask];
+			BigNumberCore::power_float(m, e, 1.15);
+			total += m + (double)e;
+		}
+		sink_double = total;
+	});
+
+	run("log_power", samples, ops, [&](int p_ops) {
+		double total = 0.0;
+		for (int i = 0; i < p_ops; i++) {
+			double l = LogDomain::from_parts(input.mantissas[i & mask], input.exponents[i & mask]);
+			bool negative = false;
+			LogDomain::power(l, negative, 1.15);
+			total += l;
+		}
+		sink_double = total;
+	});
+
+	run("square_root", samples, ops, [&](int p_ops) {
+		double total = 0.0;
+		for (int i = 0; i < p_ops; i++) {
+			double m = input.mantissas[i & mask];
+			int64_t e = input.exponents[i & mask];
+			BigNumberCore::square_root(m, e);
+			total += m + (double)e;
+		}
+		sink_double = total;
+	});
+
+	run("mod", samples, ops, [&](int p_ops) {
+		double total = 0.0;
+		for (int i = 0; i < p_ops; i++) {
+			double m = input.mantissas[i & mask];
+			int64_t e = input.exponents[i & mask] % 12;
+			BigNumberCore::mod(m, e, input.other_mantissas[i & mask], 1);
+			total += m + (double)e;
+		}
+		sink_double = total;
+	});
+
+	run("is_less_than", samples, ops, [&](int p_ops) {
+		int64_t total = 0;
+		for (int i = 0; i < p_ops; i++) {
+			total += BigNumberCore::is_less_than(input.mantissas[i & mask], input.exponents[i & mask],
+					input.other_mantissas[i & mask], input.other_exponents[i & mask]);
+		}
+		sink_int = total;
+	});
+
+	run("sort_key", samples, ops, [&](int p_ops) {
+		int64_t total = 0;
+		for (int i = 0; i < p_ops; i++) {
+			total += SortKey::encode(input.mantissas[i & mask], input.exponents[i & mask]);
+		}
+		sink_int = total;
+	});
+
+	run("is_equal", samples, ops, [&](int p_ops) {
+		int64_t total = 0;
+		for (int i = 0; i < p_ops; i++) {
+			total += BigNumberCore::is_equal(input.mantissas[i & mask], input.exponents[i & mask],
+					input.other_mantissas[i & mask], input.exponents[i & mask]);
+		}
+		sink_int = total;
+	});
+
+	run("num", samples, ops, [&](int p_ops) {
+		char buffer[BigNumberCore::NUM_BUFFER_SIZE];
+		int64_t total = 0;
+		for (int i = 0; i < p_ops; i++) {
+			total += BigNumberCore::num(input.mantissas[i & mask] * 100.0, -1, buffer);
+		}
+		sink_int = total;
+	});
+
+	run("num_decimals", samples, ops, [&](int p_ops) {
+		char buffer[BigNumberCore::NUM_BUFFER_SIZE];
+		int64_t total = 0;
+		for (int i = 0; i < p_ops; i++) {
+			total += BigNumberCore::num(input.mantissas[i & mask], 4, buffer);
+		}
+		sink_int = total;
+	});
+
+	run("format_aa", samples, ops, [&](int p_ops) {
+		const NumberFormat::Settings settings;
+		char32_t buffer[NumberFormat::STACK_BUFFER_SIZE];
+		int64_t total = 0;
+		for (int i = 0; i < p_ops; i++) {
+			NumberFormat::Writer writer(buffer);
+			NumberFormat::aa(input.mantissas[i & mask], input.exponents[i & mask], false, true, false, settings, writer);
+			total += writer.length;
+		}
+		sink_int = total;
+	});
+
+	run("format_scientific", samples, ops, [&](int p_ops) {
+		const NumberFormat::Settings settings;
+		char32_t buffer[NumberFormat::STACK_BUFFER_SIZE];
+		int64_t total = 0;
+		for (int i = 0; i < p_ops; i++) {
+			NumberFormat::Writer writer(buffer);
+			NumberFormat::scientific(input.mantissas[i & mask], input.exponents[i & mask], false, false, settings, writer);
+			total += writer.length;
+		}
+		sink_int = total;
+	});
+
+	// Batch kernels over the whole input, ns per element
+	std::vector<double> work_mantissas(count);
+	std::vector<int64_t> work_exponents(count);
+	std::vector<int32_t> results(count);
+	const BigNumberBatch::Operand others = BigNumberBatch::Operand::array(input.other_mantissas.data(), input.other_exponents.data());
+
+	run("batch_normalize", samples, ops, [&](int p_ops) {
+		for (int done = 0; done < p_ops; done += (int)count) {
+			int64_t n = std::min<int64_t>((int64_t)count, p_ops - done);
+			std::copy(input.raw.begin(), input.raw.begin() + n, work_mantissas.begin());
+			std::fill(work_exponents.begin(), work_exponents.begin() + n, 0);
+			BigNumberBatch::normalize(work_mantissas.data(), work_exponents.data(), n);
+		}
+		sink_double = work_mantissas[0] + (double)work_exponents[0];
+	});
+
+	run("batch_add", samples, ops, [&](int p_ops) {
+		std::fill(work_mantissas.begin(), work_mantissas.end(), 1.0);
+		std::fill(work_exponents.begin(), work_exponents.end(), 0);
+		for (int done = 0; done < p_ops; done += (int)count) {
+			int64_t n = std::min<int64_t>((int64_t)count, p_ops - done);
+			BigNumberBatch::add(work_mantissas.data(), work_exponents.data(), others, n);
+		}
+		sink_double = work_mantissas[0] + (double)work_exponents[0];
+	});
+
+	run("batch_multiply", samples, ops, [&](int p_ops) {
+		for (int done = 0; done < p_ops; done += (int)count) {
+			int64_t n = std::min<int64_t>((int64_t)count, p_ops - done);
+			std::copy(input.mantissas.begin(), input.mantissas.begin() + n, work_mantissas.begin());
+			std::copy(input.exponents.begin(), input.exponents.begin() + n, work_exponents.begin());
+			BigNumberBatch::multiply(work_mantissas.data(), work_exponents.data(), others, n);
+		}
+		sink_double = work_mantissas[0] + (double)work_exponents[0];
+	});
+
+	run("batch_compare", samples, ops, [&](int p_ops) {
+		for (int done = 0; done < p_ops; done += (int)count) {
+			int64_t n = std::min<int64_t>((int64_t)count, p_ops - done);
+			BigNumberBatch::compare(input.mantissas.data(), input.exponents.data(), others, results.data(), n);
+		}
+		sink_int = results[0];
+	});
+
+	return 0;
+}
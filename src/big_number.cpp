@@ -1,7 +1,22 @@
 #include "big_number.hpp"
+#include "core/big_number_core.hpp"
+#include "core/binary_codec.hpp"
+#include "core/bulk_buy.hpp"
+#include "core/compensated_sum.hpp"
+#include "core/instrumentation.hpp"
+#include "core/number_format.hpp"
+#include "core/sort_key.hpp"
+#include <godot_cpp/classes/os.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/core/math.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
 
 using namespace godot;
 
@@ -9,28 +24,110 @@ const double BigNumber::MANTISSA_MAX = 1209600.0;
 const double BigNumber::MANTISSA_PRECISION = 0.0000001;
 
 namespace {
-const char *METRIC_SYMBOLS[] = {
-	"", "k", "M", "G", "T", "P", "E", "Z", "Y", "R", "Q",
-	"V", "U", "Td", "S", "Ri", "Qx", "Pp", "O", "N", "Mi"
-};
+using NumberFormat::METRIC_NAMES;
+using NumberFormat::METRIC_SYMBOLS;
+using NumberFormat::SHORT_SCALE_NAMES;
+using NumberFormat::SUFFIXES_AA;
+
+// Every fixed suffix the formatters write, sorted for binary search, with
+// the power of 1000 it stands for
+struct SuffixTable {
+	struct Entry {
+		const char *text;
+		int64_t target;
+	};
+
+	Entry entries[NumberFormat::TABLE_SIZE * 3 + NumberFormat::SUFFIXES_AA_SIZE];
+	int count = 0;
+
+	void add(const char *const *p_names, int p_count) {
+		for (int i = 1; i < p_count; i++) {
+			entries[count++] = { p_names[i], i };
+		}
+	}
 
-const char *METRIC_NAMES[] = {
-	"", "kilo", "mega", "giga", "tera", "peta", "exa", "zetta", "yotta", "ronna", "quetta",
-	"vunda", "uda", "treda", "sorta", "rinta", "quexa", "pepta", "ocha", "nena", "ming"
+	SuffixTable() {
+		add(METRIC_SYMBOLS, NumberFormat::TABLE_SIZE);
+		add(METRIC_NAMES, NumberFormat::TABLE_SIZE);
+		add(SHORT_SCALE_NAMES, NumberFormat::TABLE_SIZE);
+		add(SUFFIXES_AA, NumberFormat::SUFFIXES_AA_SIZE);
+		std::sort(entries, entries + count, [](const Entry &p_a, const Entry &p_b) { return strcmp(p_a.text, p_b.text) < 0; });
+	}
 };
 
-const char *SHORT_SCALE_NAMES[] = {
-	"", "thousand", "million", "billion", "trillion", "quadrillion", "quintillion", "sextillion", "septillion", "octillion", "nonillion",
-	"decillion", "undecillion", "duodecillion", "tredecillion", "quattuordecillion", "quindecillion", "sexdecillion", "septendecillion", "octodecillion", "novemdecillion"
-};
+const SuffixTable &get_suffix_table() {
+	static SuffixTable table;
+	return table;
+}
 
-const char *ALPHABET[] = {
-	"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m",
-	"n", "o", "p", "q", "r", "s", "t", "u", "v", "w", "x", "y", "z"
-};
+// Compares code points, like strcmp()
+int compare_suffix(const char32_t *p_text, int64_t p_length, const char *p_entry) {
+	int64_t i = 0;
+	for (; i < p_length && p_entry[i] != 0; i++) {
+		if (p_text[i] != (char32_t)(unsigned char)p_entry[i]) {
+			return p_text[i] < (char32_t)(unsigned char)p_entry[i] ? -1 : 1;
+		}
+	}
+	if (i < p_length) {
+		return 1;
+	}
+	return p_entry[i] == 0 ? 0 : -1;
+}
+
+bool find_suffix(const char32_t *p_text, int64_t p_length, int64_t &r_target) {
+	const SuffixTable &table = get_suffix_table();
+	int low = 0;
+	int high = table.count;
+	while (low < high) {
+		int middle = (low + high) / 2;
+		int cmp = compare_suffix(p_text, p_length, table.entries[middle].text);
+		if (cmp == 0) {
+			r_target = table.entries[middle].target;
+			return true;
+		}
+		if (cmp < 0) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
+	}
+	return false;
+}
+
+// Inverse of the generated suffixes of _format_aa(), bijective base 26
+bool decode_aa_suffix(const char32_t *p_text, int64_t p_length, int64_t &r_target) {
+	if (p_length > 12) {
+		return false;
+	}
+	int64_t offset = 0;
+	for (int64_t i = 0; i < p_length; i++) {
+		if (p_text[i] < 'a' || p_text[i] > 'z') {
+			return false;
+		}
+		offset = offset * 26 + (int64_t)(p_text[i] - 'a') + 1;
+	}
+	r_target = offset - 22;
+	return true;
+}
+
+bool is_space(char32_t p_char) {
+	return p_char == ' ' || p_char == '\t' || p_char == '\n' || p_char == '\r' || p_char == 0xA0;
+}
 
-// ln(10)
-const double LOG_10 = 2.302585092994046;
+// Length of p_separator if the text continues with it at p_position, else 0
+int64_t match_separator(const char32_t *p_text, int64_t p_length, int64_t p_position, const String &p_separator) {
+	int64_t separator_length = p_separator.length();
+	if (separator_length == 0 || p_position + separator_length > p_length) {
+		return 0;
+	}
+	const char32_t *separator = p_separator.ptr();
+	for (int64_t i = 0; i < separator_length; i++) {
+		if (p_text[p_position + i] != separator[i]) {
+			return 0;
+		}
+	}
+	return separator_length;
+}
 
 struct OptionKeys {
 	StringName default_mantissa = "default_mantissa";
@@ -54,27 +151,179 @@ const OptionKeys &get_option_keys() {
 	static OptionKeys k;
 	return k;
 }
+
+std::atomic<int64_t> allocation_count{ 0 };
+
+// Published options. Writers edit a copy of the current snapshot and swap it
+// in under the mutex, a snapshot never changes once published.
+struct OptionsState {
+	std::mutex mutex;
+	std::shared_ptr<const BigNumber::FormatOptions> current = std::make_shared<const BigNumber::FormatOptions>();
+	std::atomic<uint64_t> version{ 0 };
+
+	// Call with the mutex held
+	void publish(BigNumber::FormatOptions &r_options) {
+		r_options.version = current->version + 1;
+		current = std::make_shared<const BigNumber::FormatOptions>(r_options);
+		version.store(r_options.version, std::memory_order_release);
+	}
+};
+
+OptionsState &get_options_state() {
+	static OptionsState state;
+	return state;
+}
+
+// Snapshot last read by this thread, only refreshed when the version moves,
+// so readers normally skip the mutex
+struct LocalOptions {
+	std::shared_ptr<const BigNumber::FormatOptions> snapshot;
+	uint64_t version = 0;
+};
+
+thread_local LocalOptions local_options;
+
+// What str() and to_plain_scientific() write: a "." decimal point, no
+// thousand separators
+const BigNumber::FormatOptions &get_plain_options() {
+	static const BigNumber::FormatOptions plain = [] {
+		BigNumber::FormatOptions options;
+		options.thousand_separator = "";
+		return options;
+	}();
+	return plain;
+}
+
+// The Dictionary get_options() returns on the main thread. Like the options
+// Dictionary before FormatOptions, every call returns the same one and
+// scripts can edit it in place: once it has been handed out, the main
+// thread compares its hash before reading the options and publishes any
+// edited key.
+struct SharedOptions {
+	Dictionary dictionary;
+	// Contents after the last sync, to find the edited keys
+	Dictionary synced;
+	uint32_t hash = 0;
+	uint64_t version = 0;
+	std::atomic<bool> handed_out{ false };
+};
+
+SharedOptions &get_shared_options() {
+	static SharedOptions shared;
+	return shared;
+}
+
+bool is_main_thread() {
+	thread_local int main_thread = -1;
+	if (main_thread < 0) {
+		OS *os = OS::get_singleton();
+		main_thread = os->get_thread_caller_id() == os->get_main_thread_id() ? 1 : 0;
+	}
+	return main_thread == 1;
+}
+
+// Only the main thread reads or writes the shared Dictionary
+bool should_sync_shared_options() {
+	return get_shared_options().handed_out.load(std::memory_order_relaxed) && is_main_thread();
+}
+
+void fill_options(const BigNumber::FormatOptions &p_options, Dictionary &r_options) {
+	const OptionKeys &k = get_option_keys();
+	r_options[k.default_mantissa] = p_options.default_mantissa;
+	r_options[k.default_exponent] = p_options.default_exponent;
+	r_options[k.dynamic_decimals] = p_options.dynamic_decimals;
+	r_options[k.dynamic_numbers] = p_options.dynamic_numbers;
+	r_options[k.small_decimals] = p_options.small_decimals;
+	r_options[k.thousand_decimals] = p_options.thousand_decimals;
+	r_options[k.big_decimals] = p_options.big_decimals;
+	r_options[k.scientific_decimals] = p_options.scientific_decimals;
+	r_options[k.logarithmic_decimals] = p_options.logarithmic_decimals;
+	r_options[k.maximum_trailing_zeroes] = p_options.maximum_trailing_zeroes;
+	r_options[k.thousand_separator] = p_options.thousand_separator;
+	r_options[k.decimal_separator] = p_options.decimal_separator;
+	r_options[k.suffix_separator] = p_options.suffix_separator;
+	r_options[k.reading_separator] = p_options.reading_separator;
+	r_options[k.thousand_name] = p_options.thousand_name;
+}
+
+// Long names this thread generated, see NumberFormat::LongNameMemo
+thread_local NumberFormat::LongNameMemo long_name_memo;
+
+// String::num(), through the core digit generation
+String num_string(double p_value, int p_decimals = -1) {
+	char buffer[BigNumberCore::NUM_BUFFER_SIZE];
+	BigNumberCore::num(p_value, p_decimals, buffer);
+	return String(buffer);
+}
+
+// Output of one NumberFormat call. Writes to the stack unless the options'
+// decimals or separators are long enough to need more.
+struct FormatBuffer {
+	NumberFormat::Settings settings;
+	char32_t stack[NumberFormat::STACK_BUFFER_SIZE];
+	LocalVector<char32_t> heap;
+	NumberFormat::Writer writer;
+
+	static NumberFormat::Separator to_separator(const String &p_separator) {
+		return { p_separator.ptr(), p_separator.length() };
+	}
+
+	explicit FormatBuffer(const BigNumber::FormatOptions &p_options) :
+			writer(nullptr) {
+		settings.dynamic_decimals = p_options.dynamic_decimals;
+		settings.dynamic_numbers = p_options.dynamic_numbers;
+		settings.small_decimals = p_options.small_decimals;
+		settings.thousand_decimals = p_options.thousand_decimals;
+		settings.big_decimals = p_options.big_decimals;
+		settings.scientific_decimals = p_options.scientific_decimals;
+		settings.thousand_separator = to_separator(p_options.thousand_separator);
+		settings.decimal_separator = to_separator(p_options.decimal_separator);
+		settings.suffix_separator = to_separator(p_options.suffix_separator);
+		settings.reading_separator = to_separator(p_options.reading_separator);
+		settings.thousand_name = to_separator(p_options.thousand_name);
+		settings.version = p_options.version;
+
+		// One more for the terminating zero
+		int64_t capacity = NumberFormat::get_max_length(settings) + 1;
+		if (capacity > NumberFormat::STACK_BUFFER_SIZE) {
+			heap.resize(capacity);
+			writer.buffer = heap.ptr();
+		} else {
+			writer.buffer = stack;
+		}
+	}
+
+	String to_string() {
+		return String(writer.finish());
+	}
+};
 }
 
 BigNumber::BigNumber() {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	BIG_NUMBER_COUNT(COUNTER_OBJECTS_CREATED);
 	mantissa = 1.0;
 	exponent = 0;
 }
 
 BigNumber::BigNumber(const String &p_string) {
-	PackedStringArray scientific = p_string.split("e");
-	mantissa = scientific[0].to_float();
-	exponent = scientific.size() > 1 ? scientific[1].to_int() : 0;
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	BIG_NUMBER_COUNT(COUNTER_OBJECTS_CREATED);
+	_parse_string(p_string, mantissa, exponent);
 	normalize();
 }
 
 BigNumber::BigNumber(int64_t p_int) {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	BIG_NUMBER_COUNT(COUNTER_OBJECTS_CREATED);
 	mantissa = (double)p_int;
 	exponent = 0;
 	normalize();
 }
 
 BigNumber::BigNumber(double p_float) {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	BIG_NUMBER_COUNT(COUNTER_OBJECTS_CREATED);
 	_size_check(p_float);
 	mantissa = p_float;
 	exponent = 0;
@@ -82,6 +331,8 @@ BigNumber::BigNumber(double p_float) {
 }
 
 BigNumber::BigNumber(double p_mantissa, int64_t p_exponent) {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	BIG_NUMBER_COUNT(COUNTER_OBJECTS_CREATED);
 	_size_check(p_mantissa);
 	mantissa = p_mantissa;
 	exponent = p_exponent;
@@ -89,6 +340,8 @@ BigNumber::BigNumber(double p_mantissa, int64_t p_exponent) {
 }
 
 BigNumber::BigNumber(const Variant &p_val) {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	BIG_NUMBER_COUNT(COUNTER_OBJECTS_CREATED);
 	if (p_val.get_type() == Variant::OBJECT) {
 		Ref<BigNumber> m = p_val;
 		if (m.is_valid()) {
@@ -99,10 +352,7 @@ BigNumber::BigNumber(const Variant &p_val) {
 			exponent = 0;
 		}
 	} else if (p_val.get_type() == Variant::STRING) {
-		String s = p_val;
-		PackedStringArray scientific = s.split("e");
-		mantissa = scientific[0].to_float();
-		exponent = scientific.size() > 1 ? scientific[1].to_int() : 0;
+		_parse_string(p_val, mantissa, exponent);
 	} else if (p_val.get_type() == Variant::INT || p_val.get_type() == Variant::FLOAT) {
 		mantissa = (double)p_val;
 		exponent = 0;
@@ -138,24 +388,177 @@ int64_t BigNumber::get_exponent() const {
 }
 
 void BigNumber::normalize() {
-	if (mantissa == 0.0) {
-		exponent = 0;
+	BigNumberCore::normalize(mantissa, exponent);
+}
+
+void BigNumber::_parse_string(const String &p_string, double &r_mantissa, int64_t &r_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_PARSE);
+	// Plain and scientific text, as str() and to_plain_scientific() write
+	// it, is read in place, with the same result as the split() below
+	if (_parse_notation(p_string.ptr(), p_string.length(), get_plain_options(), true, r_mantissa, r_exponent)) {
 		return;
 	}
 
-	// Handle signs
-	bool is_negative = mantissa < 0.0;
-	if (is_negative) {
-		mantissa = -mantissa;
+	// Anything else keeps the lenient String conversions
+	PackedStringArray scientific = p_string.split("e");
+	r_mantissa = scientific[0].to_float();
+	r_exponent = scientific.size() > 1 ? scientific[1].to_int() : 0;
+}
+
+bool BigNumber::_parse_notation(const char32_t *p_text, int64_t p_length, double &r_mantissa, int64_t &r_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_PARSE);
+	return _parse_notation(p_text, p_length, get_format_options(), false, r_mantissa, r_exponent);
+}
+
+// p_plain reads like the split() path of _parse_string(): no suffixes, a
+// lowercase "e" only, and the mantissa rounded as String::to_float() reads
+// it, left for the caller to normalize. Text where that rounding cannot be
+// reproduced exactly returns false.
+bool BigNumber::_parse_notation(const char32_t *p_text, int64_t p_length, const FormatOptions &p_options, bool p_plain, double &r_mantissa, int64_t &r_exponent) {
+	int64_t i = 0;
+	while (i < p_length && is_space(p_text[i])) {
+		i++;
+	}
+
+	bool negative = false;
+	if (i < p_length && (p_text[i] == '-' || p_text[i] == '+')) {
+		negative = p_text[i] == '-';
+		i++;
+	}
+
+	// The digits are read as a whole number, the decimal point only moves
+	// the exponent. Normalizing then divides by an exact power of ten, which
+	// rounds once, like reading the decimal directly.
+	uint64_t digits = 0;
+	int significant = 0;
+	int digit_count = 0;
+	int64_t exponent = 0;
+	bool any_digit = false;
+	bool decimal = false;
+	bool dot_is_thousand_separator = p_options.thousand_separator == ".";
+	while (i < p_length) {
+		char32_t c = p_text[i];
+		if (c >= '0' && c <= '9') {
+			any_digit = true;
+			digit_count++;
+			if (digits == 0 && c == '0') {
+				// Leading zero, only moves the point
+				if (decimal) {
+					exponent--;
+				}
+			} else if (significant < 19) {
+				digits = digits * 10 + (uint64_t)(c - '0');
+				significant++;
+				if (decimal) {
+					exponent--;
+				}
+			} else if (!decimal) {
+				// Past the precision of a double anyway
+				exponent++;
+			}
+			i++;
+			continue;
+		}
+
+		if (!decimal) {
+			int64_t separator = match_separator(p_text, p_length, i, p_options.decimal_separator);
+			if (separator == 0 && c == '.' && !dot_is_thousand_separator) {
+				separator = 1;
+			}
+			if (separator > 0) {
+				decimal = true;
+				i += separator;
+				continue;
+			}
+
+			// Thousand separators only between digits, as _format_prefix() writes them
+			separator = match_separator(p_text, p_length, i, p_options.thousand_separator);
+			if (separator > 0 && any_digit && i + separator < p_length && p_text[i + separator] >= '0' && p_text[i + separator] <= '9') {
+				i += separator;
+				continue;
+			}
+		}
+		break;
+	}
+	if (!any_digit) {
+		return false;
+	}
+
+	// String::to_float() rounds the mantissa text once: the digits are
+	// exact below 16 of them, and so is every power of ten up to 10^22
+	double plain_mantissa = 0.0;
+	if (p_plain) {
+		if (digit_count > 15 || exponent < -22 || exponent > 0) {
+			return false;
+		}
+		plain_mantissa = (double)digits / PowerOfTen::get(-exponent);
+		exponent = 0;
+	}
+
+	// Scientific exponent, an "e" without digits is an AA suffix instead
+	if (i < p_length && (p_text[i] == 'e' || (p_text[i] == 'E' && !p_plain))) {
+		int64_t j = i + 1;
+		bool exponent_negative = false;
+		if (j < p_length && (p_text[j] == '-' || p_text[j] == '+')) {
+			exponent_negative = p_text[j] == '-';
+			j++;
+		}
+		if (j < p_length && p_text[j] >= '0' && p_text[j] <= '9') {
+			int64_t value = 0;
+			int length = 0;
+			while (j < p_length && p_text[j] >= '0' && p_text[j] <= '9') {
+				if (++length > 18) {
+					return false;
+				}
+				value = value * 10 + (int64_t)(p_text[j] - '0');
+				j++;
+			}
+			exponent += exponent_negative ? -value : value;
+			i = j;
+		}
+	}
+
+	while (i < p_length && is_space(p_text[i])) {
+		i++;
+	}
+	i += match_separator(p_text, p_length, i, p_options.suffix_separator);
+	while (i < p_length && is_space(p_text[i])) {
+		i++;
+	}
+
+	int64_t suffix_start = i;
+	while (i < p_length && !is_space(p_text[i])) {
+		i++;
+	}
+	int64_t suffix_length = i - suffix_start;
+	while (i < p_length && is_space(p_text[i])) {
+		i++;
+	}
+	if (i != p_length) {
+		return false;
 	}
 
-	if (mantissa >= 10.0 || mantissa < 1.0) {
-		double log_val = Math::log(mantissa) / LOG_10;
-		int64_t exp_change = (int64_t)Math::floor(log_val);
+	int64_t target = 0;
+	if (suffix_length > 0 && (p_plain || (!find_suffix(p_text + suffix_start, suffix_length, target) && !decode_aa_suffix(p_text + suffix_start, suffix_length, target)))) {
+		return false;
+	}
 
-		exponent += exp_change;
-		mantissa /= Math::pow(10.0, (double)exp_change);
+	if (p_plain) {
+		r_mantissa = negative ? -plain_mantissa : plain_mantissa;
+		r_exponent = exponent;
+		return true;
 	}
+
+	r_mantissa = negative ? -(double)digits : (double)digits;
+	r_exponent = exponent + target * 3;
+	BigNumberCore::normalize(r_mantissa, r_exponent);
+	return true;
+}
+
+Ref<BigNumber> BigNumber::parse(const String &p_text) {
+	Ref<BigNumber> res = memnew(BigNumber);
+	ERR_FAIL_COND_V_MSG(!_parse_notation(p_text.ptr(), p_text.length(), res->mantissa, res->exponent), Ref<BigNumber>(), "BigNumber Error: Cannot parse \"" + p_text + "\".");
+	return res;
 }
 
 void BigNumber::_get_values(const Variant &n, double &r_mantissa, int64_t &r_exponent) {
@@ -168,50 +571,42 @@ void BigNumber::_get_values(const Variant &n, double &r_mantissa, int64_t &r_exp
 	} else if (n.get_type() == Variant::OBJECT) {
 		Ref<BigNumber> b = n;
 		if (b.is_valid()) {
-			r_mantissa = b->get_mantissa();
-			r_exponent = b->get_exponent();
+			r_mantissa = b->mantissa;
+			r_exponent = b->exponent;
 			return;
 		}
-		// Invalid object, fall through to fallback
+		// Invalid object, same default as the Variant constructor
+		r_mantissa = 1.0;
+		r_exponent = 0;
+	} else if (n.get_type() == Variant::STRING) {
+		// Parsed in place, same rules as the String constructor
+		_parse_string(n, r_mantissa, r_exponent);
+		_size_check(r_mantissa);
 	} else {
-		// Fallback/String/Other
-		Ref<BigNumber> temp = memnew(BigNumber(n));
-		r_mantissa = temp->get_mantissa();
-		r_exponent = temp->get_exponent();
-		return;
-	}
-
-	// Normalize r_mantissa/r_exponent for INT/FLOAT types
-	if (r_mantissa == 0.0) {
+		r_mantissa = 1.0;
 		r_exponent = 0;
-		return;
-	}
-	if (r_mantissa < 0.0) {
-		r_mantissa = -r_mantissa;
 	}
 
-	if (r_mantissa >= 10.0 || r_mantissa < 1.0) {
-		double log_val = Math::log(r_mantissa) / LOG_10;
-		int64_t exp_change = (int64_t)Math::floor(log_val);
+	// Normalize r_mantissa/r_exponent for INT/FLOAT/String types
+	BigNumberCore::normalize(r_mantissa, r_exponent);
+}
 
-		r_exponent += exp_change;
-		r_mantissa /= Math::pow(10.0, (double)exp_change);
-	}
+bool BigNumber::_get_big_values(const Ref<BigNumber> &n, double &r_mantissa, int64_t &r_exponent) {
+	ERR_FAIL_COND_V_MSG(n.is_null(), false, "BigNumber Error: Argument is null.");
+	r_mantissa = n->mantissa;
+	r_exponent = n->exponent;
+	return true;
 }
 
-Ref<BigNumber> BigNumber::_type_check(const Variant &n) {
-	if (n.get_type() == Variant::OBJECT) {
-		Ref<BigNumber> b = n;
-		if (b.is_valid()) {
-			return b;
-		}
-	}
-	return memnew(BigNumber(n));
+void BigNumber::_get_number_values(double n, double &r_mantissa, int64_t &r_exponent) {
+	r_mantissa = n;
+	r_exponent = 0;
+	BigNumberCore::normalize(r_mantissa, r_exponent);
 }
 
 void BigNumber::_size_check(double p_mantissa) {
 	if (p_mantissa > MANTISSA_MAX) {
-		ERR_PRINT("BigNumber Error: Mantissa \"" + String::num(p_mantissa) + "\" exceeds MANTISSA_MAX.");
+		ERR_PRINT("BigNumber Error: Mantissa \"" + num_string(p_mantissa) + "\" exceeds MANTISSA_MAX.");
 	}
 }
 
@@ -219,31 +614,14 @@ bool BigNumber::is_less_than(const Variant &n) const {
 	double other_mantissa;
 	int64_t other_exponent;
 	_get_values(n, other_mantissa, other_exponent);
-	
-	if (mantissa == 0.0) {
-		return other_mantissa > 0.0; // 0 < 0 is false
-	}
-	
-	if (exponent < other_exponent) {
-		if (exponent == other_exponent - 1 && mantissa > 10.0 * other_mantissa) {
-			return false;
-		}
-		return true;
-	} else if (exponent == other_exponent) {
-		return mantissa < other_mantissa;
-	} else {
-		if (exponent == other_exponent + 1 && mantissa * 10.0 < other_mantissa) {
-			return true;
-		}
-		return false;
-	}
+	return BigNumberCore::is_less_than(mantissa, exponent, other_mantissa, other_exponent);
 }
 
 bool BigNumber::is_equal_to(const Variant &n) const {
 	double other_mantissa;
 	int64_t other_exponent;
 	_get_values(n, other_mantissa, other_exponent);
-	return other_exponent == exponent && Math::is_equal_approx(other_mantissa, mantissa);
+	return BigNumberCore::is_equal(mantissa, exponent, other_mantissa, other_exponent);
 }
 
 bool BigNumber::is_greater_than(const Variant &n) const {
@@ -251,20 +629,124 @@ bool BigNumber::is_greater_than(const Variant &n) const {
 }
 
 bool BigNumber::is_less_than_or_equal_to(const Variant &n) const {
-	Ref<BigNumber> other = _type_check(n);
-	if (is_less_than(other)) {
-		return true;
-	}
-	if (other->exponent == exponent && Math::is_equal_approx(other->mantissa, mantissa)) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_values(n, other_mantissa, other_exponent);
+	if (BigNumberCore::is_less_than(mantissa, exponent, other_mantissa, other_exponent)) {
 		return true;
 	}
-	return false;
+	return BigNumberCore::is_equal(mantissa, exponent, other_mantissa, other_exponent);
 }
 
 bool BigNumber::is_greater_than_or_equal_to(const Variant &n) const {
 	return !is_less_than(n);
 }
 
+bool BigNumber::is_less_than_big(const Ref<BigNumber> &n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	if (!_get_big_values(n, other_mantissa, other_exponent)) {
+		return false;
+	}
+	return BigNumberCore::is_less_than(mantissa, exponent, other_mantissa, other_exponent);
+}
+
+bool BigNumber::is_less_than_int(int64_t n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values((double)n, other_mantissa, other_exponent);
+	return BigNumberCore::is_less_than(mantissa, exponent, other_mantissa, other_exponent);
+}
+
+bool BigNumber::is_less_than_float(double n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values(n, other_mantissa, other_exponent);
+	return BigNumberCore::is_less_than(mantissa, exponent, other_mantissa, other_exponent);
+}
+
+bool BigNumber::is_equal_to_big(const Ref<BigNumber> &n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	if (!_get_big_values(n, other_mantissa, other_exponent)) {
+		return false;
+	}
+	return BigNumberCore::is_equal(mantissa, exponent, other_mantissa, other_exponent);
+}
+
+bool BigNumber::is_equal_to_int(int64_t n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values((double)n, other_mantissa, other_exponent);
+	return BigNumberCore::is_equal(mantissa, exponent, other_mantissa, other_exponent);
+}
+
+bool BigNumber::is_equal_to_float(double n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values(n, other_mantissa, other_exponent);
+	return BigNumberCore::is_equal(mantissa, exponent, other_mantissa, other_exponent);
+}
+
+bool BigNumber::is_greater_than_big(const Ref<BigNumber> &n) const {
+	// Null is false here too, not the negation of it
+	ERR_FAIL_COND_V_MSG(n.is_null(), false, "BigNumber Error: Argument is null.");
+	return !is_less_than_or_equal_to_big(n);
+}
+
+bool BigNumber::is_greater_than_int(int64_t n) const {
+	return !is_less_than_or_equal_to_int(n);
+}
+
+bool BigNumber::is_greater_than_float(double n) const {
+	return !is_less_than_or_equal_to_float(n);
+}
+
+bool BigNumber::is_less_than_or_equal_to_big(const Ref<BigNumber> &n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	if (!_get_big_values(n, other_mantissa, other_exponent)) {
+		return false;
+	}
+	if (BigNumberCore::is_less_than(mantissa, exponent, other_mantissa, other_exponent)) {
+		return true;
+	}
+	return BigNumberCore::is_equal(mantissa, exponent, other_mantissa, other_exponent);
+}
+
+bool BigNumber::is_less_than_or_equal_to_int(int64_t n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values((double)n, other_mantissa, other_exponent);
+	if (BigNumberCore::is_less_than(mantissa, exponent, other_mantissa, other_exponent)) {
+		return true;
+	}
+	return BigNumberCore::is_equal(mantissa, exponent, other_mantissa, other_exponent);
+}
+
+bool BigNumber::is_less_than_or_equal_to_float(double n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values(n, other_mantissa, other_exponent);
+	if (BigNumberCore::is_less_than(mantissa, exponent, other_mantissa, other_exponent)) {
+		return true;
+	}
+	return BigNumberCore::is_equal(mantissa, exponent, other_mantissa, other_exponent);
+}
+
+bool BigNumber::is_greater_than_or_equal_to_big(const Ref<BigNumber> &n) const {
+	ERR_FAIL_COND_V_MSG(n.is_null(), false, "BigNumber Error: Argument is null.");
+	return !is_less_than_big(n);
+}
+
+bool BigNumber::is_greater_than_or_equal_to_int(int64_t n) const {
+	return !is_less_than_int(n);
+}
+
+bool BigNumber::is_greater_than_or_equal_to_float(double n) const {
+	return !is_less_than_float(n);
+}
+
 Ref<BigNumber> BigNumber::plus(const Variant &n) const {
 	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
 	res->plus_equals(n);
@@ -275,29 +757,7 @@ Ref<BigNumber> BigNumber::plus_equals(const Variant &n) {
 	double other_mantissa;
 	int64_t other_exponent;
 	_get_values(n, other_mantissa, other_exponent);
-	
-	int64_t exp_diff = other_exponent - exponent;
-	
-	if (exp_diff == 0) {
-		mantissa += other_mantissa;
-	} else if (exp_diff > 0) {
-		if (exp_diff >= 248) {
-			mantissa = other_mantissa;
-			exponent = other_exponent;
-		} else {
-			double scaled_mantissa = other_mantissa * Math::pow(10.0, (double)exp_diff);
-			mantissa += scaled_mantissa;
-		}
-	} else {
-		if (-exp_diff >= 248) {
-			// Other too small
-		} else {
-			double scaled_mantissa = other_mantissa / Math::pow(10.0, (double)(-exp_diff));
-			mantissa += scaled_mantissa;
-		}
-	}
-	
-	normalize();
+	BigNumberCore::add(mantissa, exponent, other_mantissa, other_exponent);
 	return Ref<BigNumber>(this);
 }
 
@@ -311,29 +771,7 @@ Ref<BigNumber> BigNumber::minus_equals(const Variant &n) {
 	double other_mantissa;
 	int64_t other_exponent;
 	_get_values(n, other_mantissa, other_exponent);
-	
-	double other_mantissa_neg = -other_mantissa;
-	
-	int64_t exp_diff = other_exponent - exponent;
-	
-	if (exp_diff == 0) {
-		mantissa += other_mantissa_neg;
-	} else if (exp_diff > 0) {
-		if (exp_diff >= 248) {
-			mantissa = other_mantissa_neg;
-			exponent = other_exponent;
-		} else {
-			double scaled_mantissa = other_mantissa_neg * Math::pow(10.0, (double)exp_diff);
-			mantissa += scaled_mantissa;
-		}
-	} else {
-		if (-exp_diff < 248) {
-			double scaled_mantissa = other_mantissa_neg / Math::pow(10.0, (double)(-exp_diff));
-			mantissa += scaled_mantissa;
-		}
-	}
-	
-	normalize();
+	BigNumberCore::add(mantissa, exponent, -other_mantissa, other_exponent);
 	return Ref<BigNumber>(this);
 }
 
@@ -347,11 +785,7 @@ Ref<BigNumber> BigNumber::multiply_equals(const Variant &n) {
 	double other_mantissa;
 	int64_t other_exponent;
 	_get_values(n, other_mantissa, other_exponent);
-	
-	exponent += other_exponent;
-	mantissa *= other_mantissa;
-	
-	normalize();
+	BigNumberCore::multiply(mantissa, exponent, other_mantissa, other_exponent);
 	return Ref<BigNumber>(this);
 }
 
@@ -365,148 +799,621 @@ Ref<BigNumber> BigNumber::divide_equals(const Variant &n) {
 	double other_mantissa;
 	int64_t other_exponent;
 	_get_values(n, other_mantissa, other_exponent);
-	
-	if (other_mantissa == 0.0) {
+
+	if (!BigNumberCore::divide(mantissa, exponent, other_mantissa, other_exponent)) {
 		ERR_PRINT("BigNumber Error: Divide by zero");
-		return Ref<BigNumber>(this);
 	}
-	
-	exponent -= other_exponent;
-	mantissa /= other_mantissa;
-	
-	normalize();
 	return Ref<BigNumber>(this);
 }
 
-Ref<BigNumber> BigNumber::mod(const Variant &n) const {
-	Ref<BigNumber> other = _type_check(n);
-	
-	Ref<BigNumber> quot = divide(other);
-	quot->floor_value();
-	
-	Ref<BigNumber> product = quot->multiply(other);
-	Ref<BigNumber> res = minus(product);
+Ref<BigNumber> BigNumber::plus_big(const Ref<BigNumber> &n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->plus_equals_big(n);
 	return res;
 }
 
-Ref<BigNumber> BigNumber::power(const Variant &n) const {
+Ref<BigNumber> BigNumber::plus_int(int64_t n) const {
 	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
-	res->power_equals(n);
+	res->plus_equals_int(n);
 	return res;
 }
 
-Ref<BigNumber> BigNumber::power_equals(const Variant &n) {
-	if (n.get_type() == Variant::INT) {
-		int64_t p = (int64_t)n;
-		if (p == 0) {
-			mantissa = 1.0;
-			exponent = 0;
-			return Ref<BigNumber>(this);
-		}
-		// Handling negative int power? Original GDScript says "not fully supported in simple power", 
-		// but simple logic: x^-p = 1 / x^p.
-		// For now using GDScript logic:
-		/*
-			var new_exponent: int = exponent * p
-			var new_mantissa: float = mantissa ** float(p)
-			
-			mantissa = new_mantissa
-			exponent = new_exponent
-			normalize()
-		*/
-		int64_t new_exponent = exponent * p;
-		double new_mantissa = Math::pow(mantissa, (double)p);
-		
-		mantissa = new_mantissa;
-		exponent = new_exponent;
-		normalize();
-		return Ref<BigNumber>(this);
+Ref<BigNumber> BigNumber::plus_float(double n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->plus_equals_float(n);
+	return res;
+}
 
-	} else if (n.get_type() == Variant::FLOAT) {
-		double p = (double)n;
-		if (mantissa == 0.0) return Ref<BigNumber>(this);
-		
-		double log_val = log10();
-		double new_log = log_val * p;
-		
-		int64_t new_exponent = (int64_t)Math::floor(new_log);
-		double remainder = new_log - (double)new_exponent;
-		double new_mantissa = Math::pow(10.0, remainder);
-		
-		exponent = new_exponent;
-		mantissa = new_mantissa;
-		normalize();
+Ref<BigNumber> BigNumber::plus_equals_big(const Ref<BigNumber> &n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	if (!_get_big_values(n, other_mantissa, other_exponent)) {
 		return Ref<BigNumber>(this);
-
-	} else if (n.get_type() == Variant::OBJECT) {
-		Ref<BigNumber> other = n;
-		if (other.is_valid()) {
-			return power_equals(other->to_float());
-		}
 	}
-	// Fallback?
+	BigNumberCore::add(mantissa, exponent, other_mantissa, other_exponent);
 	return Ref<BigNumber>(this);
 }
 
-Ref<BigNumber> BigNumber::square_root() const {
+Ref<BigNumber> BigNumber::plus_equals_int(int64_t n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values((double)n, other_mantissa, other_exponent);
+	BigNumberCore::add(mantissa, exponent, other_mantissa, other_exponent);
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::plus_equals_float(double n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values(n, other_mantissa, other_exponent);
+	BigNumberCore::add(mantissa, exponent, other_mantissa, other_exponent);
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::minus_big(const Ref<BigNumber> &n) const {
 	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
-	
-	if (res->exponent % 2 == 0) {
-		res->mantissa = Math::sqrt(res->mantissa);
-		res->exponent = res->exponent / 2;
-	} else {
-		res->mantissa = Math::sqrt(res->mantissa * 10.0);
-		res->exponent = (res->exponent - 1) / 2;
-	}
-	
-	res->normalize();
+	res->minus_equals_big(n);
 	return res;
 }
 
-Ref<BigNumber> BigNumber::absolute() const {
+Ref<BigNumber> BigNumber::minus_int(int64_t n) const {
 	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
-	res->mantissa = Math::abs(res->mantissa);
+	res->minus_equals_int(n);
 	return res;
 }
 
-double BigNumber::log10() const {
-	return (double)exponent + (Math::log(mantissa) / LOG_10);
+Ref<BigNumber> BigNumber::minus_float(double n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->minus_equals_float(n);
+	return res;
 }
 
-double BigNumber::ln() const {
-	return log10() * LOG_10;
+Ref<BigNumber> BigNumber::minus_equals_big(const Ref<BigNumber> &n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	if (!_get_big_values(n, other_mantissa, other_exponent)) {
+		return Ref<BigNumber>(this);
+	}
+	BigNumberCore::add(mantissa, exponent, -other_mantissa, other_exponent);
+	return Ref<BigNumber>(this);
 }
 
-void BigNumber::floor_value() {
-	if (exponent == 0) {
-		mantissa = Math::floor(mantissa);
-	} else if (exponent < 0) {
-		mantissa = 0.0;
-		exponent = 0;
-	} else {
-		// If exponent is positive but small enough to have fractional parts visible in double precision
-		if (exponent < 16) {
-			double val = to_float();
-			val = Math::floor(val);
-			// Re-assigning from float will re-normalize
-			mantissa = val;
-			exponent = 0;
-			normalize();
+Ref<BigNumber> BigNumber::minus_equals_int(int64_t n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values((double)n, other_mantissa, other_exponent);
+	BigNumberCore::add(mantissa, exponent, -other_mantissa, other_exponent);
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::minus_equals_float(double n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values(n, other_mantissa, other_exponent);
+	BigNumberCore::add(mantissa, exponent, -other_mantissa, other_exponent);
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::multiply_big(const Ref<BigNumber> &n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->multiply_equals_big(n);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::multiply_int(int64_t n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->multiply_equals_int(n);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::multiply_float(double n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->multiply_equals_float(n);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::multiply_equals_big(const Ref<BigNumber> &n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	if (!_get_big_values(n, other_mantissa, other_exponent)) {
+		return Ref<BigNumber>(this);
+	}
+	BigNumberCore::multiply(mantissa, exponent, other_mantissa, other_exponent);
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::multiply_equals_int(int64_t n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values((double)n, other_mantissa, other_exponent);
+	BigNumberCore::multiply(mantissa, exponent, other_mantissa, other_exponent);
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::multiply_equals_float(double n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values(n, other_mantissa, other_exponent);
+	BigNumberCore::multiply(mantissa, exponent, other_mantissa, other_exponent);
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::divide_big(const Ref<BigNumber> &n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->divide_equals_big(n);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::divide_int(int64_t n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->divide_equals_int(n);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::divide_float(double n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->divide_equals_float(n);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::divide_equals_big(const Ref<BigNumber> &n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	if (!_get_big_values(n, other_mantissa, other_exponent)) {
+		return Ref<BigNumber>(this);
+	}
+
+	if (!BigNumberCore::divide(mantissa, exponent, other_mantissa, other_exponent)) {
+		ERR_PRINT("BigNumber Error: Divide by zero");
+	}
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::divide_equals_int(int64_t n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values((double)n, other_mantissa, other_exponent);
+
+	if (!BigNumberCore::divide(mantissa, exponent, other_mantissa, other_exponent)) {
+		ERR_PRINT("BigNumber Error: Divide by zero");
+	}
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::divide_equals_float(double n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_number_values(n, other_mantissa, other_exponent);
+
+	if (!BigNumberCore::divide(mantissa, exponent, other_mantissa, other_exponent)) {
+		ERR_PRINT("BigNumber Error: Divide by zero");
+	}
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::mod(const Variant &n) const {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_values(n, other_mantissa, other_exponent);
+
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	if (!BigNumberCore::mod(res->mantissa, res->exponent, other_mantissa, other_exponent)) {
+		ERR_PRINT("BigNumber Error: Divide by zero");
+	}
+	return res;
+}
+
+Ref<BigNumber> BigNumber::power(const Variant &n) const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->power_equals(n);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::power_equals(const Variant &n) {
+	_power_values(n, mantissa, exponent);
+	return Ref<BigNumber>(this);
+}
+
+void BigNumber::_power_values(const Variant &n, double &r_mantissa, int64_t &r_exponent) {
+	if (n.get_type() == Variant::INT) {
+		BigNumberCore::power_int(r_mantissa, r_exponent, (int64_t)n);
+	} else if (n.get_type() == Variant::FLOAT) {
+		BigNumberCore::power_float(r_mantissa, r_exponent, (double)n);
+	} else if (n.get_type() == Variant::OBJECT) {
+		Ref<BigNumber> other = n;
+		if (other.is_valid()) {
+			BigNumberCore::power_float(r_mantissa, r_exponent, other->to_float());
 		}
-		// Else: assume integer
 	}
+	// Fallback?
+}
+
+Ref<BigNumber> BigNumber::square_root() const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	BigNumberCore::square_root(res->mantissa, res->exponent);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::absolute() const {
+	Ref<BigNumber> res = memnew(BigNumber(mantissa, exponent));
+	res->mantissa = Math::abs(res->mantissa);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::fma_equals(const Variant &a, const Variant &b) {
+	double m, other_m;
+	int64_t e, other_e;
+	_get_values(a, m, e);
+	_get_values(b, other_m, other_e);
+	BigNumberCore::fma(mantissa, exponent, m, e, other_m, other_e);
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::scale_add_equals(const Variant &n, double p_scale) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_values(n, other_mantissa, other_exponent);
+	// fma() normalizes the scale, so any float works here
+	BigNumberCore::fma(mantissa, exponent, other_mantissa, other_exponent, p_scale, 0);
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::min_equals(const Variant &n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_values(n, other_mantissa, other_exponent);
+	if (BigNumberCore::is_less_than(other_mantissa, other_exponent, mantissa, exponent)) {
+		mantissa = other_mantissa;
+		exponent = other_exponent;
+	}
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::max_equals(const Variant &n) {
+	double other_mantissa;
+	int64_t other_exponent;
+	_get_values(n, other_mantissa, other_exponent);
+	if (BigNumberCore::is_less_than(mantissa, exponent, other_mantissa, other_exponent)) {
+		mantissa = other_mantissa;
+		exponent = other_exponent;
+	}
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::clamp_equals(const Variant &p_min, const Variant &p_max) {
+	double min_mantissa, max_mantissa;
+	int64_t min_exponent, max_exponent;
+	_get_values(p_min, min_mantissa, min_exponent);
+	_get_values(p_max, max_mantissa, max_exponent);
+
+	// Same order as clamp(), the minimum wins when the bounds cross
+	if (BigNumberCore::is_less_than(mantissa, exponent, min_mantissa, min_exponent)) {
+		mantissa = min_mantissa;
+		exponent = min_exponent;
+	} else if (BigNumberCore::is_less_than(max_mantissa, max_exponent, mantissa, exponent)) {
+		mantissa = max_mantissa;
+		exponent = max_exponent;
+	}
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::lerp_equals(const Variant &p_to, double p_weight, bool p_logarithmic) {
+	double to_mantissa;
+	int64_t to_exponent;
+	_get_values(p_to, to_mantissa, to_exponent);
+	if (p_logarithmic) {
+		BigNumberCore::lerp_log(mantissa, exponent, to_mantissa, to_exponent, p_weight);
+	} else {
+		BigNumberCore::lerp(mantissa, exponent, to_mantissa, to_exponent, p_weight);
+	}
+	return Ref<BigNumber>(this);
+}
+
+Ref<BigNumber> BigNumber::mul_add(const Variant &a, const Variant &b, const Variant &c) {
+	Ref<BigNumber> res = memnew(BigNumber);
+	return mul_add_into(res, a, b, c);
+}
+
+Ref<BigNumber> BigNumber::sum_of(const Array &p_values) {
+	CompensatedSum::Accumulator sum;
+	int64_t count = p_values.size();
+	for (int64_t i = 0; i < count; i++) {
+		double m;
+		int64_t e;
+		_get_values(p_values[i], m, e);
+		sum.add(m, e);
+	}
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	sum.get_total(res->mantissa, res->exponent);
+	BigNumberCore::normalize(res->mantissa, res->exponent);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::add_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b) {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumber Error: Output is null.");
+
+	double m, other_m;
+	int64_t e, other_e;
+	_get_values(a, m, e);
+	_get_values(b, other_m, other_e);
+	BigNumberCore::add(m, e, other_m, other_e);
+
+	r_out->mantissa = m;
+	r_out->exponent = e;
+	return r_out;
+}
+
+Ref<BigNumber> BigNumber::subtract_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b) {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumber Error: Output is null.");
+
+	double m, other_m;
+	int64_t e, other_e;
+	_get_values(a, m, e);
+	_get_values(b, other_m, other_e);
+	BigNumberCore::add(m, e, -other_m, other_e);
+
+	r_out->mantissa = m;
+	r_out->exponent = e;
+	return r_out;
+}
+
+Ref<BigNumber> BigNumber::multiply_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b) {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumber Error: Output is null.");
+
+	double m, other_m;
+	int64_t e, other_e;
+	_get_values(a, m, e);
+	_get_values(b, other_m, other_e);
+	BigNumberCore::multiply(m, e, other_m, other_e);
+
+	r_out->mantissa = m;
+	r_out->exponent = e;
+	return r_out;
+}
+
+Ref<BigNumber> BigNumber::divide_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b) {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumber Error: Output is null.");
+
+	double m, other_m;
+	int64_t e, other_e;
+	_get_values(a, m, e);
+	_get_values(b, other_m, other_e);
+	if (!BigNumberCore::divide(m, e, other_m, other_e)) {
+		ERR_PRINT("BigNumber Error: Divide by zero");
+	}
+
+	r_out->mantissa = m;
+	r_out->exponent = e;
+	return r_out;
+}
+
+Ref<BigNumber> BigNumber::mod_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b) {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumber Error: Output is null.");
+
+	double m, other_m;
+	int64_t e, other_e;
+	_get_values(a, m, e);
+	_get_values(b, other_m, other_e);
+	if (!BigNumberCore::mod(m, e, other_m, other_e)) {
+		ERR_PRINT("BigNumber Error: Divide by zero");
+	}
+
+	r_out->mantissa = m;
+	r_out->exponent = e;
+	return r_out;
+}
+
+Ref<BigNumber> BigNumber::pow_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b) {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumber Error: Output is null.");
+
+	double m;
+	int64_t e;
+	_get_values(a, m, e);
+	_power_values(b, m, e);
+
+	r_out->mantissa = m;
+	r_out->exponent = e;
+	return r_out;
+}
+
+Ref<BigNumber> BigNumber::sqrt_into(const Ref<BigNumber> &r_out, const Variant &a) {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumber Error: Output is null.");
+
+	double m;
+	int64_t e;
+	_get_values(a, m, e);
+	BigNumberCore::square_root(m, e);
+
+	r_out->mantissa = m;
+	r_out->exponent = e;
+	return r_out;
+}
+
+Ref<BigNumber> BigNumber::abs_into(const Ref<BigNumber> &r_out, const Variant &a) {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumber Error: Output is null.");
+
+	double m;
+	int64_t e;
+	_get_values(a, m, e);
+
+	r_out->mantissa = Math::abs(m);
+	r_out->exponent = e;
+	return r_out;
+}
+
+Ref<BigNumber> BigNumber::mul_add_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b, const Variant &c) {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumber Error: Output is null.");
+
+	double m, other_m, addend_m;
+	int64_t e, other_e, addend_e;
+	_get_values(a, m, e);
+	_get_values(b, other_m, other_e);
+	_get_values(c, addend_m, addend_e);
+	BigNumberCore::fma(addend_m, addend_e, m, e, other_m, other_e);
+
+	r_out->mantissa = addend_m;
+	r_out->exponent = addend_e;
+	return r_out;
+}
+
+Ref<BigNumber> BigNumber::cost_of_n(const Variant &p_base, double p_growth, int64_t p_owned, int64_t p_count) {
+	ERR_FAIL_COND_V_MSG(!(p_growth > 0.0), Ref<BigNumber>(), "BigNumber Error: Growth must be positive.");
+	ERR_FAIL_COND_V_MSG(p_owned < 0 || p_count < 0, Ref<BigNumber>(), "BigNumber Error: Level counts cannot be negative.");
+
+	double base_m;
+	int64_t base_e;
+	_get_values(p_base, base_m, base_e);
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	BulkBuy::geometric_cost(base_m, base_e, p_growth, p_owned, p_count, res->mantissa, res->exponent);
+	return res;
+}
+
+int64_t BigNumber::max_affordable(const Variant &p_base, double p_growth, int64_t p_owned, const Variant &p_budget) {
+	ERR_FAIL_COND_V_MSG(!(p_growth > 0.0), 0, "BigNumber Error: Growth must be positive.");
+	ERR_FAIL_COND_V_MSG(p_owned < 0, 0, "BigNumber Error: Level counts cannot be negative.");
+
+	double base_m, budget_m;
+	int64_t base_e, budget_e;
+	_get_values(p_base, base_m, base_e);
+	_get_values(p_budget, budget_m, budget_e);
+	return BulkBuy::geometric_max(base_m, base_e, p_growth, p_owned, budget_m, budget_e);
+}
+
+Ref<BigNumber> BigNumber::cost_of_n_linear(const Variant &p_base, const Variant &p_increment, int64_t p_owned, int64_t p_count) {
+	ERR_FAIL_COND_V_MSG(p_owned < 0 || p_count < 0, Ref<BigNumber>(), "BigNumber Error: Level counts cannot be negative.");
+
+	double base_m, increment_m;
+	int64_t base_e, increment_e;
+	_get_values(p_base, base_m, base_e);
+	_get_values(p_increment, increment_m, increment_e);
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	BulkBuy::linear_cost(base_m, base_e, increment_m, increment_e, p_owned, p_count, res->mantissa, res->exponent);
+	return res;
+}
+
+int64_t BigNumber::max_affordable_linear(const Variant &p_base, const Variant &p_increment, int64_t p_owned, const Variant &p_budget) {
+	ERR_FAIL_COND_V_MSG(p_owned < 0, 0, "BigNumber Error: Level counts cannot be negative.");
+
+	double base_m, increment_m, budget_m;
+	int64_t base_e, increment_e, budget_e;
+	_get_values(p_base, base_m, base_e);
+	_get_values(p_increment, increment_m, increment_e);
+	_get_values(p_budget, budget_m, budget_e);
+	return BulkBuy::linear_max(base_m, base_e, increment_m, increment_e, p_owned, budget_m, budget_e);
+}
+
+int64_t BigNumber::get_allocation_count() {
+	return allocation_count.load(std::memory_order_relaxed);
+}
+
+void BigNumber::reset_allocation_count() {
+	allocation_count.store(0, std::memory_order_relaxed);
+}
+
+double BigNumber::log10() const {
+	return BigNumberCore::log10(mantissa, exponent);
+}
+
+double BigNumber::ln() const {
+	return log10() * BigNumberCore::LOG_10;
+}
+
+void BigNumber::floor_value() {
+	BigNumberCore::floor(mantissa, exponent);
 }
 
 double BigNumber::to_float() const {
-	return mantissa * Math::pow(10.0, (double)exponent);
+	return BigNumberCore::to_float(mantissa, exponent);
 }
 
 String BigNumber::to_plain_scientific() const {
-	return String::num(mantissa) + "e" + String::num_int64(exponent);
+	return num_string(mantissa) + "e" + String::num_int64(exponent);
+}
+
+PackedByteArray BigNumber::to_bytes() const {
+	uint8_t buffer[BigNumberCodec::HEADER_SIZE + BigNumberCodec::MAX_VALUE_SIZE];
+	int length = BigNumberCodec::write_header(buffer, BigNumberCodec::KIND_VALUE);
+	length += BigNumberCodec::write_value(buffer + length, mantissa, exponent);
+
+	PackedByteArray res;
+	res.resize(length);
+	memcpy(res.ptrw(), buffer, length);
+	return res;
+}
+
+Ref<BigNumber> BigNumber::from_bytes(const PackedByteArray &p_bytes) {
+	const uint8_t *data = p_bytes.ptr();
+	int64_t size = p_bytes.size();
+	BigNumberCodec::HeaderError header = BigNumberCodec::read_header(data, size, BigNumberCodec::KIND_VALUE);
+	ERR_FAIL_COND_V_MSG(header != BigNumberCodec::HEADER_OK, Ref<BigNumber>(), String("BigNumber Error: ") + BigNumberCodec::get_header_error_text(header));
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	int length = BigNumberCodec::read_value(data + BigNumberCodec::HEADER_SIZE, size - BigNumberCodec::HEADER_SIZE, res->mantissa, res->exponent);
+	ERR_FAIL_COND_V_MSG(length == 0, Ref<BigNumber>(), "BigNumber Error: Byte data is truncated.");
+	ERR_FAIL_COND_V_MSG(BigNumberCodec::HEADER_SIZE + length != size, Ref<BigNumber>(), "BigNumber Error: Byte data continues past the encoded value.");
+	return res;
+}
+
+int64_t BigNumber::to_sort_key() const {
+	return SortKey::encode(mantissa, exponent);
+}
+
+Ref<BigNumber> BigNumber::from_sort_key(int64_t p_key) {
+	Ref<BigNumber> res = memnew(BigNumber);
+	SortKey::decode(p_key, res->mantissa, res->exponent);
+	return res;
+}
+
+PackedByteArray BigNumber::encode_array(const Array &p_values) {
+	int64_t count = p_values.size();
+	PackedByteArray res;
+	res.resize(BigNumberCodec::HEADER_SIZE + BigNumberCodec::MAX_VARINT_SIZE + count * BigNumberCodec::MAX_VALUE_SIZE);
+
+	uint8_t *data = res.ptrw();
+	int64_t length = BigNumberCodec::write_header(data, BigNumberCodec::KIND_ARRAY);
+	length += BigNumberCodec::write_varint(data + length, (uint64_t)count);
+	for (int64_t i = 0; i < count; i++) {
+		double m;
+		int64_t e;
+		_get_values(p_values[i], m, e);
+		length += BigNumberCodec::write_value(data + length, m, e);
+	}
+
+	res.resize(length);
+	return res;
+}
+
+Array BigNumber::decode_array(const PackedByteArray &p_bytes) {
+	const uint8_t *data = p_bytes.ptr();
+	int64_t size = p_bytes.size();
+	BigNumberCodec::HeaderError header = BigNumberCodec::read_header(data, size, BigNumberCodec::KIND_ARRAY);
+	ERR_FAIL_COND_V_MSG(header != BigNumberCodec::HEADER_OK, Array(), String("BigNumber Error: ") + BigNumberCodec::get_header_error_text(header));
+
+	int64_t offset = BigNumberCodec::HEADER_SIZE;
+	uint64_t count;
+	int length = BigNumberCodec::read_varint(data + offset, size - offset, count);
+	offset += length;
+	// Checked against the data size first, a corrupted count must not allocate
+	ERR_FAIL_COND_V_MSG(length == 0 || count > (uint64_t)(size - offset) / BigNumberCodec::MIN_VALUE_SIZE, Array(), "BigNumber Error: Byte data is truncated.");
+
+	Array res;
+	res.resize((int64_t)count);
+	for (int64_t i = 0; i < (int64_t)count; i++) {
+		Ref<BigNumber> value = memnew(BigNumber);
+		length = BigNumberCodec::read_value(data + offset, size - offset, value->mantissa, value->exponent);
+		ERR_FAIL_COND_V_MSG(length == 0, Array(), "BigNumber Error: Byte data is truncated.");
+		offset += length;
+		res[i] = value;
+	}
+	ERR_FAIL_COND_V_MSG(offset != size, Array(), "BigNumber Error: Byte data continues past the encoded values.");
+	return res;
 }
 
 String BigNumber::_to_string() const {
-	String m_str = String::num(mantissa);
+	String m_str = num_string(mantissa);
 	int mantissa_decimals = 0;
 	if (m_str.find(".") >= 0) {
 		mantissa_decimals = m_str.split(".")[1].length();
@@ -514,7 +1421,7 @@ String BigNumber::_to_string() const {
 
 	if (mantissa_decimals > exponent) {
 		if (exponent < 248) {
-			return String::num(mantissa * Math::pow(10.0, (double)exponent));
+			return num_string(BigNumberCore::to_float(mantissa, exponent));
 		} else {
 			return to_plain_scientific();
 		}
@@ -527,221 +1434,445 @@ String BigNumber::_to_string() const {
 	}
 }
 
-Dictionary BigNumber::get_options() {
-	static Dictionary options;
-	if (options.is_empty()) {
-		const OptionKeys &k = get_option_keys();
-		options[k.default_mantissa] = 1.0;
-		options[k.default_exponent] = 0;
-		options[k.dynamic_decimals] = false;
-		options[k.dynamic_numbers] = 4;
-		options[k.small_decimals] = 2;
-		options[k.thousand_decimals] = 2;
-		options[k.big_decimals] = 2;
-		options[k.scientific_decimals] = 2;
-		options[k.logarithmic_decimals] = 2;
-		options[k.maximum_trailing_zeroes] = 3;
-		options[k.thousand_separator] = ",";
-		options[k.decimal_separator] = ".";
-		options[k.suffix_separator] = "";
-		options[k.reading_separator] = "";
-		options[k.thousand_name] = "thousand";
-	}
-	return options;
+const BigNumber::FormatOptions &BigNumber::get_format_options() {
+	if (should_sync_shared_options()) {
+		_sync_shared_options();
+	}
+	OptionsState &state = get_options_state();
+	uint64_t version = state.version.load(std::memory_order_acquire);
+	if (!local_options.snapshot || local_options.version != version) {
+		std::lock_guard<std::mutex> lock(state.mutex);
+		local_options.snapshot = state.current;
+		local_options.version = local_options.snapshot->version;
+	}
+	return *local_options.snapshot;
 }
 
-String BigNumber::to_scientific(bool no_decimals_on_small_values, bool force_decimals) const {
-	const OptionKeys &k = get_option_keys();
+std::shared_ptr<const BigNumber::FormatOptions> BigNumber::get_format_options_snapshot() {
+	get_format_options();
+	return local_options.snapshot;
+}
 
-	Dictionary opts = get_options();
-	int scientific_decimals = opts[k.scientific_decimals];
-	bool dynamic_decimals = opts[k.dynamic_decimals];
-	int dynamic_numbers = opts[k.dynamic_numbers];
-	String decimal_separator = opts[k.decimal_separator];
-	
-	if (exponent < 3) {
-		double decimal_increments = 1.0 / (Math::pow(10.0, scientific_decimals) / 10.0);
-		double val = Math::snapped(mantissa * Math::pow(10.0, (double)exponent), decimal_increments);
-		String value = String::num(val, scientific_decimals);
-		// Note: String::num might use '.' always? We should check if we need to replace it.
-		// Usually internal string is dot.
-		PackedStringArray split = value.split(".");
-		if (no_decimals_on_small_values) return split[0];
-		
-		if (split.size() > 1) {
-			int limit = scientific_decimals;
-			if (dynamic_decimals) limit = dynamic_numbers - split[0].length(); // Can be negative? MIN handles it?
-			limit = MAX(0, MIN(limit, scientific_decimals)); // Ensure positive
-			
-			String decimals = split[1].substr(0, limit);
-			if (decimals.is_empty()) return split[0];
-			return split[0] + decimal_separator + decimals;
-		} else {
-			return value;
-		}
-	} else {
-		// Mantissa is 1.0 to 10.0
-		String m_str = String::num(mantissa, scientific_decimals + 2); // Extra precision
-		PackedStringArray split = m_str.split(".");
-		if (split.size() == 1) split.append("");
-		
-		if (force_decimals) {
-			while (split[1].length() < scientific_decimals) split[1] += "0";
+Dictionary BigNumber::get_options() {
+	if (!is_main_thread()) {
+		// A copy, the shared Dictionary is not safe to use from other threads
+		Dictionary options;
+		fill_options(get_format_options(), options);
+		return options;
+	}
+
+	SharedOptions &shared = get_shared_options();
+	if (!shared.handed_out.load(std::memory_order_relaxed)) {
+		// Forces the first sync to fill it
+		shared.hash = shared.dictionary.hash() + 1;
+		shared.handed_out.store(true, std::memory_order_relaxed);
+	}
+	_sync_shared_options();
+	return shared.dictionary;
+}
+
+void BigNumber::_sync_shared_options() {
+	SharedOptions &shared = get_shared_options();
+	OptionsState &state = get_options_state();
+	bool edited = shared.dictionary.hash() != shared.hash;
+	if (edited) {
+		Dictionary changes;
+		Array keys = shared.dictionary.keys();
+		for (int64_t i = 0; i < keys.size(); i++) {
+			Variant value = shared.dictionary[keys[i]];
+			if (!shared.synced.has(keys[i]) || shared.synced[keys[i]] != value) {
+				changes[keys[i]] = value;
+			}
 		}
-		
-		int limit = scientific_decimals;
-		if (dynamic_decimals) limit = dynamic_numbers - 1 - String::num_int64(exponent).length();
-		limit = MAX(0, MIN(limit, scientific_decimals));
-		
-		String decl = split[1].substr(0, limit);
-		if (decl.is_empty() && !force_decimals) return split[0] + "e" + String::num_int64(exponent);
-		
-		return split[0] + decimal_separator + decl + "e" + String::num_int64(exponent);
+		_publish_options(changes);
+	} else if (shared.version == state.version.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	std::shared_ptr<const FormatOptions> current;
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		current = state.current;
 	}
+	// Rebuilt from scratch, which also drops the keys set_options() rejected
+	shared.dictionary.clear();
+	fill_options(*current, shared.dictionary);
+	shared.synced = shared.dictionary.duplicate();
+	shared.hash = shared.dictionary.hash();
+	shared.version = current->version;
 }
 
-String BigNumber::to_prefix(bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals, bool scientific_prefix) const {
+bool BigNumber::_apply_option(FormatOptions &r_options, const StringName &p_key, const Variant &p_value) {
 	const OptionKeys &k = get_option_keys();
 
-	Dictionary opts = get_options();
-	int small_decimals = opts[k.small_decimals];
-	int thousand_decimals = opts[k.thousand_decimals];
-	int big_decimals = opts[k.big_decimals];
-	bool dynamic_decimals = opts[k.dynamic_decimals];
-	int dynamic_numbers = opts[k.dynamic_numbers];
-	String decimal_separator = opts[k.decimal_separator];
-	String thousand_separator = opts[k.thousand_separator];
-	
-	double number = mantissa;
-	if (!scientific_prefix) {
-		int hundreds = 1;
-		for (int i = 0; i < (exponent % 3); i++) hundreds *= 10;
-		number *= hundreds;
-	}
-	
-	String s_num = String::num(number); 
-	PackedStringArray split = s_num.split(".");
-	if (split.size() == 1) split.append("");
-	
-	int max_decimals = MAX(MAX(small_decimals, thousand_decimals), big_decimals);
-	if (force_decimals) {
-		while (split[1].length() < max_decimals) split[1] += "0";
-	}
-	
-	if (no_decimals_on_small_values && exponent < 3) {
-		return split[0];
-	} else if (exponent < 3) {
-		if (small_decimals == 0 || split[1] == "") return split[0];
-		int limit = small_decimals;
-		if (dynamic_decimals) limit = dynamic_numbers - split[0].length();
-		limit = MAX(0, MIN(limit, small_decimals));
-		return split[0] + decimal_separator + split[1].substr(0, limit);
-	} else if (exponent < 6) {
-		if (thousand_decimals == 0 || (split[1] == "" && use_thousand_symbol)) return split[0];
-		
-		if (use_thousand_symbol) {
-			int limit = 3;
-			if (dynamic_decimals) limit = dynamic_numbers - split[0].length();
-			limit = MAX(0, MIN(limit, thousand_decimals));
-			return split[0] + decimal_separator + split[1].substr(0, limit);
-		} else {
-			return split[0] + thousand_separator + split[1].substr(0, 3);
-		}
+	if (p_key == k.default_mantissa) {
+		r_options.default_mantissa = p_value;
+	} else if (p_key == k.default_exponent) {
+		r_options.default_exponent = p_value;
+	} else if (p_key == k.dynamic_decimals) {
+		r_options.dynamic_decimals = p_value;
+	} else if (p_key == k.dynamic_numbers) {
+		r_options.dynamic_numbers = p_value;
+	} else if (p_key == k.small_decimals) {
+		r_options.small_decimals = p_value;
+	} else if (p_key == k.thousand_decimals) {
+		r_options.thousand_decimals = p_value;
+	} else if (p_key == k.big_decimals) {
+		r_options.big_decimals = p_value;
+	} else if (p_key == k.scientific_decimals) {
+		r_options.scientific_decimals = p_value;
+	} else if (p_key == k.logarithmic_decimals) {
+		r_options.logarithmic_decimals = p_value;
+	} else if (p_key == k.maximum_trailing_zeroes) {
+		r_options.maximum_trailing_zeroes = p_value;
+	} else if (p_key == k.thousand_separator) {
+		r_options.thousand_separator = p_value;
+	} else if (p_key == k.decimal_separator) {
+		r_options.decimal_separator = p_value;
+	} else if (p_key == k.suffix_separator) {
+		r_options.suffix_separator = p_value;
+	} else if (p_key == k.reading_separator) {
+		r_options.reading_separator = p_value;
+	} else if (p_key == k.thousand_name) {
+		r_options.thousand_name = p_value;
 	} else {
-		if (big_decimals == 0 || split[1] == "") return split[0];
-		int limit = big_decimals;
-		if (dynamic_decimals) limit = dynamic_numbers - split[0].length();
-		limit = MAX(0, MIN(limit, big_decimals));
-		return split[0] + decimal_separator + split[1].substr(0, limit);
+		ERR_PRINT("BigNumber Error: Unknown option \"" + String(p_key) + "\".");
+		return false;
 	}
+	return true;
 }
 
-String BigNumber::to_aa(bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals) const {
-	static Dictionary suffixes_aa;
-	if (suffixes_aa.is_empty()) {
-		suffixes_aa["0"] = "";
-		suffixes_aa["1"] = "k";
-		suffixes_aa["2"] = "m";
-		suffixes_aa["3"] = "b";
-		suffixes_aa["4"] = "t";
+void BigNumber::set_option(const StringName &p_key, const Variant &p_value) {
+	// Earlier in-place edits first, so this call wins over them
+	if (should_sync_shared_options()) {
+		_sync_shared_options();
 	}
+	OptionsState &state = get_options_state();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	FormatOptions opts = *state.current;
+	if (_apply_option(opts, p_key, p_value)) {
+		state.publish(opts);
+	}
+}
 
-	const OptionKeys &k = get_option_keys();
-	Dictionary opts = get_options();
-	String suffix_separator = opts[k.suffix_separator];
-	
-	int64_t target = exponent / 3;
-	String aa_index = String::num_int64(target);
-	String suffix = "";
-	
-	if (!suffixes_aa.has(aa_index)) {
-		// Generate suffix
-		int64_t offset = target + 22; // Offset matching standard AA
-		int64_t base = 26;
-		
-		while (offset > 0) {
-			offset -= 1;
-			int digit = offset % base;
-			suffix = String(ALPHABET[digit]) + suffix;
-			offset /= base;
+void BigNumber::set_options(const Dictionary &p_options) {
+	// Earlier in-place edits first, so this call wins over them
+	if (should_sync_shared_options()) {
+		_sync_shared_options();
+	}
+	_publish_options(p_options);
+}
+
+void BigNumber::_publish_options(const Dictionary &p_options) {
+	OptionsState &state = get_options_state();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	FormatOptions opts = *state.current;
+	Array keys = p_options.keys();
+	bool changed = false;
+	for (int64_t i = 0; i < keys.size(); i++) {
+		if (_apply_option(opts, keys[i], p_options[keys[i]])) {
+			changed = true;
 		}
-		suffixes_aa[aa_index] = suffix;
-	} else {
-		suffix = suffixes_aa[aa_index];
 	}
-	
-	if (!use_thousand_symbol && target == 1) {
-		suffix = "";
+	// One snapshot for the whole Dictionary
+	if (changed) {
+		state.publish(opts);
 	}
-	
-	String prefix = to_prefix(no_decimals_on_small_values, use_thousand_symbol, force_decimals);
-	return prefix + suffix_separator + suffix;
+}
+
+int64_t BigNumber::get_options_version() {
+	return (int64_t)get_options_state().version.load(std::memory_order_acquire);
+}
+
+String BigNumber::to_scientific(bool no_decimals_on_small_values, bool force_decimals) const {
+	uint32_t flags = 0;
+	if (no_decimals_on_small_values) flags |= FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
+	if (force_decimals) flags |= FORMAT_FORCE_DECIMALS;
+	return format(NOTATION_SCIENTIFIC, flags);
+}
+
+String BigNumber::to_prefix(bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals, bool scientific_prefix) const {
+	uint32_t flags = 0;
+	if (no_decimals_on_small_values) flags |= FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
+	if (use_thousand_symbol) flags |= FORMAT_USE_THOUSAND_SYMBOL;
+	if (force_decimals) flags |= FORMAT_FORCE_DECIMALS;
+	if (scientific_prefix) flags |= FORMAT_SCIENTIFIC_PREFIX;
+	return format(NOTATION_PREFIX, flags);
+}
+
+String BigNumber::to_aa(bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals) const {
+	uint32_t flags = 0;
+	if (no_decimals_on_small_values) flags |= FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
+	if (use_thousand_symbol) flags |= FORMAT_USE_THOUSAND_SYMBOL;
+	if (force_decimals) flags |= FORMAT_FORCE_DECIMALS;
+	return format(NOTATION_AA, flags);
 }
 
 String BigNumber::to_metric_symbol(bool no_decimals_on_small_values) const {
-	Dictionary opts = get_options();
-	const OptionKeys &k = get_option_keys();
-	String suffix_separator = opts[k.suffix_separator];
+	return format(NOTATION_METRIC_SYMBOL, no_decimals_on_small_values ? FORMAT_NO_DECIMALS_ON_SMALL_VALUES : 0);
+}
 
-	int64_t target = exponent / 3;
+String BigNumber::to_metric_name(bool no_decimals_on_small_values) const {
+	return format(NOTATION_METRIC_NAME, no_decimals_on_small_values ? FORMAT_NO_DECIMALS_ON_SMALL_VALUES : 0);
+}
 
-	if (target >= 0 && target < (int64_t)(sizeof(METRIC_SYMBOLS) / sizeof(METRIC_SYMBOLS[0]))) {
-		return to_prefix(no_decimals_on_small_values) + suffix_separator + METRIC_SYMBOLS[target];
-	} else {
-		return to_scientific();
+String BigNumber::to_short_scale(bool no_decimals_on_small_values) const {
+	return format(NOTATION_SHORT_SCALE, no_decimals_on_small_values ? FORMAT_NO_DECIMALS_ON_SMALL_VALUES : 0);
+}
+
+String BigNumber::to_long_name(bool no_decimals_on_small_values, bool european_system) const {
+	uint32_t flags = 0;
+	if (no_decimals_on_small_values) flags |= FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
+	if (european_system) flags |= FORMAT_EUROPEAN_SYSTEM;
+	return format(NOTATION_LONG_NAME, flags);
+}
+
+String BigNumber::format(Notation p_notation, BitField<FormatFlags> p_flags) const {
+	uint32_t flags = (uint32_t)(int64_t)p_flags & _get_notation_flags_mask(p_notation);
+	return _format_cached(mantissa, exponent, p_notation, flags);
+}
+
+String BigNumber::_format_cached(double p_mantissa, int64_t p_exponent, Notation p_notation, uint32_t p_flags) {
+	BIG_NUMBER_PROFILE(GROUP_FORMAT);
+	if (!FormatCache::is_enabled()) {
+		return _format(p_mantissa, p_exponent, p_notation, p_flags);
+	}
+
+	// One snapshot for both the key and the string
+	const FormatOptions &options = get_format_options();
+	FormatCache::Key key;
+	if (!_get_format_key(p_mantissa, p_exponent, p_notation, p_flags, options, key)) {
+		// Too close to a rounding boundary to share a cached string
+		return _format(p_mantissa, p_exponent, p_notation, p_flags, options);
+	}
+
+	String result;
+	if (FormatCache::lookup(key, result)) {
+		return result;
 	}
+	result = _format(p_mantissa, p_exponent, p_notation, p_flags, options);
+	FormatCache::store(key, result);
+	return result;
 }
 
-String BigNumber::to_metric_name(bool no_decimals_on_small_values) const {
-	Dictionary opts = get_options();
-	const OptionKeys &k = get_option_keys();
-	String suffix_separator = opts[k.suffix_separator];
+String BigNumber::_format(double p_mantissa, int64_t p_exponent, Notation p_notation, uint32_t p_flags) {
+	return _format(p_mantissa, p_exponent, p_notation, p_flags, get_format_options());
+}
 
-	int64_t target = exponent / 3;
+String BigNumber::_format(double p_mantissa, int64_t p_exponent, Notation p_notation, uint32_t p_flags, const FormatOptions &p_options) {
+	bool no_decimals = p_flags & FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
+	bool use_thousand_symbol = p_flags & FORMAT_USE_THOUSAND_SYMBOL;
+	bool force_decimals = p_flags & FORMAT_FORCE_DECIMALS;
+
+	switch (p_notation) {
+		case NOTATION_SCIENTIFIC:
+			return _format_scientific(p_mantissa, p_exponent, no_decimals, force_decimals, p_options);
+		case NOTATION_PREFIX:
+			return _format_prefix(p_mantissa, p_exponent, no_decimals, use_thousand_symbol, force_decimals, p_flags & FORMAT_SCIENTIFIC_PREFIX, p_options);
+		case NOTATION_AA:
+			return _format_aa(p_mantissa, p_exponent, no_decimals, use_thousand_symbol, force_decimals, p_options);
+		case NOTATION_METRIC_SYMBOL:
+			return _format_metric_symbol(p_mantissa, p_exponent, no_decimals, p_options);
+		case NOTATION_METRIC_NAME:
+			return _format_metric_name(p_mantissa, p_exponent, no_decimals, p_options);
+		case NOTATION_SHORT_SCALE:
+			return _format_short_scale(p_mantissa, p_exponent, no_decimals, p_options);
+		case NOTATION_LONG_NAME:
+			return _format_long_name(p_mantissa, p_exponent, no_decimals, p_flags & FORMAT_EUROPEAN_SYSTEM, p_options);
+	}
+	ERR_PRINT("BigNumber Error: Unknown notation " + String::num_int64(p_notation) + ".");
+	return _format_scientific(p_mantissa, p_exponent, false, false, p_options);
+}
 
-	if (target >= 0 && target < (int64_t)(sizeof(METRIC_NAMES) / sizeof(METRIC_NAMES[0]))) {
-		return to_prefix(no_decimals_on_small_values) + suffix_separator + METRIC_NAMES[target];
-	} else {
-		return to_scientific();
+uint32_t BigNumber::_get_notation_flags_mask(Notation p_notation) {
+	switch (p_notation) {
+		case NOTATION_SCIENTIFIC:
+			return FORMAT_NO_DECIMALS_ON_SMALL_VALUES | FORMAT_FORCE_DECIMALS;
+		case NOTATION_PREFIX:
+			return FORMAT_NO_DECIMALS_ON_SMALL_VALUES | FORMAT_USE_THOUSAND_SYMBOL | FORMAT_FORCE_DECIMALS | FORMAT_SCIENTIFIC_PREFIX;
+		case NOTATION_AA:
+			return FORMAT_NO_DECIMALS_ON_SMALL_VALUES | FORMAT_USE_THOUSAND_SYMBOL | FORMAT_FORCE_DECIMALS;
+		case NOTATION_LONG_NAME:
+			return FORMAT_NO_DECIMALS_ON_SMALL_VALUES | FORMAT_EUROPEAN_SYSTEM;
+		default:
+			return FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
 	}
 }
 
-String BigNumber::to_short_scale(bool no_decimals_on_small_values) const {
-	Dictionary opts = get_options();
-	const OptionKeys &k = get_option_keys();
-	String suffix_separator = opts[k.suffix_separator];
+bool BigNumber::_get_format_key(double p_mantissa, int64_t p_exponent, Notation p_notation, uint32_t p_flags, const FormatOptions &p_options, FormatCache::Key &r_key) {
+	if (!Math::is_finite(p_mantissa)) {
+		return false;
+	}
+
+	r_key.exponent = p_exponent;
+	r_key.options_version = p_options.version;
+	r_key.notation = p_notation;
+	r_key.flags = p_flags;
+
+	// Metric and short scale fall back to scientific outside their tables,
+	// all three tables have the same length
+	int64_t target = p_exponent / 3;
+	bool in_table = target >= 0 && target < NumberFormat::TABLE_SIZE;
+
+	switch (p_notation) {
+		case NOTATION_PREFIX:
+			return _quantize_prefix(p_mantissa, p_exponent, p_flags, p_options, r_key.quantized);
+		case NOTATION_AA:
+			return _quantize_prefix(p_mantissa, p_exponent, p_flags & ~FORMAT_SCIENTIFIC_PREFIX, p_options, r_key.quantized);
+		case NOTATION_METRIC_SYMBOL:
+		case NOTATION_METRIC_NAME:
+		case NOTATION_SHORT_SCALE:
+			if (in_table) {
+				return _quantize_prefix(p_mantissa, p_exponent, 0, p_options, r_key.quantized);
+			}
+			return _quantize_scientific(p_mantissa, p_exponent, p_options, r_key.quantized);
+		case NOTATION_LONG_NAME:
+			// The name only depends on the exponent, which is in the key
+			return _quantize_prefix(p_mantissa, p_exponent, 0, p_options, r_key.quantized);
+		default:
+			return _quantize_scientific(p_mantissa, p_exponent, p_options, r_key.quantized);
+	}
+}
+
+bool BigNumber::_quantize_prefix(double p_mantissa, int64_t p_exponent, uint32_t p_flags, const FormatOptions &p_options, int64_t &r_quantized) {
+	// Same scaling as _format_prefix()
+	double number = (p_flags & FORMAT_SCIENTIFIC_PREFIX) ? p_mantissa : NumberFormat::scale_prefix(p_mantissa, p_exponent);
 
-	int64_t target = exponent / 3;
+	// Deepest digit _format_prefix() can show
+	int decimals = MAX(MAX(MAX(p_options.small_decimals, p_options.thousand_decimals), p_options.big_decimals), 3);
+	double abs_number = Math::abs(number);
+	if (decimals > 8 || abs_number >= 1000000.0) {
+		return false;
+	}
 
-	if (target >= 0 && target < (int64_t)(sizeof(SHORT_SCALE_NAMES) / sizeof(SHORT_SCALE_NAMES[0]))) {
-		return to_prefix(no_decimals_on_small_values) + suffix_separator + SHORT_SCALE_NAMES[target];
+	int print_decimals = BigNumberCore::default_decimals(number);
+
+	double scaled = number * PowerOfTen::get(decimals);
+	double whole = Math::floor(scaled);
+	double fraction = scaled - whole;
+
+	// Within this distance of a whole step every printed digit past the step
+	// is zero, so the trailing zeroes get stripped and the step alone decides
+	// the string. Otherwise the value must be far enough from both steps that
+	// the printed digits are truncated to the same step.
+	double exact_margin = 0.25 * PowerOfTen::get(decimals - print_decimals);
+	bool exact;
+	if (fraction < exact_margin) {
+		exact = true;
+	} else if (fraction > 1.0 - exact_margin) {
+		whole += 1.0;
+		exact = true;
+	} else if (fraction > 0.0001 && fraction < 0.9999) {
+		exact = false;
 	} else {
-		return to_scientific();
+		return false;
 	}
+
+	r_quantized = (int64_t)whole * 2 + (exact ? 0 : 1);
+	return true;
+}
+
+bool BigNumber::_quantize_scientific(double p_mantissa, int64_t p_exponent, const FormatOptions &p_options, int64_t &r_quantized) {
+	int scientific_decimals = p_options.scientific_decimals;
+
+	if (p_exponent < 3) {
+		// Same snapping as _format_scientific(), the snapped value alone
+		// decides the string
+		double decimal_increments = 1.0 / (PowerOfTen::get(scientific_decimals) / 10.0);
+		if (decimal_increments == 0.0 || !Math::is_finite(decimal_increments)) {
+			return false;
+		}
+		double steps = Math::floor(p_mantissa * PowerOfTen::get(p_exponent) / decimal_increments + 0.5);
+		if (!(Math::abs(steps) < 4503599627370496.0)) {
+			return false;
+		}
+		r_quantized = (int64_t)steps;
+		return true;
+	}
+
+	// The mantissa is printed rounded to scientific_decimals + 2 digits
+	int decimals = scientific_decimals + 2;
+	if (decimals < 0 || decimals > 8 || !(Math::abs(p_mantissa) < 1000000.0)) {
+		return false;
+	}
+	double scaled = p_mantissa * PowerOfTen::get(decimals);
+	double whole = Math::floor(scaled);
+	double fraction = scaled - whole;
+	if (Math::abs(fraction - 0.5) < 0.0001) {
+		return false;
+	}
+	r_quantized = (int64_t)whole + (fraction > 0.5 ? 1 : 0);
+	return true;
+}
+
+void BigNumber::set_format_cache_capacity(int64_t p_capacity) {
+	FormatCache::set_capacity(p_capacity);
+}
+
+int64_t BigNumber::get_format_cache_capacity() {
+	return FormatCache::get_capacity();
+}
+
+int64_t BigNumber::get_format_cache_hits() {
+	return FormatCache::get_hits();
+}
+
+int64_t BigNumber::get_format_cache_misses() {
+	return FormatCache::get_misses();
+}
+
+void BigNumber::clear_format_cache() {
+	FormatCache::clear();
+	FormatCache::reset_stats();
+}
+
+String BigNumber::_format_scientific(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, bool force_decimals, const FormatOptions &p_options) {
+	FormatBuffer buffer(p_options);
+	NumberFormat::scientific(p_mantissa, p_exponent, no_decimals_on_small_values, force_decimals, buffer.settings, buffer.writer);
+	return buffer.to_string();
+}
+
+String BigNumber::_format_prefix(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals, bool scientific_prefix, const FormatOptions &p_options) {
+	FormatBuffer buffer(p_options);
+	NumberFormat::prefix(p_mantissa, p_exponent, no_decimals_on_small_values, use_thousand_symbol, force_decimals, scientific_prefix, buffer.settings, buffer.writer);
+	return buffer.to_string();
+}
+
+String BigNumber::_format_aa(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals, const FormatOptions &p_options) {
+	FormatBuffer buffer(p_options);
+	NumberFormat::aa(p_mantissa, p_exponent, no_decimals_on_small_values, use_thousand_symbol, force_decimals, buffer.settings, buffer.writer);
+	return buffer.to_string();
+}
+
+String BigNumber::_format_metric_symbol(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, const FormatOptions &p_options) {
+	FormatBuffer buffer(p_options);
+	NumberFormat::metric_symbol(p_mantissa, p_exponent, no_decimals_on_small_values, buffer.settings, buffer.writer);
+	return buffer.to_string();
+}
+
+String BigNumber::_format_metric_name(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, const FormatOptions &p_options) {
+	FormatBuffer buffer(p_options);
+	NumberFormat::metric_name(p_mantissa, p_exponent, no_decimals_on_small_values, buffer.settings, buffer.writer);
+	return buffer.to_string();
+}
+
+String BigNumber::_format_short_scale(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, const FormatOptions &p_options) {
+	FormatBuffer buffer(p_options);
+	NumberFormat::short_scale(p_mantissa, p_exponent, no_decimals_on_small_values, buffer.settings, buffer.writer);
+	return buffer.to_string();
+}
+
+String BigNumber::_format_long_name(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, bool european_system, const FormatOptions &p_options) {
+	FormatBuffer buffer(p_options);
+	NumberFormat::long_name(p_mantissa, p_exponent, no_decimals_on_small_values, european_system, buffer.settings, &long_name_memo, buffer.writer);
+	return buffer.to_string();
 }
 
 void BigNumber::_bind_methods() {
 	ClassDB::bind_static_method("BigNumber", D_METHOD("get_options"), &BigNumber::get_options);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("set_options", "options"), &BigNumber::set_options);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("set_option", "key", "value"), &BigNumber::set_option);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("get_options_version"), &BigNumber::get_options_version);
 
 	ClassDB::bind_method(D_METHOD("to_scientific", "no_decimals_on_small_values", "force_decimals"), &BigNumber::to_scientific, DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("to_prefix", "no_decimals_on_small_values", "use_thousand_symbol", "force_decimals", "scientific_prefix"), &BigNumber::to_prefix, DEFVAL(false), DEFVAL(true), DEFVAL(true), DEFVAL(false));
@@ -749,6 +1880,28 @@ void BigNumber::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("to_metric_symbol", "no_decimals_on_small_values"), &BigNumber::to_metric_symbol, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("to_metric_name", "no_decimals_on_small_values"), &BigNumber::to_metric_name, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("to_short_scale", "no_decimals_on_small_values"), &BigNumber::to_short_scale, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("to_long_name", "no_decimals_on_small_values", "european_system"), &BigNumber::to_long_name, DEFVAL(false), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("format", "notation", "flags"), &BigNumber::format, DEFVAL(0));
+
+	BIND_ENUM_CONSTANT(NOTATION_SCIENTIFIC);
+	BIND_ENUM_CONSTANT(NOTATION_PREFIX);
+	BIND_ENUM_CONSTANT(NOTATION_AA);
+	BIND_ENUM_CONSTANT(NOTATION_METRIC_SYMBOL);
+	BIND_ENUM_CONSTANT(NOTATION_METRIC_NAME);
+	BIND_ENUM_CONSTANT(NOTATION_SHORT_SCALE);
+	BIND_ENUM_CONSTANT(NOTATION_LONG_NAME);
+
+	BIND_BITFIELD_FLAG(FORMAT_NO_DECIMALS_ON_SMALL_VALUES);
+	BIND_BITFIELD_FLAG(FORMAT_USE_THOUSAND_SYMBOL);
+	BIND_BITFIELD_FLAG(FORMAT_FORCE_DECIMALS);
+	BIND_BITFIELD_FLAG(FORMAT_SCIENTIFIC_PREFIX);
+	BIND_BITFIELD_FLAG(FORMAT_EUROPEAN_SYSTEM);
+
+	ClassDB::bind_static_method("BigNumber", D_METHOD("set_format_cache_capacity", "capacity"), &BigNumber::set_format_cache_capacity);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("get_format_cache_capacity"), &BigNumber::get_format_cache_capacity);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("get_format_cache_hits"), &BigNumber::get_format_cache_hits);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("get_format_cache_misses"), &BigNumber::get_format_cache_misses);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("clear_format_cache"), &BigNumber::clear_format_cache);
 
 	ClassDB::bind_method(D_METHOD("set_mantissa", "mantissa"), &BigNumber::set_mantissa);
 	ClassDB::bind_method(D_METHOD("get_mantissa"), &BigNumber::get_mantissa);
@@ -765,6 +1918,22 @@ void BigNumber::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_less_than_or_equal_to", "n"), &BigNumber::is_less_than_or_equal_to);
 	ClassDB::bind_method(D_METHOD("is_greater_than_or_equal_to", "n"), &BigNumber::is_greater_than_or_equal_to);
 
+	ClassDB::bind_method(D_METHOD("is_less_than_big", "n"), &BigNumber::is_less_than_big);
+	ClassDB::bind_method(D_METHOD("is_less_than_int", "n"), &BigNumber::is_less_than_int);
+	ClassDB::bind_method(D_METHOD("is_less_than_float", "n"), &BigNumber::is_less_than_float);
+	ClassDB::bind_method(D_METHOD("is_equal_to_big", "n"), &BigNumber::is_equal_to_big);
+	ClassDB::bind_method(D_METHOD("is_equal_to_int", "n"), &BigNumber::is_equal_to_int);
+	ClassDB::bind_method(D_METHOD("is_equal_to_float", "n"), &BigNumber::is_equal_to_float);
+	ClassDB::bind_method(D_METHOD("is_greater_than_big", "n"), &BigNumber::is_greater_than_big);
+	ClassDB::bind_method(D_METHOD("is_greater_than_int", "n"), &BigNumber::is_greater_than_int);
+	ClassDB::bind_method(D_METHOD("is_greater_than_float", "n"), &BigNumber::is_greater_than_float);
+	ClassDB::bind_method(D_METHOD("is_less_than_or_equal_to_big", "n"), &BigNumber::is_less_than_or_equal_to_big);
+	ClassDB::bind_method(D_METHOD("is_less_than_or_equal_to_int", "n"), &BigNumber::is_less_than_or_equal_to_int);
+	ClassDB::bind_method(D_METHOD("is_less_than_or_equal_to_float", "n"), &BigNumber::is_less_than_or_equal_to_float);
+	ClassDB::bind_method(D_METHOD("is_greater_than_or_equal_to_big", "n"), &BigNumber::is_greater_than_or_equal_to_big);
+	ClassDB::bind_method(D_METHOD("is_greater_than_or_equal_to_int", "n"), &BigNumber::is_greater_than_or_equal_to_int);
+	ClassDB::bind_method(D_METHOD("is_greater_than_or_equal_to_float", "n"), &BigNumber::is_greater_than_or_equal_to_float);
+
 	ClassDB::bind_method(D_METHOD("plus", "n"), &BigNumber::plus);
 	ClassDB::bind_method(D_METHOD("plus_equals", "n"), &BigNumber::plus_equals);
 	ClassDB::bind_method(D_METHOD("minus", "n"), &BigNumber::minus);
@@ -774,16 +1943,76 @@ void BigNumber::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("divide", "n"), &BigNumber::divide);
 	ClassDB::bind_method(D_METHOD("divide_equals", "n"), &BigNumber::divide_equals);
 
+	ClassDB::bind_method(D_METHOD("plus_big", "n"), &BigNumber::plus_big);
+	ClassDB::bind_method(D_METHOD("plus_int", "n"), &BigNumber::plus_int);
+	ClassDB::bind_method(D_METHOD("plus_float", "n"), &BigNumber::plus_float);
+	ClassDB::bind_method(D_METHOD("plus_equals_big", "n"), &BigNumber::plus_equals_big);
+	ClassDB::bind_method(D_METHOD("plus_equals_int", "n"), &BigNumber::plus_equals_int);
+	ClassDB::bind_method(D_METHOD("plus_equals_float", "n"), &BigNumber::plus_equals_float);
+	ClassDB::bind_method(D_METHOD("minus_big", "n"), &BigNumber::minus_big);
+	ClassDB::bind_method(D_METHOD("minus_int", "n"), &BigNumber::minus_int);
+	ClassDB::bind_method(D_METHOD("minus_float", "n"), &BigNumber::minus_float);
+	ClassDB::bind_method(D_METHOD("minus_equals_big", "n"), &BigNumber::minus_equals_big);
+	ClassDB::bind_method(D_METHOD("minus_equals_int", "n"), &BigNumber::minus_equals_int);
+	ClassDB::bind_method(D_METHOD("minus_equals_float", "n"), &BigNumber::minus_equals_float);
+	ClassDB::bind_method(D_METHOD("multiply_big", "n"), &BigNumber::multiply_big);
+	ClassDB::bind_method(D_METHOD("multiply_int", "n"), &BigNumber::multiply_int);
+	ClassDB::bind_method(D_METHOD("multiply_float", "n"), &BigNumber::multiply_float);
+	ClassDB::bind_method(D_METHOD("multiply_equals_big", "n"), &BigNumber::multiply_equals_big);
+	ClassDB::bind_method(D_METHOD("multiply_equals_int", "n"), &BigNumber::multiply_equals_int);
+	ClassDB::bind_method(D_METHOD("multiply_equals_float", "n"), &BigNumber::multiply_equals_float);
+	ClassDB::bind_method(D_METHOD("divide_big", "n"), &BigNumber::divide_big);
+	ClassDB::bind_method(D_METHOD("divide_int", "n"), &BigNumber::divide_int);
+	ClassDB::bind_method(D_METHOD("divide_float", "n"), &BigNumber::divide_float);
+	ClassDB::bind_method(D_METHOD("divide_equals_big", "n"), &BigNumber::divide_equals_big);
+	ClassDB::bind_method(D_METHOD("divide_equals_int", "n"), &BigNumber::divide_equals_int);
+	ClassDB::bind_method(D_METHOD("divide_equals_float", "n"), &BigNumber::divide_equals_float);
+
 	ClassDB::bind_method(D_METHOD("mod", "n"), &BigNumber::mod);
 	ClassDB::bind_method(D_METHOD("power", "n"), &BigNumber::power);
 	ClassDB::bind_method(D_METHOD("power_equals", "n"), &BigNumber::power_equals);
 	ClassDB::bind_method(D_METHOD("square_root"), &BigNumber::square_root);
 	ClassDB::bind_method(D_METHOD("absolute"), &BigNumber::absolute);
+
+	ClassDB::bind_method(D_METHOD("fma_equals", "a", "b"), &BigNumber::fma_equals);
+	ClassDB::bind_method(D_METHOD("scale_add_equals", "n", "scale"), &BigNumber::scale_add_equals);
+	ClassDB::bind_method(D_METHOD("min_equals", "n"), &BigNumber::min_equals);
+	ClassDB::bind_method(D_METHOD("max_equals", "n"), &BigNumber::max_equals);
+	ClassDB::bind_method(D_METHOD("clamp_equals", "min", "max"), &BigNumber::clamp_equals);
+	ClassDB::bind_method(D_METHOD("lerp_equals", "to", "weight", "logarithmic"), &BigNumber::lerp_equals, DEFVAL(false));
+	ClassDB::bind_static_method("BigNumber", D_METHOD("mul_add", "a", "b", "c"), &BigNumber::mul_add);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("sum_of", "values"), &BigNumber::sum_of);
+
 	ClassDB::bind_method(D_METHOD("log10"), &BigNumber::log10);
 	ClassDB::bind_method(D_METHOD("ln"), &BigNumber::ln);
 	ClassDB::bind_method(D_METHOD("floor_value"), &BigNumber::floor_value);
 	ClassDB::bind_method(D_METHOD("to_float"), &BigNumber::to_float);
 	ClassDB::bind_method(D_METHOD("to_plain_scientific"), &BigNumber::to_plain_scientific);
+	ClassDB::bind_method(D_METHOD("to_bytes"), &BigNumber::to_bytes);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("from_bytes", "bytes"), &BigNumber::from_bytes);
+	ClassDB::bind_method(D_METHOD("to_sort_key"), &BigNumber::to_sort_key);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("from_sort_key", "key"), &BigNumber::from_sort_key);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("parse", "text"), &BigNumber::parse);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("encode_array", "values"), &BigNumber::encode_array);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("decode_array", "bytes"), &BigNumber::decode_array);
+
+	ClassDB::bind_static_method("BigNumber", D_METHOD("add_into", "out", "a", "b"), &BigNumber::add_into);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("subtract_into", "out", "a", "b"), &BigNumber::subtract_into);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("multiply_into", "out", "a", "b"), &BigNumber::multiply_into);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("divide_into", "out", "a", "b"), &BigNumber::divide_into);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("mod_into", "out", "a", "b"), &BigNumber::mod_into);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("pow_into", "out", "a", "b"), &BigNumber::pow_into);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("sqrt_into", "out", "a"), &BigNumber::sqrt_into);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("abs_into", "out", "a"), &BigNumber::abs_into);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("mul_add_into", "out", "a", "b", "c"), &BigNumber::mul_add_into);
+
+	ClassDB::bind_static_method("BigNumber", D_METHOD("cost_of_n", "base", "growth", "owned", "count"), &BigNumber::cost_of_n);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("max_affordable", "base", "growth", "owned", "budget"), &BigNumber::max_affordable);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("cost_of_n_linear", "base", "increment", "owned", "count"), &BigNumber::cost_of_n_linear);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("max_affordable_linear", "base", "increment", "owned", "budget"), &BigNumber::max_affordable_linear);
+
+	ClassDB::bind_static_method("BigNumber", D_METHOD("get_allocation_count"), &BigNumber::get_allocation_count);
+	ClassDB::bind_static_method("BigNumber", D_METHOD("reset_allocation_count"), &BigNumber::reset_allocation_count);
 }
 
 
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "format_cache.hpp"
+
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+
+#include <memory>
 
 using namespace godot;
 
@@ -13,6 +19,49 @@ public:
 	static const double MANTISSA_MAX;
 	static const double MANTISSA_PRECISION;
 
+	enum Notation {
+		NOTATION_SCIENTIFIC,
+		NOTATION_PREFIX,
+		NOTATION_AA,
+		NOTATION_METRIC_SYMBOL,
+		NOTATION_METRIC_NAME,
+		NOTATION_SHORT_SCALE,
+		NOTATION_LONG_NAME,
+	};
+
+	// The boolean arguments of the to_* formatters
+	enum FormatFlags {
+		FORMAT_NO_DECIMALS_ON_SMALL_VALUES = 1,
+		FORMAT_USE_THOUSAND_SYMBOL = 2,
+		FORMAT_FORCE_DECIMALS = 4,
+		FORMAT_SCIENTIFIC_PREFIX = 8,
+		FORMAT_EUROPEAN_SYSTEM = 16,
+	};
+
+	// Formatting options compiled from the options Dictionary, so the
+	// formatters read plain fields instead of doing Dictionary lookups.
+	// Published as immutable snapshots, see get_format_options().
+	struct FormatOptions {
+		double default_mantissa = 1.0;
+		int64_t default_exponent = 0;
+		bool dynamic_decimals = false;
+		int dynamic_numbers = 4;
+		int small_decimals = 2;
+		int thousand_decimals = 2;
+		int big_decimals = 2;
+		int scientific_decimals = 2;
+		int logarithmic_decimals = 2;
+		int maximum_trailing_zeroes = 3;
+		String thousand_separator = ",";
+		String decimal_separator = ".";
+		String suffix_separator = "";
+		String reading_separator = "";
+		String thousand_name = "thousand";
+
+		// Bumped on every published change
+		uint64_t version = 0;
+	};
+
 	BigNumber();
 	BigNumber(const String &p_string);
 	BigNumber(int64_t p_int);
@@ -35,6 +84,23 @@ public:
 	bool is_less_than_or_equal_to(const Variant &n) const;
 	bool is_greater_than_or_equal_to(const Variant &n) const;
 
+	// Typed comparisons, skip Variant dispatch
+	bool is_less_than_big(const Ref<BigNumber> &n) const;
+	bool is_less_than_int(int64_t n) const;
+	bool is_less_than_float(double n) const;
+	bool is_equal_to_big(const Ref<BigNumber> &n) const;
+	bool is_equal_to_int(int64_t n) const;
+	bool is_equal_to_float(double n) const;
+	bool is_greater_than_big(const Ref<BigNumber> &n) const;
+	bool is_greater_than_int(int64_t n) const;
+	bool is_greater_than_float(double n) const;
+	bool is_less_than_or_equal_to_big(const Ref<BigNumber> &n) const;
+	bool is_less_than_or_equal_to_int(int64_t n) const;
+	bool is_less_than_or_equal_to_float(double n) const;
+	bool is_greater_than_or_equal_to_big(const Ref<BigNumber> &n) const;
+	bool is_greater_than_or_equal_to_int(int64_t n) const;
+	bool is_greater_than_or_equal_to_float(double n) const;
+
 	Ref<BigNumber> plus(const Variant &n) const;
 	Ref<BigNumber> plus_equals(const Variant &n);
 	Ref<BigNumber> minus(const Variant &n) const;
@@ -44,18 +110,89 @@ public:
 	Ref<BigNumber> divide(const Variant &n) const;
 	Ref<BigNumber> divide_equals(const Variant &n);
 
+	// Typed arithmetic, skip Variant dispatch
+	Ref<BigNumber> plus_big(const Ref<BigNumber> &n) const;
+	Ref<BigNumber> plus_int(int64_t n) const;
+	Ref<BigNumber> plus_float(double n) const;
+	Ref<BigNumber> plus_equals_big(const Ref<BigNumber> &n);
+	Ref<BigNumber> plus_equals_int(int64_t n);
+	Ref<BigNumber> plus_equals_float(double n);
+	Ref<BigNumber> minus_big(const Ref<BigNumber> &n) const;
+	Ref<BigNumber> minus_int(int64_t n) const;
+	Ref<BigNumber> minus_float(double n) const;
+	Ref<BigNumber> minus_equals_big(const Ref<BigNumber> &n);
+	Ref<BigNumber> minus_equals_int(int64_t n);
+	Ref<BigNumber> minus_equals_float(double n);
+	Ref<BigNumber> multiply_big(const Ref<BigNumber> &n) const;
+	Ref<BigNumber> multiply_int(int64_t n) const;
+	Ref<BigNumber> multiply_float(double n) const;
+	Ref<BigNumber> multiply_equals_big(const Ref<BigNumber> &n);
+	Ref<BigNumber> multiply_equals_int(int64_t n);
+	Ref<BigNumber> multiply_equals_float(double n);
+	Ref<BigNumber> divide_big(const Ref<BigNumber> &n) const;
+	Ref<BigNumber> divide_int(int64_t n) const;
+	Ref<BigNumber> divide_float(double n) const;
+	Ref<BigNumber> divide_equals_big(const Ref<BigNumber> &n);
+	Ref<BigNumber> divide_equals_int(int64_t n);
+	Ref<BigNumber> divide_equals_float(double n);
+
 	Ref<BigNumber> mod(const Variant &n) const;
 	Ref<BigNumber> power(const Variant &n) const;
 	Ref<BigNumber> power_equals(const Variant &n);
 	Ref<BigNumber> square_root() const;
 	Ref<BigNumber> absolute() const;
 
+	// Fused operations, normalize once at the end instead of after every step
+	Ref<BigNumber> fma_equals(const Variant &a, const Variant &b);
+	Ref<BigNumber> scale_add_equals(const Variant &n, double p_scale);
+	Ref<BigNumber> min_equals(const Variant &n);
+	Ref<BigNumber> max_equals(const Variant &n);
+	Ref<BigNumber> clamp_equals(const Variant &p_min, const Variant &p_max);
+	Ref<BigNumber> lerp_equals(const Variant &p_to, double p_weight, bool p_logarithmic = false);
+	static Ref<BigNumber> mul_add(const Variant &a, const Variant &b, const Variant &c);
+	static Ref<BigNumber> sum_of(const Array &p_values);
+
+	// Caller-owned results, no allocation
+	static Ref<BigNumber> add_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b);
+	static Ref<BigNumber> subtract_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b);
+	static Ref<BigNumber> multiply_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b);
+	static Ref<BigNumber> divide_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b);
+	static Ref<BigNumber> mod_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b);
+	static Ref<BigNumber> pow_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b);
+	static Ref<BigNumber> sqrt_into(const Ref<BigNumber> &r_out, const Variant &a);
+	static Ref<BigNumber> abs_into(const Ref<BigNumber> &r_out, const Variant &a);
+	static Ref<BigNumber> mul_add_into(const Ref<BigNumber> &r_out, const Variant &a, const Variant &b, const Variant &c);
+
+	// Bulk buying, level k costs base * growth^k or base + increment * k.
+	// Levels owned to owned + n - 1, see core/bulk_buy.hpp.
+	static Ref<BigNumber> cost_of_n(const Variant &p_base, double p_growth, int64_t p_owned, int64_t p_count);
+	static int64_t max_affordable(const Variant &p_base, double p_growth, int64_t p_owned, const Variant &p_budget);
+	static Ref<BigNumber> cost_of_n_linear(const Variant &p_base, const Variant &p_increment, int64_t p_owned, int64_t p_count);
+	static int64_t max_affordable_linear(const Variant &p_base, const Variant &p_increment, int64_t p_owned, const Variant &p_budget);
+
+	// Number of BigNumber objects created since the last reset
+	static int64_t get_allocation_count();
+	static void reset_allocation_count();
+
 	double log10() const;
 	double ln() const;
 	void floor_value();
 	double to_float() const;
 	String to_plain_scientific() const;
 
+	// Reads the output of every to_* formatter, with the configured separators
+	static Ref<BigNumber> parse(const String &p_text);
+
+	// Compact binary encoding, see core/binary_codec.hpp for the layout
+	PackedByteArray to_bytes() const;
+	static Ref<BigNumber> from_bytes(const PackedByteArray &p_bytes);
+	static PackedByteArray encode_array(const Array &p_values);
+	static Array decode_array(const PackedByteArray &p_bytes);
+
+	// Monotonic int64 key, see core/sort_key.hpp for the layout and precision
+	int64_t to_sort_key() const;
+	static Ref<BigNumber> from_sort_key(int64_t p_key);
+
 	String _to_string() const;
 
 	// Formatting methods
@@ -65,18 +202,72 @@ public:
 	String to_metric_symbol(bool no_decimals_on_small_values = false) const;
 	String to_metric_name(bool no_decimals_on_small_values = false) const;
 	String to_short_scale(bool no_decimals_on_small_values = false) const;
+	String to_long_name(bool no_decimals_on_small_values = false, bool european_system = false) const;
+	String format(Notation p_notation, BitField<FormatFlags> p_flags) const;
+
+	// Formatted string cache, disabled while the capacity is 0
+	static void set_format_cache_capacity(int64_t p_capacity);
+	static int64_t get_format_cache_capacity();
+	static int64_t get_format_cache_hits();
+	static int64_t get_format_cache_misses();
+	static void clear_format_cache();
 
 	// Static configuration
 	static Dictionary get_options();
+	static void set_options(const Dictionary &p_options);
+	static void set_option(const StringName &p_key, const Variant &p_value);
+	static int64_t get_options_version();
+	// Latest options snapshot seen by the calling thread. Stays valid until
+	// the same thread calls this again, so callers take it once and pass it
+	// down instead of calling it again.
+	static const FormatOptions &get_format_options();
+	// Same snapshot, shared, for work that outlives the next call such as
+	// formatting on other threads
+	static std::shared_ptr<const FormatOptions> get_format_options_snapshot();
 	
 protected:
 	static void _bind_methods();
 
 private:
-	static Ref<BigNumber> _type_check(const Variant &n);
+	friend class BigNumberAccumulator;
+	friend class BigNumberArray;
+	friend class BigNumberFormula;
+	friend class BigNumberLabel;
+	friend class BigNumberLedger;
+	friend class BigNumberLog;
+
 	static void _size_check(double p_mantissa);
+	static void _parse_string(const String &p_string, double &r_mantissa, int64_t &r_exponent);
+	static bool _parse_notation(const char32_t *p_text, int64_t p_length, double &r_mantissa, int64_t &r_exponent);
+	static bool _parse_notation(const char32_t *p_text, int64_t p_length, const FormatOptions &p_options, bool p_plain, double &r_mantissa, int64_t &r_exponent);
 	static void _get_values(const Variant &n, double &r_mantissa, int64_t &r_exponent);
+	static bool _get_big_values(const Ref<BigNumber> &n, double &r_mantissa, int64_t &r_exponent);
+	static void _get_number_values(double n, double &r_mantissa, int64_t &r_exponent);
+	static void _power_values(const Variant &n, double &r_mantissa, int64_t &r_exponent);
+	static bool _apply_option(FormatOptions &r_options, const StringName &p_key, const Variant &p_value);
+	static void _publish_options(const Dictionary &p_options);
+	static void _sync_shared_options();
+
+	static uint32_t _get_notation_flags_mask(Notation p_notation);
+	static bool _quantize_prefix(double p_mantissa, int64_t p_exponent, uint32_t p_flags, const FormatOptions &p_options, int64_t &r_quantized);
+	static bool _quantize_scientific(double p_mantissa, int64_t p_exponent, const FormatOptions &p_options, int64_t &r_quantized);
+	static bool _get_format_key(double p_mantissa, int64_t p_exponent, Notation p_notation, uint32_t p_flags, const FormatOptions &p_options, FormatCache::Key &r_key);
+	static String _format_cached(double p_mantissa, int64_t p_exponent, Notation p_notation, uint32_t p_flags);
+	static String _format(double p_mantissa, int64_t p_exponent, Notation p_notation, uint32_t p_flags);
+	static String _format(double p_mantissa, int64_t p_exponent, Notation p_notation, uint32_t p_flags, const FormatOptions &p_options);
+
+	// Uncached formatter bodies, safe to call from any thread
+	static String _format_scientific(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, bool force_decimals, const FormatOptions &p_options);
+	static String _format_prefix(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals, bool scientific_prefix, const FormatOptions &p_options);
+	static String _format_aa(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals, const FormatOptions &p_options);
+	static String _format_metric_symbol(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, const FormatOptions &p_options);
+	static String _format_metric_name(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, const FormatOptions &p_options);
+	static String _format_short_scale(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, const FormatOptions &p_options);
+	static String _format_long_name(double p_mantissa, int64_t p_exponent, bool no_decimals_on_small_values, bool european_system, const FormatOptions &p_options);
 
 	double mantissa = 1.0;
 	int64_t exponent = 0;
 };
+
+VARIANT_ENUM_CAST(BigNumber::Notation);
+VARIANT_BITFIELD_CAST(BigNumber::FormatFlags);
@@ -0,0 +1,111 @@
+#include "big_number_accumulator.hpp"
+#include "core/big_number_core.hpp"
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+
+using namespace godot;
+
+BigNumberAccumulator::BigNumberAccumulator() {
+}
+
+BigNumberAccumulator::~BigNumberAccumulator() {
+}
+
+void BigNumberAccumulator::add(const Variant &p_value) {
+	double m;
+	int64_t e;
+	BigNumber::_get_values(p_value, m, e);
+	sum.add(m, e);
+}
+
+void BigNumberAccumulator::add_big(const Ref<BigNumber> &p_value) {
+	double m;
+	int64_t e;
+	if (!BigNumber::_get_big_values(p_value, m, e)) {
+		return;
+	}
+	sum.add(m, e);
+}
+
+void BigNumberAccumulator::add_int(int64_t p_value) {
+	double m;
+	int64_t e;
+	BigNumber::_get_number_values((double)p_value, m, e);
+	sum.add(m, e);
+}
+
+void BigNumberAccumulator::add_float(double p_value) {
+	double m;
+	int64_t e;
+	BigNumber::_get_number_values(p_value, m, e);
+	sum.add(m, e);
+}
+
+void BigNumberAccumulator::add_array(const Ref<BigNumberArray> &p_values) {
+	ERR_FAIL_COND_MSG(p_values.is_null(), "BigNumberAccumulator Error: Argument is null.");
+
+	PackedFloat64Array mantissas = p_values->get_mantissas();
+	PackedInt64Array exponents = p_values->get_exponents();
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	int64_t count = mantissas.size();
+	for (int64_t i = 0; i < count; i++) {
+		sum.add(m[i], e[i]);
+	}
+}
+
+Ref<BigNumber> BigNumberAccumulator::get_total() const {
+	Ref<BigNumber> res = memnew(BigNumber);
+	sum.get_total(res->mantissa, res->exponent);
+	BigNumberCore::normalize(res->mantissa, res->exponent);
+	return res;
+}
+
+Ref<BigNumber> BigNumberAccumulator::flush() {
+	Ref<BigNumber> res = get_total();
+	sum.clear();
+	return res;
+}
+
+Ref<BigNumber> BigNumberAccumulator::flush_into(const Ref<BigNumber> &r_target) {
+	ERR_FAIL_COND_V_MSG(r_target.is_null(), r_target, "BigNumberAccumulator Error: Argument is null.");
+
+	if (!sum.is_empty()) {
+		double m;
+		int64_t e;
+		sum.get_total(m, e);
+		BigNumberCore::normalize(m, e);
+		BigNumberCore::add(r_target->mantissa, r_target->exponent, m, e);
+	}
+	sum.clear();
+	return r_target;
+}
+
+void BigNumberAccumulator::clear() {
+	sum.clear();
+}
+
+bool BigNumberAccumulator::is_empty() const {
+	return sum.is_empty();
+}
+
+int64_t BigNumberAccumulator::get_count() const {
+	return sum.get_count();
+}
+
+void BigNumberAccumulator::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("add", "value"), &BigNumberAccumulator::add);
+	ClassDB::bind_method(D_METHOD("add_big", "value"), &BigNumberAccumulator::add_big);
+	ClassDB::bind_method(D_METHOD("add_int", "value"), &BigNumberAccumulator::add_int);
+	ClassDB::bind_method(D_METHOD("add_float", "value"), &BigNumberAccumulator::add_float);
+	ClassDB::bind_method(D_METHOD("add_array", "values"), &BigNumberAccumulator::add_array);
+
+	ClassDB::bind_method(D_METHOD("get_total"), &BigNumberAccumulator::get_total);
+	ClassDB::bind_method(D_METHOD("flush"), &BigNumberAccumulator::flush);
+	ClassDB::bind_method(D_METHOD("flush_into", "target"), &BigNumberAccumulator::flush_into);
+
+	ClassDB::bind_method(D_METHOD("clear"), &BigNumberAccumulator::clear);
+	ClassDB::bind_method(D_METHOD("is_empty"), &BigNumberAccumulator::is_empty);
+	ClassDB::bind_method(D_METHOD("get_count"), &BigNumberAccumulator::get_count);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "big_number.hpp"
+#include "big_number_array.hpp"
+#include "core/compensated_sum.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+
+using namespace godot;
+
+// Sums many values, typically per-tick incomes, without the precision loss
+// of repeated plus_equals(). The total is only rounded once, by flush().
+class BigNumberAccumulator : public RefCounted {
+	GDCLASS(BigNumberAccumulator, RefCounted)
+
+public:
+	BigNumberAccumulator();
+	~BigNumberAccumulator();
+
+	// Return nothing, unlike plus_equals(), so a call costs no reference
+	// counting
+	void add(const Variant &p_value);
+	void add_big(const Ref<BigNumber> &p_value);
+	void add_int(int64_t p_value);
+	void add_float(double p_value);
+	void add_array(const Ref<BigNumberArray> &p_values);
+
+	Ref<BigNumber> get_total() const;
+	// get_total(), then clear()
+	Ref<BigNumber> flush();
+	// Adds the total to r_target with plus_equals(), then clear()
+	Ref<BigNumber> flush_into(const Ref<BigNumber> &r_target);
+
+	void clear();
+	bool is_empty() const;
+	int64_t get_count() const;
+
+protected:
+	static void _bind_methods();
+
+private:
+	CompensatedSum::Accumulator sum;
+};
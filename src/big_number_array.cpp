@@ -0,0 +1,828 @@
+#include "big_number_array.hpp"
+#include "core/batch.hpp"
+#include "core/big_number_core.hpp"
+#include "core/binary_codec.hpp"
+#include "core/bulk_buy.hpp"
+#include "core/compensated_sum.hpp"
+#include "core/instrumentation.hpp"
+#include "core/reduction.hpp"
+#include "core/sort_key.hpp"
+#include "parallel.hpp"
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/math.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace godot;
+
+BigNumberArray::BigNumberArray() {
+}
+
+BigNumberArray::~BigNumberArray() {
+}
+
+void BigNumberArray::resize(int64_t p_size) {
+	ERR_FAIL_COND_MSG(p_size < 0, "BigNumberArray Error: Size cannot be negative.");
+
+	int64_t old_size = mantissas.size();
+	mantissas.resize(p_size);
+	exponents.resize(p_size);
+
+	// New elements start at the same default as BigNumber.new()
+	double *m = mantissas.ptrw();
+	int64_t *e = exponents.ptrw();
+	for (int64_t i = old_size; i < p_size; i++) {
+		m[i] = 1.0;
+		e[i] = 0;
+	}
+}
+
+int64_t BigNumberArray::size() const {
+	return mantissas.size();
+}
+
+bool BigNumberArray::is_empty() const {
+	return mantissas.is_empty();
+}
+
+void BigNumberArray::clear() {
+	mantissas.clear();
+	exponents.clear();
+}
+
+void BigNumberArray::set_value(int64_t p_index, const Variant &p_value) {
+	ERR_FAIL_INDEX(p_index, mantissas.size());
+
+	double m;
+	int64_t e;
+	BigNumber::_get_values(p_value, m, e);
+	mantissas.set(p_index, m);
+	exponents.set(p_index, e);
+}
+
+Ref<BigNumber> BigNumberArray::get_value(int64_t p_index) const {
+	ERR_FAIL_INDEX_V(p_index, mantissas.size(), Ref<BigNumber>());
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	res->mantissa = mantissas[p_index];
+	res->exponent = exponents[p_index];
+	return res;
+}
+
+void BigNumberArray::set_mantissas(const PackedFloat64Array &p_mantissas) {
+	mantissas = p_mantissas;
+	if (exponents.size() != mantissas.size()) {
+		int64_t old_size = exponents.size();
+		exponents.resize(mantissas.size());
+		int64_t *e = exponents.ptrw();
+		for (int64_t i = old_size; i < exponents.size(); i++) {
+			e[i] = 0;
+		}
+	}
+}
+
+PackedFloat64Array BigNumberArray::get_mantissas() const {
+	return mantissas;
+}
+
+void BigNumberArray::set_exponents(const PackedInt64Array &p_exponents) {
+	exponents = p_exponents;
+	if (mantissas.size() != exponents.size()) {
+		int64_t old_size = mantissas.size();
+		mantissas.resize(exponents.size());
+		double *m = mantissas.ptrw();
+		for (int64_t i = old_size; i < mantissas.size(); i++) {
+			m[i] = 1.0;
+		}
+	}
+}
+
+PackedInt64Array BigNumberArray::get_exponents() const {
+	return exponents;
+}
+
+void BigNumberArray::set_from_parts(const PackedFloat64Array &p_mantissas, const PackedInt64Array &p_exponents) {
+	ERR_FAIL_COND_MSG(p_mantissas.size() != p_exponents.size(), "BigNumberArray Error: Mantissa and exponent arrays must have the same size.");
+
+	mantissas = p_mantissas;
+	exponents = p_exponents;
+	normalize();
+}
+
+void BigNumberArray::set_from_floats(const PackedFloat64Array &p_values) {
+	mantissas = p_values;
+	exponents.resize(p_values.size());
+
+	int64_t count = mantissas.size();
+	double *m = mantissas.ptrw();
+	int64_t *e = exponents.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		e[i] = 0;
+	}
+	BigNumberBatch::normalize(m, e, count);
+}
+
+void BigNumberArray::set_from_ints(const PackedInt64Array &p_values) {
+	int64_t count = p_values.size();
+	mantissas.resize(count);
+	exponents.resize(count);
+
+	const int64_t *v = p_values.ptr();
+	double *m = mantissas.ptrw();
+	int64_t *e = exponents.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		m[i] = (double)v[i];
+		e[i] = 0;
+	}
+	BigNumberBatch::normalize(m, e, count);
+}
+
+void BigNumberArray::set_from_strings(const PackedStringArray &p_values) {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	int64_t count = p_values.size();
+	mantissas.resize(count);
+	exponents.resize(count);
+
+	const String *values = p_values.ptr();
+	double *m = mantissas.ptrw();
+	int64_t *e = exponents.ptrw();
+	std::atomic<int64_t> failed(0);
+	Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+		int64_t chunk_failed = 0;
+		for (int64_t i = p_begin; i < p_end; i++) {
+			if (!BigNumber::_parse_notation(values[i].ptr(), values[i].length(), m[i], e[i])) {
+				m[i] = 0.0;
+				e[i] = 0;
+				chunk_failed++;
+			}
+		}
+		if (chunk_failed > 0) {
+			failed.fetch_add(chunk_failed, std::memory_order_relaxed);
+		}
+	});
+
+	if (failed.load() > 0) {
+		ERR_PRINT("BigNumberArray Error: " + String::num_int64(failed.load()) + " strings could not be parsed and were set to 0.");
+	}
+}
+
+void BigNumberArray::set_from_values(const Array &p_values) {
+	int64_t count = p_values.size();
+	mantissas.resize(count);
+	exponents.resize(count);
+
+	double *m = mantissas.ptrw();
+	int64_t *e = exponents.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		BigNumber::_get_values(p_values[i], m[i], e[i]);
+	}
+}
+
+PackedFloat64Array BigNumberArray::to_floats() const {
+	PackedFloat64Array res;
+	int64_t count = mantissas.size();
+	res.resize(count);
+
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	double *r = res.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		r[i] = BigNumberCore::to_float(m[i], e[i]);
+	}
+	return res;
+}
+
+PackedInt64Array BigNumberArray::to_sort_keys() const {
+	PackedInt64Array res;
+	int64_t count = mantissas.size();
+	res.resize(count);
+
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	int64_t *r = res.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		r[i] = SortKey::encode(m[i], e[i]);
+	}
+	return res;
+}
+
+void BigNumberArray::set_from_sort_keys(const PackedInt64Array &p_keys) {
+	int64_t count = p_keys.size();
+	mantissas.resize(count);
+	exponents.resize(count);
+
+	const int64_t *k = p_keys.ptr();
+	double *m = mantissas.ptrw();
+	int64_t *e = exponents.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		SortKey::decode(k[i], m[i], e[i]);
+	}
+}
+
+void BigNumberArray::normalize() {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	int64_t count = mantissas.size();
+	double *m = mantissas.ptrw();
+	int64_t *e = exponents.ptrw();
+	Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+		BigNumberBatch::normalize(m + p_begin, e + p_begin, p_end - p_begin);
+	});
+}
+
+void BigNumberArray::_apply(Operation p_op, const Variant &n) {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	int64_t count = mantissas.size();
+	double *m = mantissas.ptrw();
+	int64_t *e = exponents.ptrw();
+	std::atomic<bool> divided_by_zero(false);
+
+	Ref<BigNumberArray> other_array;
+	if (n.get_type() == Variant::OBJECT) {
+		other_array = n;
+	}
+
+	if (other_array.is_valid()) {
+		ERR_FAIL_COND_MSG(other_array->size() != count, "BigNumberArray Error: Element-wise operation requires arrays of the same size.");
+
+		const double *om = other_array->mantissas.ptr();
+		const int64_t *oe = other_array->exponents.ptr();
+		Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+			double *chunk_m = m + p_begin;
+			int64_t *chunk_e = e + p_begin;
+			int64_t chunk_count = p_end - p_begin;
+			BigNumberBatch::Operand other = BigNumberBatch::Operand::array(om + p_begin, oe + p_begin);
+			switch (p_op) {
+				case OP_PLUS:
+					BigNumberBatch::add(chunk_m, chunk_e, other, chunk_count);
+					break;
+				case OP_MINUS:
+					BigNumberBatch::subtract(chunk_m, chunk_e, other, chunk_count);
+					break;
+				case OP_MULTIPLY:
+					BigNumberBatch::multiply(chunk_m, chunk_e, other, chunk_count);
+					break;
+				case OP_DIVIDE:
+					if (!BigNumberBatch::divide(chunk_m, chunk_e, other, chunk_count)) {
+						divided_by_zero.store(true, std::memory_order_relaxed);
+					}
+					break;
+				case OP_POWER:
+					for (int64_t i = p_begin; i < p_end; i++) {
+						// Same as BigNumber::power_equals() with a BigNumber argument
+						BigNumberCore::power_float(m[i], e[i], BigNumberCore::to_float(om[i], oe[i]));
+					}
+					break;
+			}
+		});
+	} else if (p_op == OP_POWER) {
+		if (n.get_type() == Variant::INT) {
+			int64_t p = n;
+			Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+				for (int64_t i = p_begin; i < p_end; i++) {
+					BigNumberCore::power_int(m[i], e[i], p);
+				}
+			});
+		} else if (n.get_type() == Variant::FLOAT || n.get_type() == Variant::OBJECT) {
+			double p;
+			if (n.get_type() == Variant::FLOAT) {
+				p = n;
+			} else {
+				Ref<BigNumber> other = n;
+				if (other.is_null()) {
+					return;
+				}
+				p = other->to_float();
+			}
+			Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+				for (int64_t i = p_begin; i < p_end; i++) {
+					BigNumberCore::power_float(m[i], e[i], p);
+				}
+			});
+		}
+	} else {
+		double om;
+		int64_t oe;
+		BigNumber::_get_values(n, om, oe);
+		BigNumberBatch::Operand other = BigNumberBatch::Operand::broadcast(om, oe);
+		Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+			switch (p_op) {
+				case OP_PLUS:
+					BigNumberBatch::add(m + p_begin, e + p_begin, other, p_end - p_begin);
+					break;
+				case OP_MINUS:
+					BigNumberBatch::subtract(m + p_begin, e + p_begin, other, p_end - p_begin);
+					break;
+				case OP_MULTIPLY:
+					BigNumberBatch::multiply(m + p_begin, e + p_begin, other, p_end - p_begin);
+					break;
+				case OP_DIVIDE:
+					if (!BigNumberBatch::divide(m + p_begin, e + p_begin, other, p_end - p_begin)) {
+						divided_by_zero.store(true, std::memory_order_relaxed);
+					}
+					break;
+				case OP_POWER:
+					break;
+			}
+		});
+	}
+
+	if (divided_by_zero.load()) {
+		ERR_PRINT("BigNumberArray Error: Divide by zero");
+	}
+}
+
+Ref<BigNumberArray> BigNumberArray::plus_equals(const Variant &n) {
+	_apply(OP_PLUS, n);
+	return Ref<BigNumberArray>(this);
+}
+
+Ref<BigNumberArray> BigNumberArray::minus_equals(const Variant &n) {
+	_apply(OP_MINUS, n);
+	return Ref<BigNumberArray>(this);
+}
+
+Ref<BigNumberArray> BigNumberArray::multiply_equals(const Variant &n) {
+	_apply(OP_MULTIPLY, n);
+	return Ref<BigNumberArray>(this);
+}
+
+Ref<BigNumberArray> BigNumberArray::divide_equals(const Variant &n) {
+	_apply(OP_DIVIDE, n);
+	return Ref<BigNumberArray>(this);
+}
+
+Ref<BigNumberArray> BigNumberArray::power_equals(const Variant &n) {
+	_apply(OP_POWER, n);
+	return Ref<BigNumberArray>(this);
+}
+
+PackedInt32Array BigNumberArray::compare(const Variant &n) const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	PackedInt32Array res;
+	int64_t count = mantissas.size();
+	res.resize(count);
+
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	int32_t *r = res.ptrw();
+
+	Ref<BigNumberArray> other_array;
+	if (n.get_type() == Variant::OBJECT) {
+		other_array = n;
+	}
+
+	if (other_array.is_valid()) {
+		ERR_FAIL_COND_V_MSG(other_array->size() != count, PackedInt32Array(), "BigNumberArray Error: Element-wise comparison requires arrays of the same size.");
+
+		const double *om = other_array->mantissas.ptr();
+		const int64_t *oe = other_array->exponents.ptr();
+		Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+			BigNumberBatch::compare(m + p_begin, e + p_begin, BigNumberBatch::Operand::array(om + p_begin, oe + p_begin), r + p_begin, p_end - p_begin);
+		});
+	} else {
+		double om;
+		int64_t oe;
+		BigNumber::_get_values(n, om, oe);
+		Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+			BigNumberBatch::compare(m + p_begin, e + p_begin, BigNumberBatch::Operand::broadcast(om, oe), r + p_begin, p_end - p_begin);
+		});
+	}
+	return res;
+}
+
+PackedStringArray BigNumberArray::format(BigNumber::Notation p_notation, BitField<BigNumber::FormatFlags> p_flags) const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	PackedStringArray res;
+	int64_t count = mantissas.size();
+	res.resize(count);
+
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	String *r = res.ptrw();
+	uint32_t flags = (uint32_t)(int64_t)p_flags & BigNumber::_get_notation_flags_mask(p_notation);
+
+	int64_t threshold = Parallel::get_threshold();
+	if (threshold <= 0 || count < threshold) {
+		for (int64_t i = 0; i < count; i++) {
+			r[i] = BigNumber::_format_cached(m[i], e[i], p_notation, flags);
+		}
+		return res;
+	}
+
+	// The workers format directly instead of contending for the format
+	// cache, all with the options snapshot of this thread. Held by value:
+	// this thread's cached snapshot can change while they run.
+	std::shared_ptr<const BigNumber::FormatOptions> options = BigNumber::get_format_options_snapshot();
+	Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+		for (int64_t i = p_begin; i < p_end; i++) {
+			BIG_NUMBER_PROFILE(GROUP_FORMAT);
+			r[i] = BigNumber::_format(m[i], e[i], p_notation, flags, *options);
+		}
+	});
+	return res;
+}
+
+Ref<BigNumber> BigNumberArray::sum() const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	// Compensated, so small elements are not lost next to large ones
+	CompensatedSum::Accumulator accumulator;
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	int64_t count = mantissas.size();
+	for (int64_t i = 0; i < count; i++) {
+		accumulator.add(m[i], e[i]);
+	}
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	accumulator.get_total(res->mantissa, res->exponent);
+	BigNumberCore::normalize(res->mantissa, res->exponent);
+	return res;
+}
+
+Ref<BigNumber> BigNumberArray::product() const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	Ref<BigNumber> res = memnew(BigNumber);
+	Reduction::product(mantissas.ptr(), exponents.ptr(), mantissas.size(), res->mantissa, res->exponent);
+	return res;
+}
+
+Ref<BigNumber> BigNumberArray::mean() const {
+	int64_t count = mantissas.size();
+	ERR_FAIL_COND_V_MSG(count == 0, Ref<BigNumber>(), "BigNumberArray Error: Array is empty.");
+
+	Ref<BigNumber> res = sum();
+	double count_m = (double)count;
+	int64_t count_e = 0;
+	BigNumberCore::normalize(count_m, count_e);
+	BigNumberCore::divide(res->mantissa, res->exponent, count_m, count_e);
+	return res;
+}
+
+double BigNumberArray::log_sum_exp() const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	return Reduction::log_sum(mantissas.ptr(), exponents.ptr(), mantissas.size());
+}
+
+Ref<BigNumber> BigNumberArray::min() const {
+	int64_t index = argmin();
+	ERR_FAIL_COND_V_MSG(index < 0, Ref<BigNumber>(), "BigNumberArray Error: Array is empty.");
+	return get_value(index);
+}
+
+Ref<BigNumber> BigNumberArray::max() const {
+	int64_t index = argmax();
+	ERR_FAIL_COND_V_MSG(index < 0, Ref<BigNumber>(), "BigNumberArray Error: Array is empty.");
+	return get_value(index);
+}
+
+int64_t BigNumberArray::argmin() const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	return Reduction::extreme_index(mantissas.ptr(), exponents.ptr(), mantissas.size(), false);
+}
+
+int64_t BigNumberArray::argmax() const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	return Reduction::extreme_index(mantissas.ptr(), exponents.ptr(), mantissas.size(), true);
+}
+
+void BigNumberArray::sort(bool p_descending) {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	PackedInt64Array order = argsort(p_descending);
+	const int64_t *o = order.ptr();
+	int64_t count = order.size();
+
+	PackedFloat64Array sorted_mantissas;
+	PackedInt64Array sorted_exponents;
+	sorted_mantissas.resize(count);
+	sorted_exponents.resize(count);
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	double *sm = sorted_mantissas.ptrw();
+	int64_t *se = sorted_exponents.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		sm[i] = m[o[i]];
+		se[i] = e[o[i]];
+	}
+	mantissas = sorted_mantissas;
+	exponents = sorted_exponents;
+}
+
+PackedInt64Array BigNumberArray::argsort(bool p_descending) const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	PackedInt64Array res;
+	int64_t count = mantissas.size();
+	res.resize(count);
+	int64_t *r = res.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		r[i] = i;
+	}
+
+	std::stable_sort(r, r + count, Reduction::IndexLess{ mantissas.ptr(), exponents.ptr(), p_descending });
+	return res;
+}
+
+PackedInt64Array BigNumberArray::top_k(int64_t p_count, bool p_largest) const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	ERR_FAIL_COND_V_MSG(p_count < 0, PackedInt64Array(), "BigNumberArray Error: Count cannot be negative.");
+
+	int64_t count = mantissas.size();
+	int64_t k = p_count < count ? p_count : count;
+	PackedInt64Array indices;
+	indices.resize(count);
+	int64_t *r = indices.ptrw();
+	for (int64_t i = 0; i < count; i++) {
+		r[i] = i;
+	}
+
+	// Only the first k end up sorted, the rest is left in any order
+	std::partial_sort(r, r + k, r + count, Reduction::IndexLess{ mantissas.ptr(), exponents.ptr(), p_largest });
+	indices.resize(k);
+	return indices;
+}
+
+void BigNumberArray::sort_values(const Array &p_values, bool p_descending) {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	Ref<BigNumberArray> keys;
+	keys.instantiate();
+	keys->set_from_values(p_values);
+	PackedInt64Array order = keys->argsort(p_descending);
+
+	Array sorted = p_values.duplicate();
+	Array values = p_values;
+	const int64_t *o = order.ptr();
+	for (int64_t i = 0; i < order.size(); i++) {
+		values[i] = sorted[o[i]];
+	}
+}
+
+bool BigNumberArray::_get_budget(const Variant &p_budget, const double *&r_mantissas, const int64_t *&r_exponents, int64_t &r_step, double &r_mantissa, int64_t &r_exponent) const {
+	Ref<BigNumberArray> budget_array;
+	if (p_budget.get_type() == Variant::OBJECT) {
+		budget_array = p_budget;
+	}
+
+	if (budget_array.is_valid()) {
+		ERR_FAIL_COND_V_MSG(budget_array->size() != mantissas.size(), false, "BigNumberArray Error: Element-wise operation requires arrays of the same size.");
+		r_mantissas = budget_array->mantissas.ptr();
+		r_exponents = budget_array->exponents.ptr();
+		r_step = 1;
+		return true;
+	}
+
+	BigNumber::_get_values(p_budget, r_mantissa, r_exponent);
+	r_mantissas = &r_mantissa;
+	r_exponents = &r_exponent;
+	r_step = 0;
+	return true;
+}
+
+Ref<BigNumberArray> BigNumberArray::cost_of_n(const PackedFloat64Array &p_growths, const PackedInt64Array &p_owned, const PackedInt64Array &p_counts) const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	int64_t count = mantissas.size();
+	ERR_FAIL_COND_V_MSG(p_growths.size() != count || p_owned.size() != count || p_counts.size() != count, Ref<BigNumberArray>(), "BigNumberArray Error: Element-wise operation requires arrays of the same size.");
+
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	const double *growths = p_growths.ptr();
+	const int64_t *owned = p_owned.ptr();
+	const int64_t *counts = p_counts.ptr();
+	for (int64_t i = 0; i < count; i++) {
+		ERR_FAIL_COND_V_MSG(!(growths[i] > 0.0), Ref<BigNumberArray>(), "BigNumberArray Error: Growth must be positive.");
+		ERR_FAIL_COND_V_MSG(owned[i] < 0 || counts[i] < 0, Ref<BigNumberArray>(), "BigNumberArray Error: Level counts cannot be negative.");
+	}
+
+	Ref<BigNumberArray> res;
+	res.instantiate();
+	res->resize(count);
+	double *rm = res->mantissas.ptrw();
+	int64_t *re = res->exponents.ptrw();
+	Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+		for (int64_t i = p_begin; i < p_end; i++) {
+			BulkBuy::geometric_cost(m[i], e[i], growths[i], owned[i], counts[i], rm[i], re[i]);
+		}
+	});
+	return res;
+}
+
+PackedInt64Array BigNumberArray::max_affordable(const PackedFloat64Array &p_growths, const PackedInt64Array &p_owned, const Variant &p_budget) const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	int64_t count = mantissas.size();
+	ERR_FAIL_COND_V_MSG(p_growths.size() != count || p_owned.size() != count, PackedInt64Array(), "BigNumberArray Error: Element-wise operation requires arrays of the same size.");
+
+	const double *budget_m;
+	const int64_t *budget_e;
+	int64_t budget_step;
+	double budget_value_m;
+	int64_t budget_value_e;
+	if (!_get_budget(p_budget, budget_m, budget_e, budget_step, budget_value_m, budget_value_e)) {
+		return PackedInt64Array();
+	}
+
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	const double *growths = p_growths.ptr();
+	const int64_t *owned = p_owned.ptr();
+	for (int64_t i = 0; i < count; i++) {
+		ERR_FAIL_COND_V_MSG(!(growths[i] > 0.0), PackedInt64Array(), "BigNumberArray Error: Growth must be positive.");
+		ERR_FAIL_COND_V_MSG(owned[i] < 0, PackedInt64Array(), "BigNumberArray Error: Level counts cannot be negative.");
+	}
+
+	PackedInt64Array res;
+	res.resize(count);
+	int64_t *r = res.ptrw();
+	Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+		for (int64_t i = p_begin; i < p_end; i++) {
+			int64_t b = i * budget_step;
+			r[i] = BulkBuy::geometric_max(m[i], e[i], growths[i], owned[i], budget_m[b], budget_e[b]);
+		}
+	});
+	return res;
+}
+
+Ref<BigNumberArray> BigNumberArray::cost_of_n_linear(const Ref<BigNumberArray> &p_increments, const PackedInt64Array &p_owned, const PackedInt64Array &p_counts) const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	ERR_FAIL_COND_V_MSG(p_increments.is_null(), Ref<BigNumberArray>(), "BigNumberArray Error: Argument is null.");
+	int64_t count = mantissas.size();
+	ERR_FAIL_COND_V_MSG(p_increments->size() != count || p_owned.size() != count || p_counts.size() != count, Ref<BigNumberArray>(), "BigNumberArray Error: Element-wise operation requires arrays of the same size.");
+
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	const double *im = p_increments->mantissas.ptr();
+	const int64_t *ie = p_increments->exponents.ptr();
+	const int64_t *owned = p_owned.ptr();
+	const int64_t *counts = p_counts.ptr();
+	for (int64_t i = 0; i < count; i++) {
+		ERR_FAIL_COND_V_MSG(owned[i] < 0 || counts[i] < 0, Ref<BigNumberArray>(), "BigNumberArray Error: Level counts cannot be negative.");
+	}
+
+	Ref<BigNumberArray> res;
+	res.instantiate();
+	res->resize(count);
+	double *rm = res->mantissas.ptrw();
+	int64_t *re = res->exponents.ptrw();
+	Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+		for (int64_t i = p_begin; i < p_end; i++) {
+			BulkBuy::linear_cost(m[i], e[i], im[i], ie[i], owned[i], counts[i], rm[i], re[i]);
+		}
+	});
+	return res;
+}
+
+PackedInt64Array BigNumberArray::max_affordable_linear(const Ref<BigNumberArray> &p_increments, const PackedInt64Array &p_owned, const Variant &p_budget) const {
+	BIG_NUMBER_PROFILE(GROUP_ARRAY);
+	ERR_FAIL_COND_V_MSG(p_increments.is_null(), PackedInt64Array(), "BigNumberArray Error: Argument is null.");
+	int64_t count = mantissas.size();
+	ERR_FAIL_COND_V_MSG(p_increments->size() != count || p_owned.size() != count, PackedInt64Array(), "BigNumberArray Error: Element-wise operation requires arrays of the same size.");
+
+	const double *budget_m;
+	const int64_t *budget_e;
+	int64_t budget_step;
+	double budget_value_m;
+	int64_t budget_value_e;
+	if (!_get_budget(p_budget, budget_m, budget_e, budget_step, budget_value_m, budget_value_e)) {
+		return PackedInt64Array();
+	}
+
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	const double *im = p_increments->mantissas.ptr();
+	const int64_t *ie = p_increments->exponents.ptr();
+	const int64_t *owned = p_owned.ptr();
+	for (int64_t i = 0; i < count; i++) {
+		ERR_FAIL_COND_V_MSG(owned[i] < 0, PackedInt64Array(), "BigNumberArray Error: Level counts cannot be negative.");
+	}
+
+	PackedInt64Array res;
+	res.resize(count);
+	int64_t *r = res.ptrw();
+	Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+		for (int64_t i = p_begin; i < p_end; i++) {
+			int64_t b = i * budget_step;
+			r[i] = BulkBuy::linear_max(m[i], e[i], im[i], ie[i], owned[i], budget_m[b], budget_e[b]);
+		}
+	});
+	return res;
+}
+
+void BigNumberArray::set_parallel_threshold(int64_t p_threshold) {
+	ERR_FAIL_COND_MSG(p_threshold < 0, "BigNumberArray Error: Parallel threshold cannot be negative.");
+	Parallel::set_threshold(p_threshold);
+}
+
+int64_t BigNumberArray::get_parallel_threshold() {
+	return Parallel::get_threshold();
+}
+
+Ref<BigNumberArray> BigNumberArray::duplicate() const {
+	Ref<BigNumberArray> res = memnew(BigNumberArray);
+	res->mantissas = mantissas;
+	res->exponents = exponents;
+	return res;
+}
+
+PackedByteArray BigNumberArray::to_bytes() const {
+	int64_t count = mantissas.size();
+	PackedByteArray res;
+	res.resize(BigNumberCodec::HEADER_SIZE + BigNumberCodec::MAX_VARINT_SIZE + count * BigNumberCodec::MAX_VALUE_SIZE);
+
+	const double *m = mantissas.ptr();
+	const int64_t *e = exponents.ptr();
+	uint8_t *data = res.ptrw();
+	int64_t length = BigNumberCodec::write_header(data, BigNumberCodec::KIND_ARRAY);
+	length += BigNumberCodec::write_varint(data + length, (uint64_t)count);
+	for (int64_t i = 0; i < count; i++) {
+		length += BigNumberCodec::write_value(data + length, m[i], e[i]);
+	}
+
+	res.resize(length);
+	return res;
+}
+
+Ref<BigNumberArray> BigNumberArray::from_bytes(const PackedByteArray &p_bytes) {
+	const uint8_t *data = p_bytes.ptr();
+	int64_t size = p_bytes.size();
+	BigNumberCodec::HeaderError header = BigNumberCodec::read_header(data, size, BigNumberCodec::KIND_ARRAY);
+	ERR_FAIL_COND_V_MSG(header != BigNumberCodec::HEADER_OK, Ref<BigNumberArray>(), String("BigNumberArray Error: ") + BigNumberCodec::get_header_error_text(header));
+
+	int64_t offset = BigNumberCodec::HEADER_SIZE;
+	uint64_t count;
+	int length = BigNumberCodec::read_varint(data + offset, size - offset, count);
+	offset += length;
+	// Checked against the data size first, a corrupted count must not allocate
+	ERR_FAIL_COND_V_MSG(length == 0 || count > (uint64_t)(size - offset) / BigNumberCodec::MIN_VALUE_SIZE, Ref<BigNumberArray>(), "BigNumberArray Error: Byte data is truncated.");
+
+	Ref<BigNumberArray> res = memnew(BigNumberArray);
+	res->mantissas.resize((int64_t)count);
+	res->exponents.resize((int64_t)count);
+	double *m = res->mantissas.ptrw();
+	int64_t *e = res->exponents.ptrw();
+	for (int64_t i = 0; i < (int64_t)count; i++) {
+		length = BigNumberCodec::read_value(data + offset, size - offset, m[i], e[i]);
+		ERR_FAIL_COND_V_MSG(length == 0, Ref<BigNumberArray>(), "BigNumberArray Error: Byte data is truncated.");
+		offset += length;
+	}
+	ERR_FAIL_COND_V_MSG(offset != size, Ref<BigNumberArray>(), "BigNumberArray Error: Byte data continues past the encoded values.");
+	return res;
+}
+
+void BigNumberArray::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("resize", "size"), &BigNumberArray::resize);
+	ClassDB::bind_method(D_METHOD("size"), &BigNumberArray::size);
+	ClassDB::bind_method(D_METHOD("is_empty"), &BigNumberArray::is_empty);
+	ClassDB::bind_method(D_METHOD("clear"), &BigNumberArray::clear);
+	ClassDB::bind_method(D_METHOD("duplicate"), &BigNumberArray::duplicate);
+	ClassDB::bind_method(D_METHOD("to_bytes"), &BigNumberArray::to_bytes);
+	ClassDB::bind_static_method("BigNumberArray", D_METHOD("from_bytes", "bytes"), &BigNumberArray::from_bytes);
+
+	ClassDB::bind_method(D_METHOD("set_value", "index", "value"), &BigNumberArray::set_value);
+	ClassDB::bind_method(D_METHOD("get_value", "index"), &BigNumberArray::get_value);
+
+	ClassDB::bind_method(D_METHOD("set_mantissas", "mantissas"), &BigNumberArray::set_mantissas);
+	ClassDB::bind_method(D_METHOD("get_mantissas"), &BigNumberArray::get_mantissas);
+	ClassDB::bind_method(D_METHOD("set_exponents", "exponents"), &BigNumberArray::set_exponents);
+	ClassDB::bind_method(D_METHOD("get_exponents"), &BigNumberArray::get_exponents);
+
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT64_ARRAY, "mantissas"), "set_mantissas", "get_mantissas");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_INT64_ARRAY, "exponents"), "set_exponents", "get_exponents");
+
+	ClassDB::bind_method(D_METHOD("set_from_parts", "mantissas", "exponents"), &BigNumberArray::set_from_parts);
+	ClassDB::bind_method(D_METHOD("set_from_floats", "values"), &BigNumberArray::set_from_floats);
+	ClassDB::bind_method(D_METHOD("set_from_ints", "values"), &BigNumberArray::set_from_ints);
+	ClassDB::bind_method(D_METHOD("set_from_strings", "values"), &BigNumberArray::set_from_strings);
+	ClassDB::bind_method(D_METHOD("set_from_values", "values"), &BigNumberArray::set_from_values);
+	ClassDB::bind_method(D_METHOD("to_floats"), &BigNumberArray::to_floats);
+	ClassDB::bind_method(D_METHOD("to_sort_keys"), &BigNumberArray::to_sort_keys);
+	ClassDB::bind_method(D_METHOD("set_from_sort_keys", "keys"), &BigNumberArray::set_from_sort_keys);
+	ClassDB::bind_method(D_METHOD("normalize"), &BigNumberArray::normalize);
+
+	ClassDB::bind_method(D_METHOD("plus_equals", "n"), &BigNumberArray::plus_equals);
+	ClassDB::bind_method(D_METHOD("minus_equals", "n"), &BigNumberArray::minus_equals);
+	ClassDB::bind_method(D_METHOD("multiply_equals", "n"), &BigNumberArray::multiply_equals);
+	ClassDB::bind_method(D_METHOD("divide_equals", "n"), &BigNumberArray::divide_equals);
+	ClassDB::bind_method(D_METHOD("power_equals", "n"), &BigNumberArray::power_equals);
+	ClassDB::bind_method(D_METHOD("compare", "n"), &BigNumberArray::compare);
+	ClassDB::bind_method(D_METHOD("format", "notation", "flags"), &BigNumberArray::format, DEFVAL(0));
+
+	ClassDB::bind_method(D_METHOD("sum"), &BigNumberArray::sum);
+	ClassDB::bind_method(D_METHOD("product"), &BigNumberArray::product);
+	ClassDB::bind_method(D_METHOD("mean"), &BigNumberArray::mean);
+	ClassDB::bind_method(D_METHOD("log_sum_exp"), &BigNumberArray::log_sum_exp);
+	ClassDB::bind_method(D_METHOD("min"), &BigNumberArray::min);
+	ClassDB::bind_method(D_METHOD("max"), &BigNumberArray::max);
+	ClassDB::bind_method(D_METHOD("argmin"), &BigNumberArray::argmin);
+	ClassDB::bind_method(D_METHOD("argmax"), &BigNumberArray::argmax);
+
+	ClassDB::bind_method(D_METHOD("sort", "descending"), &BigNumberArray::sort, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("argsort", "descending"), &BigNumberArray::argsort, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("top_k", "count", "largest"), &BigNumberArray::top_k, DEFVAL(true));
+	ClassDB::bind_static_method("BigNumberArray", D_METHOD("sort_values", "values", "descending"), &BigNumberArray::sort_values, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("cost_of_n", "growths", "owned", "counts"), &BigNumberArray::cost_of_n);
+	ClassDB::bind_method(D_METHOD("max_affordable", "growths", "owned", "budget"), &BigNumberArray::max_affordable);
+	ClassDB::bind_method(D_METHOD("cost_of_n_linear", "increments", "owned", "counts"), &BigNumberArray::cost_of_n_linear);
+	ClassDB::bind_method(D_METHOD("max_affordable_linear", "increments", "owned", "budget"), &BigNumberArray::max_affordable_linear);
+
+	ClassDB::bind_static_method("BigNumberArray", D_METHOD("set_parallel_threshold", "threshold"), &BigNumberArray::set_parallel_threshold);
+	ClassDB::bind_static_method("BigNumberArray", D_METHOD("get_parallel_threshold"), &BigNumberArray::get_parallel_threshold);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "big_number.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+
+using namespace godot;
+
+class BigNumberArray : public RefCounted {
+	GDCLASS(BigNumberArray, RefCounted)
+
+public:
+	BigNumberArray();
+	~BigNumberArray();
+
+	void resize(int64_t p_size);
+	int64_t size() const;
+	bool is_empty() const;
+	void clear();
+
+	void set_value(int64_t p_index, const Variant &p_value);
+	Ref<BigNumber> get_value(int64_t p_index) const;
+
+	void set_mantissas(const PackedFloat64Array &p_mantissas);
+	PackedFloat64Array get_mantissas() const;
+	void set_exponents(const PackedInt64Array &p_exponents);
+	PackedInt64Array get_exponents() const;
+
+	void set_from_parts(const PackedFloat64Array &p_mantissas, const PackedInt64Array &p_exponents);
+	void set_from_floats(const PackedFloat64Array &p_values);
+	void set_from_ints(const PackedInt64Array &p_values);
+	// Same rules as BigNumber::parse(), unreadable strings become 0
+	void set_from_strings(const PackedStringArray &p_values);
+	// Anything BigNumber accepts, typically an Array of BigNumber
+	void set_from_values(const Array &p_values);
+	PackedFloat64Array to_floats() const;
+	// BigNumber::to_sort_key() of every element
+	PackedInt64Array to_sort_keys() const;
+	void set_from_sort_keys(const PackedInt64Array &p_keys);
+
+	void normalize();
+
+	// Element-wise when n is a BigNumberArray of the same size, broadcast otherwise
+	Ref<BigNumberArray> plus_equals(const Variant &n);
+	Ref<BigNumberArray> minus_equals(const Variant &n);
+	Ref<BigNumberArray> multiply_equals(const Variant &n);
+	Ref<BigNumberArray> divide_equals(const Variant &n);
+	Ref<BigNumberArray> power_equals(const Variant &n);
+	PackedInt32Array compare(const Variant &n) const;
+	PackedStringArray format(BigNumber::Notation p_notation, BitField<BigNumber::FormatFlags> p_flags) const;
+
+	// Reductions, in strict numeric order (Reduction::is_less()). Ties go to
+	// the lowest index.
+	Ref<BigNumber> sum() const;
+	Ref<BigNumber> product() const;
+	Ref<BigNumber> mean() const;
+	double log_sum_exp() const;
+	Ref<BigNumber> min() const;
+	Ref<BigNumber> max() const;
+	int64_t argmin() const;
+	int64_t argmax() const;
+
+	// Stable, equal values keep their order
+	void sort(bool p_descending = false);
+	PackedInt64Array argsort(bool p_descending = false) const;
+	// Indices of the p_count largest (or smallest) elements, best first
+	PackedInt64Array top_k(int64_t p_count, bool p_largest = true) const;
+	// Stable in-place sort of an Array of anything BigNumber accepts
+	static void sort_values(const Array &p_values, bool p_descending = false);
+
+	// Bulk buying with one shop item per element, this array holding the
+	// base prices, see BigNumber::cost_of_n(). The budget is element-wise
+	// when it is a BigNumberArray of the same size, broadcast otherwise.
+	Ref<BigNumberArray> cost_of_n(const PackedFloat64Array &p_growths, const PackedInt64Array &p_owned, const PackedInt64Array &p_counts) const;
+	PackedInt64Array max_affordable(const PackedFloat64Array &p_growths, const PackedInt64Array &p_owned, const Variant &p_budget) const;
+	Ref<BigNumberArray> cost_of_n_linear(const Ref<BigNumberArray> &p_increments, const PackedInt64Array &p_owned, const PackedInt64Array &p_counts) const;
+	PackedInt64Array max_affordable_linear(const Ref<BigNumberArray> &p_increments, const PackedInt64Array &p_owned, const Variant &p_budget) const;
+
+	// Arrays with at least this many elements are split across the WorkerThreadPool
+	static void set_parallel_threshold(int64_t p_threshold);
+	static int64_t get_parallel_threshold();
+
+	Ref<BigNumberArray> duplicate() const;
+
+	// Same layout as BigNumber::encode_array()
+	PackedByteArray to_bytes() const;
+	static Ref<BigNumberArray> from_bytes(const PackedByteArray &p_bytes);
+
+protected:
+	static void _bind_methods();
+
+private:
+	enum Operation {
+		OP_PLUS,
+		OP_MINUS,
+		OP_MULTIPLY,
+		OP_DIVIDE,
+		OP_POWER,
+	};
+
+	void _apply(Operation p_op, const Variant &n);
+	// Points r_mantissas/r_exponents at the budget of element i * r_step
+	bool _get_budget(const Variant &p_budget, const double *&r_mantissas, const int64_t *&r_exponents, int64_t &r_step, double &r_mantissa, int64_t &r_exponent) const;
+
+	PackedFloat64Array mantissas;
+	PackedInt64Array exponents;
+};
@@ -0,0 +1,620 @@
+#include "big_number_formula.hpp"
+#include "core/big_number_core.hpp"
+#include "parallel.hpp"
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+
+#include <atomic>
+#include <cmath>
+
+using namespace godot;
+
+namespace {
+// Integer arithmetic as in GDScript, false when the result does not fit
+bool add_ints(int64_t p_left, int64_t p_right, int64_t &r_result) {
+	if ((p_right > 0 && p_left > INT64_MAX - p_right) || (p_right < 0 && p_left < INT64_MIN - p_right)) {
+		return false;
+	}
+	r_result = p_left + p_right;
+	return true;
+}
+
+bool subtract_ints(int64_t p_left, int64_t p_right, int64_t &r_result) {
+	if ((p_right < 0 && p_left > INT64_MAX + p_right) || (p_right > 0 && p_left < INT64_MIN + p_right)) {
+		return false;
+	}
+	r_result = p_left - p_right;
+	return true;
+}
+
+bool multiply_ints(int64_t p_left, int64_t p_right, int64_t &r_result) {
+	// The double product is within a few units of the exact one, far from
+	// the limit whenever it passes
+	if (std::fabs((double)p_left * (double)p_right) >= 9.0e18) {
+		return false;
+	}
+	r_result = p_left * p_right;
+	return true;
+}
+
+bool is_identifier_start(char32_t p_char) {
+	return (p_char >= 'a' && p_char <= 'z') || (p_char >= 'A' && p_char <= 'Z') || p_char == '_';
+}
+
+bool is_digit(char32_t p_char) {
+	return p_char >= '0' && p_char <= '9';
+}
+} // namespace
+
+BigNumberFormula::Value BigNumberFormula::Value::from_parts(double p_mantissa, int64_t p_exponent) {
+	Value res;
+	res.mantissa = p_mantissa;
+	res.exponent = p_exponent;
+	res.kind = KIND_BIG;
+	return res;
+}
+
+BigNumberFormula::Value BigNumberFormula::Value::from_int(int64_t p_value) {
+	Value res;
+	res.kind = KIND_INT;
+	res.int_value = p_value;
+	BigNumber::_get_number_values((double)p_value, res.mantissa, res.exponent);
+	return res;
+}
+
+BigNumberFormula::Value BigNumberFormula::Value::from_float(double p_value) {
+	Value res;
+	res.kind = KIND_FLOAT;
+	res.float_value = p_value;
+	BigNumber::_get_number_values(p_value, res.mantissa, res.exponent);
+	return res;
+}
+
+BigNumberFormula::Value BigNumberFormula::Value::from_variant(const Variant &p_value) {
+	if (p_value.get_type() == Variant::INT) {
+		return from_int(p_value);
+	} else if (p_value.get_type() == Variant::FLOAT) {
+		return from_float(p_value);
+	}
+
+	double m;
+	int64_t e;
+	BigNumber::_get_values(p_value, m, e);
+	return from_parts(m, e);
+}
+
+// Recursive descent, lowest precedence first:
+//   expression = term { ("+" | "-") term }
+//   term       = unary { ("*" | "/") unary }
+//   unary      = ("-" | "+") unary | power
+//   power      = primary [ "^" unary ]
+//   primary    = number | name | name "(" arguments ")" | "(" expression ")"
+struct BigNumberFormula::Parser {
+	BigNumberFormula *formula = nullptr;
+	const String *text = nullptr;
+	int64_t position = 0;
+	bool collect_names = true;
+	int stack_size = 0;
+	int nesting = 0;
+	String error;
+
+	char32_t peek() {
+		while (position < text->length() && ((*text)[position] == ' ' || (*text)[position] == '\t' || (*text)[position] == '\n')) {
+			position++;
+		}
+		return position < text->length() ? (*text)[position] : 0;
+	}
+
+	bool fail(const String &p_message) {
+		if (error.is_empty()) {
+			error = p_message + " at position " + String::num_int64(position) + ".";
+		}
+		return false;
+	}
+
+	bool emit(Opcode p_op, int32_t p_index = 0) {
+		if (p_op == OP_CONSTANT || p_op == OP_VARIABLE) {
+			stack_size++;
+		} else if (p_op != OP_NEGATE && p_op != OP_SQRT && p_op != OP_ABS && p_op != OP_FLOOR) {
+			stack_size--;
+		}
+		if (stack_size > MAX_STACK) {
+			return fail("Expression is too complex");
+		}
+		formula->code.push_back({ p_op, p_index });
+		return true;
+	}
+
+	bool parse_expression() {
+		if (++nesting > MAX_STACK) {
+			return fail("Expression is nested too deeply");
+		}
+		if (!parse_term()) {
+			return false;
+		}
+		while (peek() == '+' || peek() == '-') {
+			Opcode op = (*text)[position] == '+' ? OP_ADD : OP_SUBTRACT;
+			position++;
+			if (!parse_term() || !emit(op)) {
+				return false;
+			}
+		}
+		nesting--;
+		return true;
+	}
+
+	bool parse_term() {
+		if (!parse_unary()) {
+			return false;
+		}
+		while (peek() == '*' || peek() == '/') {
+			Opcode op = (*text)[position] == '*' ? OP_MULTIPLY : OP_DIVIDE;
+			position++;
+			if (!parse_unary() || !emit(op)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool parse_unary() {
+		if (peek() == '-' || peek() == '+') {
+			bool negate = (*text)[position] == '-';
+			position++;
+			if (++nesting > MAX_STACK) {
+				return fail("Expression is nested too deeply");
+			}
+			if (!parse_unary()) {
+				return false;
+			}
+			nesting--;
+			return negate ? emit(OP_NEGATE) : true;
+		}
+		return parse_power();
+	}
+
+	bool parse_power() {
+		if (!parse_primary()) {
+			return false;
+		}
+		if (peek() == '^') {
+			position++;
+			// Right-associative, and allows a sign: a ^ b ^ c, a ^ -2
+			if (!parse_unary() || !emit(OP_POWER)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool parse_number() {
+		int64_t start = position;
+		bool integer = true;
+		while (position < text->length() && is_digit((*text)[position])) {
+			position++;
+		}
+		if (position < text->length() && (*text)[position] == '.') {
+			integer = false;
+			position++;
+			while (position < text->length() && is_digit((*text)[position])) {
+				position++;
+			}
+		}
+		bool scientific = false;
+		if (position < text->length() && (*text)[position] == 'e') {
+			integer = false;
+			scientific = true;
+			position++;
+			if (position < text->length() && ((*text)[position] == '-' || (*text)[position] == '+')) {
+				position++;
+			}
+			if (position >= text->length() || !is_digit((*text)[position])) {
+				return fail("Invalid number");
+			}
+			while (position < text->length() && is_digit((*text)[position])) {
+				position++;
+			}
+		}
+
+		String literal = text->substr(start, position - start);
+		if (literal == ".") {
+			return fail("Invalid number");
+		}
+		Value value;
+		double m;
+		int64_t e;
+		if (integer && literal.length() <= 18) {
+			value = Value::from_int(literal.to_int());
+		} else if (!scientific && !integer) {
+			value = Value::from_float(literal.to_float());
+		} else {
+			// Same rules as the String constructor, the exponent may exceed a double's
+			BigNumber::_parse_string(literal, m, e);
+			BigNumberCore::normalize(m, e);
+			value = Value::from_parts(m, e);
+		}
+		formula->constants.push_back(value);
+		return emit(OP_CONSTANT, (int32_t)formula->constants.size() - 1);
+	}
+
+	bool parse_call(const String &p_name) {
+		Opcode op;
+		int arguments = 1;
+		if (p_name == "sqrt") {
+			op = OP_SQRT;
+		} else if (p_name == "abs") {
+			op = OP_ABS;
+		} else if (p_name == "floor") {
+			op = OP_FLOOR;
+		} else if (p_name == "min") {
+			op = OP_MIN;
+			arguments = 2;
+		} else if (p_name == "max") {
+			op = OP_MAX;
+			arguments = 2;
+		} else {
+			return fail("Unknown function \"" + p_name + "\"");
+		}
+
+		position++; // "("
+		for (int i = 0; i < arguments; i++) {
+			if (i > 0) {
+				if (peek() != ',') {
+					return fail("Expected \",\"");
+				}
+				position++;
+			}
+			if (!parse_expression()) {
+				return false;
+			}
+		}
+		if (peek() != ')') {
+			return fail("Expected \")\"");
+		}
+		position++;
+		return emit(op);
+	}
+
+	bool parse_primary() {
+		char32_t c = peek();
+		if (is_digit(c) || c == '.') {
+			return parse_number();
+		}
+
+		if (c == '(') {
+			position++;
+			if (!parse_expression()) {
+				return false;
+			}
+			if (peek() != ')') {
+				return fail("Expected \")\"");
+			}
+			position++;
+			return true;
+		}
+
+		if (!is_identifier_start(c)) {
+			return fail(c == 0 ? String("Unexpected end of expression") : "Unexpected character \"" + String::chr(c) + "\"");
+		}
+		int64_t start = position;
+		while (position < text->length() && (is_identifier_start((*text)[position]) || is_digit((*text)[position]))) {
+			position++;
+		}
+		String name = text->substr(start, position - start);
+		if (peek() == '(') {
+			return parse_call(name);
+		}
+
+		int64_t index = formula->variable_names.find(name);
+		if (index < 0) {
+			if (!collect_names) {
+				return fail("Unknown variable \"" + name + "\"");
+			}
+			if (formula->variable_names.size() >= MAX_VARIABLES) {
+				return fail("Too many variables");
+			}
+			formula->variable_names.push_back(name);
+			index = formula->variable_names.size() - 1;
+		}
+		return emit(OP_VARIABLE, (int32_t)index);
+	}
+};
+
+BigNumberFormula::BigNumberFormula() {
+}
+
+BigNumberFormula::~BigNumberFormula() {
+}
+
+Error BigNumberFormula::compile(const String &p_expression, const PackedStringArray &p_variable_names) {
+	expression = p_expression;
+	error_text = String();
+	variable_names = p_variable_names;
+	code.clear();
+	constants.clear();
+	compiled = false;
+
+	if (variable_names.size() > MAX_VARIABLES) {
+		error_text = "Too many variables.";
+		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "BigNumberFormula Error: " + error_text);
+	}
+
+	Parser parser;
+	parser.formula = this;
+	parser.text = &expression;
+	parser.collect_names = p_variable_names.is_empty();
+	if (parser.parse_expression() && parser.peek() != 0) {
+		parser.fail("Unexpected character \"" + String::chr(expression[parser.position]) + "\"");
+	}
+
+	if (!parser.error.is_empty()) {
+		error_text = parser.error;
+		code.clear();
+		constants.clear();
+		ERR_FAIL_V_MSG(ERR_PARSE_ERROR, "BigNumberFormula Error: " + error_text);
+	}
+
+	compiled = true;
+	return OK;
+}
+
+bool BigNumberFormula::is_compiled() const {
+	return compiled;
+}
+
+String BigNumberFormula::get_expression() const {
+	return expression;
+}
+
+String BigNumberFormula::get_error_text() const {
+	return error_text;
+}
+
+PackedStringArray BigNumberFormula::get_variable_names() const {
+	return variable_names;
+}
+
+template <typename L>
+bool BigNumberFormula::_run(const L &p_load, double &r_mantissa, int64_t &r_exponent) const {
+	Value stack[MAX_STACK];
+	int top = 0;
+	bool ok = true;
+
+	for (const Instruction &instruction : code) {
+		switch (instruction.op) {
+			case OP_CONSTANT:
+				stack[top++] = constants[instruction.index];
+				break;
+			case OP_VARIABLE:
+				stack[top++] = p_load(instruction.index);
+				break;
+			case OP_NEGATE: {
+				Value &a = stack[top - 1];
+				if (a.kind == KIND_INT && a.int_value != INT64_MIN) {
+					a = Value::from_int(-a.int_value);
+				} else if (a.kind == KIND_FLOAT) {
+					a = Value::from_float(-a.float_value);
+				} else {
+					// BigNumber(0).minus_equals(a)
+					double m = 0.0;
+					int64_t e = 0;
+					BigNumberCore::add(m, e, -a.mantissa, a.exponent);
+					a = Value::from_parts(m, e);
+				}
+			} break;
+			case OP_ADD:
+			case OP_SUBTRACT:
+			case OP_MULTIPLY: {
+				Value &a = stack[top - 2];
+				const Value &b = stack[top - 1];
+				top--;
+
+				int64_t result;
+				if (a.kind == KIND_INT && b.kind == KIND_INT) {
+					bool fits;
+					if (instruction.op == OP_ADD) {
+						fits = add_ints(a.int_value, b.int_value, result);
+					} else if (instruction.op == OP_SUBTRACT) {
+						fits = subtract_ints(a.int_value, b.int_value, result);
+					} else {
+						fits = multiply_ints(a.int_value, b.int_value, result);
+					}
+					if (fits) {
+						a = Value::from_int(result);
+						break;
+					}
+				}
+
+				if (instruction.op == OP_ADD) {
+					BigNumberCore::add(a.mantissa, a.exponent, b.mantissa, b.exponent);
+				} else if (instruction.op == OP_SUBTRACT) {
+					BigNumberCore::add(a.mantissa, a.exponent, -b.mantissa, b.exponent);
+				} else {
+					BigNumberCore::multiply(a.mantissa, a.exponent, b.mantissa, b.exponent);
+				}
+				a.kind = KIND_BIG;
+			} break;
+			case OP_DIVIDE: {
+				Value &a = stack[top - 2];
+				const Value &b = stack[top - 1];
+				top--;
+				if (!BigNumberCore::divide(a.mantissa, a.exponent, b.mantissa, b.exponent)) {
+					ok = false;
+				}
+				a.kind = KIND_BIG;
+			} break;
+			case OP_POWER: {
+				Value &a = stack[top - 2];
+				const Value &b = stack[top - 1];
+				top--;
+				// Same as BigNumber::power_equals() with an int, float or BigNumber
+				if (b.kind == KIND_INT) {
+					BigNumberCore::power_int(a.mantissa, a.exponent, b.int_value);
+				} else if (b.kind == KIND_FLOAT) {
+					BigNumberCore::power_float(a.mantissa, a.exponent, b.float_value);
+				} else {
+					BigNumberCore::power_float(a.mantissa, a.exponent, BigNumberCore::to_float(b.mantissa, b.exponent));
+				}
+				a.kind = KIND_BIG;
+			} break;
+			case OP_SQRT: {
+				Value &a = stack[top - 1];
+				BigNumberCore::square_root(a.mantissa, a.exponent);
+				a.kind = KIND_BIG;
+			} break;
+			case OP_ABS: {
+				Value &a = stack[top - 1];
+				if (a.kind == KIND_INT && a.int_value != INT64_MIN) {
+					a = Value::from_int(a.int_value < 0 ? -a.int_value : a.int_value);
+				} else if (a.kind == KIND_FLOAT) {
+					a = Value::from_float(std::fabs(a.float_value));
+				} else {
+					a.mantissa = std::fabs(a.mantissa);
+					a.kind = KIND_BIG;
+				}
+			} break;
+			case OP_FLOOR: {
+				Value &a = stack[top - 1];
+				if (a.kind != KIND_INT) {
+					BigNumberCore::floor(a.mantissa, a.exponent);
+					a.kind = KIND_BIG;
+				}
+			} break;
+			case OP_MIN:
+			case OP_MAX: {
+				Value &a = stack[top - 2];
+				const Value &b = stack[top - 1];
+				top--;
+				bool less = BigNumberCore::is_less_than(b.mantissa, b.exponent, a.mantissa, a.exponent);
+				if (less == (instruction.op == OP_MIN)) {
+					a = b;
+				}
+			} break;
+		}
+	}
+
+	r_mantissa = stack[0].mantissa;
+	r_exponent = stack[0].exponent;
+	return ok;
+}
+
+Ref<BigNumber> BigNumberFormula::evaluate(const Array &p_values) const {
+	Ref<BigNumber> res = memnew(BigNumber);
+	return evaluate_into(res, p_values);
+}
+
+Ref<BigNumber> BigNumberFormula::evaluate_into(const Ref<BigNumber> &r_out, const Array &p_values) const {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumberFormula Error: Output is null.");
+	ERR_FAIL_COND_V_MSG(!compiled, r_out, "BigNumberFormula Error: No expression compiled.");
+	ERR_FAIL_COND_V_MSG(p_values.size() != variable_names.size(), r_out, "BigNumberFormula Error: Expected " + String::num_int64(variable_names.size()) + " values, got " + String::num_int64(p_values.size()) + ".");
+
+	Value values[MAX_VARIABLES];
+	for (int64_t i = 0; i < p_values.size(); i++) {
+		values[i] = Value::from_variant(p_values[i]);
+	}
+
+	if (!_run([&](int32_t p_index) { return values[p_index]; }, r_out->mantissa, r_out->exponent)) {
+		ERR_PRINT("BigNumberFormula Error: Divide by zero");
+	}
+	return r_out;
+}
+
+Ref<BigNumberArray> BigNumberFormula::evaluate_batch(const Array &p_values) const {
+	ERR_FAIL_COND_V_MSG(!compiled, Ref<BigNumberArray>(), "BigNumberFormula Error: No expression compiled.");
+	ERR_FAIL_COND_V_MSG(p_values.size() != variable_names.size(), Ref<BigNumberArray>(), "BigNumberFormula Error: Expected " + String::num_int64(variable_names.size()) + " values, got " + String::num_int64(p_values.size()) + ".");
+
+	// Either one of the pointers is set, or the value applies to every element
+	struct Column {
+		const double *mantissas = nullptr;
+		const int64_t *exponents = nullptr;
+		const double *floats = nullptr;
+		const int64_t *ints = nullptr;
+		Value value;
+	};
+	Column columns[MAX_VARIABLES];
+
+	// Keep the array data alive while the pointers are used
+	LocalVector<PackedFloat64Array> float_arrays;
+	LocalVector<PackedInt64Array> int_arrays;
+
+	int64_t count = -1;
+	for (int64_t i = 0; i < p_values.size(); i++) {
+		const Variant &value = p_values[i];
+		int64_t size = -1;
+		if (value.get_type() == Variant::PACKED_FLOAT64_ARRAY) {
+			float_arrays.push_back(value);
+			columns[i].floats = float_arrays[float_arrays.size() - 1].ptr();
+			size = float_arrays[float_arrays.size() - 1].size();
+		} else if (value.get_type() == Variant::PACKED_INT64_ARRAY) {
+			int_arrays.push_back(value);
+			columns[i].ints = int_arrays[int_arrays.size() - 1].ptr();
+			size = int_arrays[int_arrays.size() - 1].size();
+		} else if (value.get_type() == Variant::OBJECT && Ref<BigNumberArray>(value).is_valid()) {
+			Ref<BigNumberArray> array = value;
+			float_arrays.push_back(array->get_mantissas());
+			int_arrays.push_back(array->get_exponents());
+			columns[i].mantissas = float_arrays[float_arrays.size() - 1].ptr();
+			columns[i].exponents = int_arrays[int_arrays.size() - 1].ptr();
+			size = array->size();
+		} else {
+			columns[i].value = Value::from_variant(value);
+			continue;
+		}
+
+		ERR_FAIL_COND_V_MSG(count >= 0 && size != count, Ref<BigNumberArray>(), "BigNumberFormula Error: Array values must have the same size.");
+		count = size;
+	}
+	if (count < 0) {
+		count = 1; // Only single values
+	}
+
+	PackedFloat64Array mantissas;
+	PackedInt64Array exponents;
+	mantissas.resize(count);
+	exponents.resize(count);
+	double *m = mantissas.ptrw();
+	int64_t *e = exponents.ptrw();
+	std::atomic<bool> divided_by_zero(false);
+
+	Parallel::for_range(count, [&](int64_t p_begin, int64_t p_end) {
+		for (int64_t i = p_begin; i < p_end; i++) {
+			auto load = [&](int32_t p_index) {
+				const Column &column = columns[p_index];
+				if (column.mantissas != nullptr) {
+					return Value::from_parts(column.mantissas[i], column.exponents[i]);
+				} else if (column.floats != nullptr) {
+					return Value::from_float(column.floats[i]);
+				} else if (column.ints != nullptr) {
+					return Value::from_int(column.ints[i]);
+				}
+				return column.value;
+			};
+			if (!_run(load, m[i], e[i])) {
+				divided_by_zero.store(true, std::memory_order_relaxed);
+			}
+		}
+	});
+
+	if (divided_by_zero.load()) {
+		ERR_PRINT("BigNumberFormula Error: Divide by zero");
+	}
+
+	Ref<BigNumberArray> res;
+	res.instantiate();
+	res->set_mantissas(mantissas);
+	res->set_exponents(exponents);
+	return res;
+}
+
+void BigNumberFormula::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("compile", "expression", "variable_names"), &BigNumberFormula::compile, DEFVAL(PackedStringArray()));
+	ClassDB::bind_method(D_METHOD("is_compiled"), &BigNumberFormula::is_compiled);
+	ClassDB::bind_method(D_METHOD("get_expression"), &BigNumberFormula::get_expression);
+	ClassDB::bind_method(D_METHOD("get_error_text"), &BigNumberFormula::get_error_text);
+	ClassDB::bind_method(D_METHOD("get_variable_names"), &BigNumberFormula::get_variable_names);
+
+	ClassDB::bind_method(D_METHOD("evaluate", "values"), &BigNumberFormula::evaluate, DEFVAL(Array()));
+	ClassDB::bind_method(D_METHOD("evaluate_into", "out", "values"), &BigNumberFormula::evaluate_into, DEFVAL(Array()));
+	ClassDB::bind_method(D_METHOD("evaluate_batch", "values"), &BigNumberFormula::evaluate_batch, DEFVAL(Array()));
+}
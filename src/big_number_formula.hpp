@@ -0,0 +1,105 @@
+#pragma once
+
+#include "big_number.hpp"
+#include "big_number_array.hpp"
+
+#include <godot_cpp/classes/global_constants.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+
+using namespace godot;
+
+// Arithmetic expression over named variables, compiled once to a stack
+// bytecode and evaluated on plain mantissa/exponent values, without
+// creating a BigNumber per step.
+class BigNumberFormula : public RefCounted {
+	GDCLASS(BigNumberFormula, RefCounted)
+
+public:
+	// Limits of one expression, so evaluation can run on a fixed-size stack
+	static const int MAX_STACK = 64;
+	static const int MAX_VARIABLES = 64;
+
+	BigNumberFormula();
+	~BigNumberFormula();
+
+	// Variables are taken from p_variable_names in that order, or collected
+	// from the expression in order of appearance when it is empty
+	Error compile(const String &p_expression, const PackedStringArray &p_variable_names = PackedStringArray());
+	bool is_compiled() const;
+	String get_expression() const;
+	String get_error_text() const;
+	PackedStringArray get_variable_names() const;
+
+	// One value per variable, in the order of get_variable_names()
+	Ref<BigNumber> evaluate(const Array &p_values) const;
+	Ref<BigNumber> evaluate_into(const Ref<BigNumber> &r_out, const Array &p_values) const;
+	// Same, with BigNumberArray, PackedFloat64Array or PackedInt64Array
+	// values evaluated element-wise
+	Ref<BigNumberArray> evaluate_batch(const Array &p_values) const;
+
+protected:
+	static void _bind_methods();
+
+private:
+	enum Opcode : uint8_t {
+		OP_CONSTANT,
+		OP_VARIABLE,
+		OP_NEGATE,
+		OP_ADD,
+		OP_SUBTRACT,
+		OP_MULTIPLY,
+		OP_DIVIDE,
+		OP_POWER,
+		OP_SQRT,
+		OP_ABS,
+		OP_FLOOR,
+		OP_MIN,
+		OP_MAX,
+	};
+
+	struct Instruction {
+		Opcode op;
+		int32_t index; // Constant or variable index
+	};
+
+	// What the value would be in GDScript, which decides how it is used as
+	// an exponent: ints take the exact path of power_equals(), floats and
+	// BigNumbers the logarithmic one
+	enum Kind : uint8_t {
+		KIND_BIG,
+		KIND_INT,
+		KIND_FLOAT,
+	};
+
+	// Normalized mantissa/exponent, plus the original number for ints and
+	// floats. Left uninitialized by default, evaluation keeps a stack of them.
+	struct Value {
+		double mantissa;
+		int64_t exponent;
+		Kind kind;
+		int64_t int_value;
+		double float_value;
+
+		static Value from_parts(double p_mantissa, int64_t p_exponent);
+		static Value from_int(int64_t p_value);
+		static Value from_float(double p_value);
+		static Value from_variant(const Variant &p_value);
+	};
+
+	struct Parser;
+
+	// Runs the bytecode, p_load(i) returns variable i. Returns false if a
+	// division by zero occurred, the dividend is then kept as is.
+	template <typename L>
+	bool _run(const L &p_load, double &r_mantissa, int64_t &r_exponent) const;
+
+	String expression;
+	String error_text;
+	PackedStringArray variable_names;
+	LocalVector<Instruction> code;
+	LocalVector<Value> constants;
+	bool compiled = false;
+};
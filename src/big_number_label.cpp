@@ -0,0 +1,113 @@
+#include "big_number_label.hpp"
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+BigNumberLabel::BigNumberLabel() {
+}
+
+BigNumberLabel::~BigNumberLabel() {
+}
+
+void BigNumberLabel::set_number(const Ref<BigNumber> &p_number) {
+	number = p_number;
+	refresh();
+}
+
+Ref<BigNumber> BigNumberLabel::get_number() const {
+	return number;
+}
+
+void BigNumberLabel::set_notation(BigNumber::Notation p_notation) {
+	notation = p_notation;
+	refresh();
+}
+
+BigNumber::Notation BigNumberLabel::get_notation() const {
+	return notation;
+}
+
+void BigNumberLabel::set_format_flags(BitField<BigNumber::FormatFlags> p_flags) {
+	format_flags = (uint32_t)(int64_t)p_flags;
+	refresh();
+}
+
+BitField<BigNumber::FormatFlags> BigNumberLabel::get_format_flags() const {
+	return format_flags;
+}
+
+void BigNumberLabel::set_refresh_rate(double p_refresh_rate) {
+	refresh_rate = MAX(0.0, p_refresh_rate);
+}
+
+double BigNumberLabel::get_refresh_rate() const {
+	return refresh_rate;
+}
+
+void BigNumberLabel::refresh() {
+	time_since_refresh = 0.0;
+	_update_text(true);
+}
+
+void BigNumberLabel::_update_text(bool p_force) {
+	if (number.is_null()) {
+		last_key_valid = false;
+		if (p_force) {
+			set_text("");
+		}
+		return;
+	}
+
+	// Same key as the format cache, so an unchanged key means the string
+	// would come out identical
+	uint32_t flags = format_flags & BigNumber::_get_notation_flags_mask(notation);
+	FormatCache::Key key;
+	bool key_valid = BigNumber::_get_format_key(number->mantissa, number->exponent, notation, flags, BigNumber::get_format_options(), key);
+	if (!p_force && key_valid && last_key_valid && key == last_key) {
+		return;
+	}
+
+	last_key = key;
+	last_key_valid = key_valid;
+
+	String text = number->format(notation, flags);
+	if (text != get_text()) {
+		set_text(text);
+	}
+}
+
+void BigNumberLabel::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_ENTER_TREE: {
+			set_process_internal(true);
+			refresh();
+		} break;
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			if (refresh_rate > 0.0) {
+				time_since_refresh += get_process_delta_time();
+				if (time_since_refresh < 1.0 / refresh_rate) {
+					return;
+				}
+				time_since_refresh = 0.0;
+			}
+			_update_text(false);
+		} break;
+	}
+}
+
+void BigNumberLabel::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_number", "number"), &BigNumberLabel::set_number);
+	ClassDB::bind_method(D_METHOD("get_number"), &BigNumberLabel::get_number);
+	ClassDB::bind_method(D_METHOD("set_notation", "notation"), &BigNumberLabel::set_notation);
+	ClassDB::bind_method(D_METHOD("get_notation"), &BigNumberLabel::get_notation);
+	ClassDB::bind_method(D_METHOD("set_format_flags", "flags"), &BigNumberLabel::set_format_flags);
+	ClassDB::bind_method(D_METHOD("get_format_flags"), &BigNumberLabel::get_format_flags);
+	ClassDB::bind_method(D_METHOD("set_refresh_rate", "refresh_rate"), &BigNumberLabel::set_refresh_rate);
+	ClassDB::bind_method(D_METHOD("get_refresh_rate"), &BigNumberLabel::get_refresh_rate);
+	ClassDB::bind_method(D_METHOD("refresh"), &BigNumberLabel::refresh);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "number", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE, "BigNumber"), "set_number", "get_number");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "notation", PROPERTY_HINT_ENUM, "Scientific,Prefix,AA,Metric Symbol,Metric Name,Short Scale,Long Name"), "set_notation", "get_notation");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "format_flags", PROPERTY_HINT_FLAGS, "No Decimals On Small Values,Use Thousand Symbol,Force Decimals,Scientific Prefix,European System"), "set_format_flags", "get_format_flags");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "refresh_rate", PROPERTY_HINT_RANGE, "0,240,0.1,or_greater,suffix:Hz"), "set_refresh_rate", "get_refresh_rate");
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "big_number.hpp"
+
+#include <godot_cpp/classes/label.hpp>
+
+using namespace godot;
+
+class BigNumberLabel : public Label {
+	GDCLASS(BigNumberLabel, Label)
+
+public:
+	BigNumberLabel();
+	~BigNumberLabel();
+
+	void set_number(const Ref<BigNumber> &p_number);
+	Ref<BigNumber> get_number() const;
+
+	void set_notation(BigNumber::Notation p_notation);
+	BigNumber::Notation get_notation() const;
+
+	void set_format_flags(BitField<BigNumber::FormatFlags> p_flags);
+	BitField<BigNumber::FormatFlags> get_format_flags() const;
+
+	// Maximum text updates per second, 0 checks every frame
+	void set_refresh_rate(double p_refresh_rate);
+	double get_refresh_rate() const;
+
+	// Re-formats now, even if the displayed digits did not change
+	void refresh();
+
+protected:
+	static void _bind_methods();
+	void _notification(int p_what);
+
+private:
+	void _update_text(bool p_force);
+
+	Ref<BigNumber> number;
+	BigNumber::Notation notation = BigNumber::NOTATION_AA;
+	uint32_t format_flags = BigNumber::FORMAT_USE_THOUSAND_SYMBOL;
+	double refresh_rate = 0.0;
+
+	double time_since_refresh = 0.0;
+	FormatCache::Key last_key;
+	bool last_key_valid = false;
+};
@@ -0,0 +1,195 @@
+#include "big_number_ledger.hpp"
+#include "core/big_number_core.hpp"
+#include <godot_cpp/core/class_db.hpp>
+
+#include <cmath>
+
+using namespace godot;
+
+BigNumberLedger::BigNumberLedger() {
+}
+
+BigNumberLedger::~BigNumberLedger() {
+}
+
+void BigNumberLedger::set_tier_count(int64_t p_count) {
+	ERR_FAIL_COND_MSG(p_count < 0, "BigNumberLedger Error: Tier count cannot be negative.");
+
+	int64_t old_count = amount_mantissas.size();
+	amount_mantissas.resize(p_count);
+	amount_exponents.resize(p_count);
+	rate_mantissas.resize(p_count);
+	rate_exponents.resize(p_count);
+
+	// New tiers start empty, producing 1 per second per unit
+	for (int64_t i = old_count; i < p_count; i++) {
+		amount_mantissas.set(i, 0.0);
+		amount_exponents.set(i, 0);
+		rate_mantissas.set(i, 1.0);
+		rate_exponents.set(i, 0);
+	}
+}
+
+int64_t BigNumberLedger::get_tier_count() const {
+	return amount_mantissas.size();
+}
+
+void BigNumberLedger::set_amount(int64_t p_tier, const Variant &p_amount) {
+	ERR_FAIL_INDEX(p_tier, amount_mantissas.size());
+
+	double m;
+	int64_t e;
+	BigNumber::_get_values(p_amount, m, e);
+	amount_mantissas.set(p_tier, m);
+	amount_exponents.set(p_tier, e);
+}
+
+Ref<BigNumber> BigNumberLedger::get_amount(int64_t p_tier) const {
+	ERR_FAIL_INDEX_V(p_tier, amount_mantissas.size(), Ref<BigNumber>());
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	res->mantissa = amount_mantissas[p_tier];
+	res->exponent = amount_exponents[p_tier];
+	return res;
+}
+
+Ref<BigNumberArray> BigNumberLedger::get_amounts() const {
+	Ref<BigNumberArray> res;
+	res.instantiate();
+	res->set_mantissas(amount_mantissas);
+	res->set_exponents(amount_exponents);
+	return res;
+}
+
+void BigNumberLedger::set_rate(int64_t p_tier, const Variant &p_rate) {
+	ERR_FAIL_INDEX(p_tier, rate_mantissas.size());
+
+	double m;
+	int64_t e;
+	BigNumber::_get_values(p_rate, m, e);
+	rate_mantissas.set(p_tier, m);
+	rate_exponents.set(p_tier, e);
+}
+
+Ref<BigNumber> BigNumberLedger::get_rate(int64_t p_tier) const {
+	ERR_FAIL_INDEX_V(p_tier, rate_mantissas.size(), Ref<BigNumber>());
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	res->mantissa = rate_mantissas[p_tier];
+	res->exponent = rate_exponents[p_tier];
+	return res;
+}
+
+void BigNumberLedger::_solve_tier(int64_t p_tier, int64_t p_ticks, double p_seconds, double &r_mantissa, int64_t &r_exponent) const {
+	// Tier k reaches tier j through k - j = d steps of production, so
+	//   continuous: a_j(T) = sum_k a_k(0) * R(j, k) * T^d / d!
+	//   ticks:      a_j(n) = sum_k a_k(0) * R(j, k) * dt^d * C(n, d)
+	// where R(j, k) is the product of the rates of tiers j + 1 to k.
+	// The coefficient is built one step at a time in mantissa/exponent
+	// form, so neither T^d, d! nor C(n, d) ever overflows a double.
+	const double *am = amount_mantissas.ptr();
+	const int64_t *ae = amount_exponents.ptr();
+	const double *rm = rate_mantissas.ptr();
+	const int64_t *re = rate_exponents.ptr();
+	int64_t count = amount_mantissas.size();
+
+	r_mantissa = am[p_tier];
+	r_exponent = ae[p_tier];
+
+	double coef_mantissa = 1.0;
+	int64_t coef_exponent = 0;
+	for (int64_t k = p_tier + 1; k < count; k++) {
+		int64_t d = k - p_tier;
+		double factor;
+		if (p_ticks < 0) {
+			factor = p_seconds / (double)d;
+		} else {
+			if (d > p_ticks) {
+				break; // C(n, d) is 0 from here on
+			}
+			factor = p_seconds * ((double)(p_ticks - d + 1) / (double)d);
+		}
+
+		double factor_mantissa = factor;
+		int64_t factor_exponent = 0;
+		BigNumberCore::normalize(factor_mantissa, factor_exponent);
+		BigNumberCore::multiply(coef_mantissa, coef_exponent, rm[k], re[k]);
+		BigNumberCore::multiply(coef_mantissa, coef_exponent, factor_mantissa, factor_exponent);
+		if (coef_mantissa == 0.0) {
+			break; // A zero rate cuts the chain
+		}
+
+		if (am[k] == 0.0) {
+			continue;
+		}
+		double term_mantissa = coef_mantissa;
+		int64_t term_exponent = coef_exponent;
+		BigNumberCore::multiply(term_mantissa, term_exponent, am[k], ae[k]);
+		BigNumberCore::add(r_mantissa, r_exponent, term_mantissa, term_exponent);
+	}
+}
+
+void BigNumberLedger::advance(double p_seconds) {
+	ERR_FAIL_COND_MSG(!std::isfinite(p_seconds) || p_seconds < 0.0, "BigNumberLedger Error: Time must be finite and cannot be negative.");
+
+	// Lower tiers read the old amounts of higher ones, so go bottom-up
+	int64_t count = amount_mantissas.size();
+	for (int64_t i = 0; i < count; i++) {
+		double m;
+		int64_t e;
+		_solve_tier(i, -1, p_seconds, m, e);
+		amount_mantissas.set(i, m);
+		amount_exponents.set(i, e);
+	}
+}
+
+Ref<BigNumber> BigNumberLedger::predict(int64_t p_tier, double p_seconds) const {
+	ERR_FAIL_INDEX_V(p_tier, amount_mantissas.size(), Ref<BigNumber>());
+	ERR_FAIL_COND_V_MSG(!std::isfinite(p_seconds) || p_seconds < 0.0, Ref<BigNumber>(), "BigNumberLedger Error: Time must be finite and cannot be negative.");
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	_solve_tier(p_tier, -1, p_seconds, res->mantissa, res->exponent);
+	return res;
+}
+
+void BigNumberLedger::advance_ticks(int64_t p_ticks, double p_tick_seconds) {
+	ERR_FAIL_COND_MSG(p_ticks < 0, "BigNumberLedger Error: Tick count cannot be negative.");
+	ERR_FAIL_COND_MSG(!std::isfinite(p_tick_seconds) || p_tick_seconds < 0.0, "BigNumberLedger Error: Time must be finite and cannot be negative.");
+
+	int64_t count = amount_mantissas.size();
+	for (int64_t i = 0; i < count; i++) {
+		double m;
+		int64_t e;
+		_solve_tier(i, p_ticks, p_tick_seconds, m, e);
+		amount_mantissas.set(i, m);
+		amount_exponents.set(i, e);
+	}
+}
+
+Ref<BigNumber> BigNumberLedger::predict_ticks(int64_t p_tier, int64_t p_ticks, double p_tick_seconds) const {
+	ERR_FAIL_INDEX_V(p_tier, amount_mantissas.size(), Ref<BigNumber>());
+	ERR_FAIL_COND_V_MSG(p_ticks < 0, Ref<BigNumber>(), "BigNumberLedger Error: Tick count cannot be negative.");
+	ERR_FAIL_COND_V_MSG(!std::isfinite(p_tick_seconds) || p_tick_seconds < 0.0, Ref<BigNumber>(), "BigNumberLedger Error: Time must be finite and cannot be negative.");
+
+	Ref<BigNumber> res = memnew(BigNumber);
+	_solve_tier(p_tier, p_ticks, p_tick_seconds, res->mantissa, res->exponent);
+	return res;
+}
+
+void BigNumberLedger::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_tier_count", "count"), &BigNumberLedger::set_tier_count);
+	ClassDB::bind_method(D_METHOD("get_tier_count"), &BigNumberLedger::get_tier_count);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "tier_count"), "set_tier_count", "get_tier_count");
+
+	ClassDB::bind_method(D_METHOD("set_amount", "tier", "amount"), &BigNumberLedger::set_amount);
+	ClassDB::bind_method(D_METHOD("get_amount", "tier"), &BigNumberLedger::get_amount);
+	ClassDB::bind_method(D_METHOD("get_amounts"), &BigNumberLedger::get_amounts);
+	ClassDB::bind_method(D_METHOD("set_rate", "tier", "rate"), &BigNumberLedger::set_rate);
+	ClassDB::bind_method(D_METHOD("get_rate", "tier"), &BigNumberLedger::get_rate);
+
+	ClassDB::bind_method(D_METHOD("advance", "seconds"), &BigNumberLedger::advance);
+	ClassDB::bind_method(D_METHOD("predict", "tier", "seconds"), &BigNumberLedger::predict);
+	ClassDB::bind_method(D_METHOD("advance_ticks", "ticks", "tick_seconds"), &BigNumberLedger::advance_ticks);
+	ClassDB::bind_method(D_METHOD("predict_ticks", "tier", "ticks", "tick_seconds"), &BigNumberLedger::predict_ticks);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "big_number.hpp"
+#include "big_number_array.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+
+using namespace godot;
+
+// Generator chain where every tier produces the tier below it. Tier 0 is the
+// currency. Progress over any span of time is solved in closed form.
+class BigNumberLedger : public RefCounted {
+	GDCLASS(BigNumberLedger, RefCounted)
+
+public:
+	BigNumberLedger();
+	~BigNumberLedger();
+
+	void set_tier_count(int64_t p_count);
+	int64_t get_tier_count() const;
+
+	void set_amount(int64_t p_tier, const Variant &p_amount);
+	Ref<BigNumber> get_amount(int64_t p_tier) const;
+	Ref<BigNumberArray> get_amounts() const;
+
+	// Units of tier - 1 produced per second by one unit of this tier
+	void set_rate(int64_t p_tier, const Variant &p_rate);
+	Ref<BigNumber> get_rate(int64_t p_tier) const;
+
+	// Continuous production
+	void advance(double p_seconds);
+	Ref<BigNumber> predict(int64_t p_tier, double p_seconds) const;
+
+	// Fixed-step production, same result as ticking one step at a time
+	void advance_ticks(int64_t p_ticks, double p_tick_seconds);
+	Ref<BigNumber> predict_ticks(int64_t p_tier, int64_t p_ticks, double p_tick_seconds) const;
+
+protected:
+	static void _bind_methods();
+
+private:
+	// p_ticks < 0 solves the continuous case over p_seconds
+	void _solve_tier(int64_t p_tier, int64_t p_ticks, double p_seconds, double &r_mantissa, int64_t &r_exponent) const;
+
+	PackedFloat64Array amount_mantissas;
+	PackedInt64Array amount_exponents;
+	PackedFloat64Array rate_mantissas;
+	PackedInt64Array rate_exponents;
+};
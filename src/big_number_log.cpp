@@ -0,0 +1,277 @@
+#include "big_number_log.hpp"
+#include "core/big_number_core.hpp"
+#include "core/log_domain.hpp"
+#include <godot_cpp/core/class_db.hpp>
+
+#include <cmath>
+
+using namespace godot;
+
+BigNumberLog::BigNumberLog() {
+}
+
+BigNumberLog::~BigNumberLog() {
+}
+
+void BigNumberLog::set_log_value(double p_log_value) {
+	log_value = p_log_value;
+	negative = negative && log_value != -INFINITY;
+}
+
+double BigNumberLog::get_log_value() const {
+	return log_value;
+}
+
+void BigNumberLog::set_negative(bool p_negative) {
+	// Zero has no sign
+	negative = p_negative && log_value != -INFINITY;
+}
+
+bool BigNumberLog::is_negative() const {
+	return negative;
+}
+
+bool BigNumberLog::is_zero() const {
+	return log_value == -INFINITY;
+}
+
+bool BigNumberLog::is_representable() const {
+	double m;
+	int64_t e;
+	return LogDomain::to_parts(log_value, m, e);
+}
+
+void BigNumberLog::_get_log_values(const Variant &n, double &r_log_value, bool &r_negative) {
+	if (n.get_type() == Variant::OBJECT) {
+		Ref<BigNumberLog> other = n;
+		if (other.is_valid()) {
+			r_log_value = other->log_value;
+			r_negative = other->negative;
+			return;
+		}
+	}
+
+	// The sign of ints and floats is kept, BigNumber normalization drops it
+	double m;
+	int64_t e;
+	if (n.get_type() == Variant::INT || n.get_type() == Variant::FLOAT) {
+		double value = n;
+		BigNumber::_get_number_values(value, m, e);
+		r_negative = value < 0.0;
+	} else {
+		BigNumber::_get_values(n, m, e);
+		r_negative = m < 0.0;
+	}
+	r_log_value = LogDomain::from_parts(m, e);
+}
+
+void BigNumberLog::set_value(const Variant &p_value) {
+	_get_log_values(p_value, log_value, negative);
+}
+
+Ref<BigNumberLog> BigNumberLog::from_value(const Variant &p_value) {
+	Ref<BigNumberLog> res;
+	res.instantiate();
+	res->set_value(p_value);
+	return res;
+}
+
+Ref<BigNumberLog> BigNumberLog::from_log_value(double p_log_value, bool p_negative) {
+	Ref<BigNumberLog> res;
+	res.instantiate();
+	res->set_log_value(p_log_value);
+	res->set_negative(p_negative);
+	return res;
+}
+
+Ref<BigNumber> BigNumberLog::to_big() const {
+	Ref<BigNumber> res = memnew(BigNumber);
+	return to_big_into(res);
+}
+
+Ref<BigNumber> BigNumberLog::to_big_into(const Ref<BigNumber> &r_out) const {
+	ERR_FAIL_COND_V_MSG(r_out.is_null(), r_out, "BigNumberLog Error: Argument is null.");
+
+	double m;
+	int64_t e;
+	ERR_FAIL_COND_V_MSG(!LogDomain::to_parts(log_value, m, e), r_out, "BigNumberLog Error: Value is out of the BigNumber range.");
+	r_out->mantissa = negative ? -m : m;
+	r_out->exponent = e;
+	return r_out;
+}
+
+double BigNumberLog::to_float() const {
+	double value = std::pow(10.0, log_value);
+	return negative ? -value : value;
+}
+
+Ref<BigNumberLog> BigNumberLog::plus_equals(const Variant &n) {
+	double other_log;
+	bool other_negative;
+	_get_log_values(n, other_log, other_negative);
+	LogDomain::add(log_value, negative, other_log, other_negative);
+	return Ref<BigNumberLog>(this);
+}
+
+Ref<BigNumberLog> BigNumberLog::minus_equals(const Variant &n) {
+	double other_log;
+	bool other_negative;
+	_get_log_values(n, other_log, other_negative);
+	LogDomain::add(log_value, negative, other_log, !other_negative);
+	return Ref<BigNumberLog>(this);
+}
+
+Ref<BigNumberLog> BigNumberLog::multiply_equals(const Variant &n) {
+	double other_log;
+	bool other_negative;
+	_get_log_values(n, other_log, other_negative);
+	LogDomain::multiply(log_value, negative, other_log, other_negative);
+	return Ref<BigNumberLog>(this);
+}
+
+Ref<BigNumberLog> BigNumberLog::divide_equals(const Variant &n) {
+	double other_log;
+	bool other_negative;
+	_get_log_values(n, other_log, other_negative);
+	if (!LogDomain::divide(log_value, negative, other_log, other_negative)) {
+		ERR_PRINT("BigNumberLog Error: Divide by zero");
+	}
+	return Ref<BigNumberLog>(this);
+}
+
+Ref<BigNumberLog> BigNumberLog::power_equals(double p_power) {
+	LogDomain::power(log_value, negative, p_power);
+	return Ref<BigNumberLog>(this);
+}
+
+bool BigNumberLog::is_less_than(const Variant &n) const {
+	double other_log;
+	bool other_negative;
+	_get_log_values(n, other_log, other_negative);
+	return LogDomain::is_less_than(log_value, negative, other_log, other_negative);
+}
+
+bool BigNumberLog::is_equal_to(const Variant &n) const {
+	double other_log;
+	bool other_negative;
+	_get_log_values(n, other_log, other_negative);
+	return LogDomain::is_equal(log_value, negative, other_log, other_negative);
+}
+
+bool BigNumberLog::is_greater_than(const Variant &n) const {
+	double other_log;
+	bool other_negative;
+	_get_log_values(n, other_log, other_negative);
+	return LogDomain::is_less_than(other_log, other_negative, log_value, negative);
+}
+
+String BigNumberLog::to_scientific(bool no_decimals_on_small_values, bool force_decimals) const {
+	uint32_t flags = 0;
+	if (no_decimals_on_small_values) flags |= BigNumber::FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
+	if (force_decimals) flags |= BigNumber::FORMAT_FORCE_DECIMALS;
+	return _format(BigNumber::NOTATION_SCIENTIFIC, flags);
+}
+
+String BigNumberLog::to_prefix(bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals, bool scientific_prefix) const {
+	uint32_t flags = 0;
+	if (no_decimals_on_small_values) flags |= BigNumber::FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
+	if (use_thousand_symbol) flags |= BigNumber::FORMAT_USE_THOUSAND_SYMBOL;
+	if (force_decimals) flags |= BigNumber::FORMAT_FORCE_DECIMALS;
+	if (scientific_prefix) flags |= BigNumber::FORMAT_SCIENTIFIC_PREFIX;
+	return _format(BigNumber::NOTATION_PREFIX, flags);
+}
+
+String BigNumberLog::to_aa(bool no_decimals_on_small_values, bool use_thousand_symbol, bool force_decimals) const {
+	uint32_t flags = 0;
+	if (no_decimals_on_small_values) flags |= BigNumber::FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
+	if (use_thousand_symbol) flags |= BigNumber::FORMAT_USE_THOUSAND_SYMBOL;
+	if (force_decimals) flags |= BigNumber::FORMAT_FORCE_DECIMALS;
+	return _format(BigNumber::NOTATION_AA, flags);
+}
+
+String BigNumberLog::to_metric_symbol(bool no_decimals_on_small_values) const {
+	return _format(BigNumber::NOTATION_METRIC_SYMBOL, no_decimals_on_small_values ? BigNumber::FORMAT_NO_DECIMALS_ON_SMALL_VALUES : 0);
+}
+
+String BigNumberLog::to_metric_name(bool no_decimals_on_small_values) const {
+	return _format(BigNumber::NOTATION_METRIC_NAME, no_decimals_on_small_values ? BigNumber::FORMAT_NO_DECIMALS_ON_SMALL_VALUES : 0);
+}
+
+String BigNumberLog::to_short_scale(bool no_decimals_on_small_values) const {
+	return _format(BigNumber::NOTATION_SHORT_SCALE, no_decimals_on_small_values ? BigNumber::FORMAT_NO_DECIMALS_ON_SMALL_VALUES : 0);
+}
+
+String BigNumberLog::to_long_name(bool no_decimals_on_small_values, bool european_system) const {
+	uint32_t flags = 0;
+	if (no_decimals_on_small_values) flags |= BigNumber::FORMAT_NO_DECIMALS_ON_SMALL_VALUES;
+	if (european_system) flags |= BigNumber::FORMAT_EUROPEAN_SYSTEM;
+	return _format(BigNumber::NOTATION_LONG_NAME, flags);
+}
+
+String BigNumberLog::format(BigNumber::Notation p_notation, BitField<BigNumber::FormatFlags> p_flags) const {
+	return _format(p_notation, (uint32_t)(int64_t)p_flags);
+}
+
+String BigNumberLog::_format(BigNumber::Notation p_notation, uint32_t p_flags) const {
+	p_flags &= BigNumber::_get_notation_flags_mask(p_notation);
+	String sign = negative ? "-" : "";
+
+	double m;
+	int64_t e;
+	if (LogDomain::to_parts(log_value, m, e)) {
+		return sign + BigNumber::_format_cached(m, e, p_notation, p_flags);
+	}
+
+	// Past the BigNumber range the log itself is written in scientific form
+	double log_mantissa = log_value;
+	int64_t log_exponent = 0;
+	BigNumberCore::normalize(log_mantissa, log_exponent);
+	String log_sign = log_value < 0.0 ? "-" : "";
+	return sign + "e" + log_sign + BigNumber::_format_cached(log_mantissa, log_exponent, BigNumber::NOTATION_SCIENTIFIC, 0);
+}
+
+String BigNumberLog::_to_string() const {
+	if (!is_representable()) {
+		return to_scientific();
+	}
+	return to_big()->to_plain_scientific();
+}
+
+void BigNumberLog::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_log_value", "log_value"), &BigNumberLog::set_log_value);
+	ClassDB::bind_method(D_METHOD("get_log_value"), &BigNumberLog::get_log_value);
+	ClassDB::bind_method(D_METHOD("set_negative", "negative"), &BigNumberLog::set_negative);
+	ClassDB::bind_method(D_METHOD("is_negative"), &BigNumberLog::is_negative);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "log_value"), "set_log_value", "get_log_value");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "negative"), "set_negative", "is_negative");
+
+	ClassDB::bind_method(D_METHOD("is_zero"), &BigNumberLog::is_zero);
+	ClassDB::bind_method(D_METHOD("is_representable"), &BigNumberLog::is_representable);
+
+	ClassDB::bind_method(D_METHOD("set_value", "value"), &BigNumberLog::set_value);
+	ClassDB::bind_static_method("BigNumberLog", D_METHOD("from_value", "value"), &BigNumberLog::from_value);
+	ClassDB::bind_static_method("BigNumberLog", D_METHOD("from_log_value", "log_value", "negative"), &BigNumberLog::from_log_value, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("to_big"), &BigNumberLog::to_big);
+	ClassDB::bind_method(D_METHOD("to_big_into", "out"), &BigNumberLog::to_big_into);
+	ClassDB::bind_method(D_METHOD("to_float"), &BigNumberLog::to_float);
+
+	ClassDB::bind_method(D_METHOD("plus_equals", "n"), &BigNumberLog::plus_equals);
+	ClassDB::bind_method(D_METHOD("minus_equals", "n"), &BigNumberLog::minus_equals);
+	ClassDB::bind_method(D_METHOD("multiply_equals", "n"), &BigNumberLog::multiply_equals);
+	ClassDB::bind_method(D_METHOD("divide_equals", "n"), &BigNumberLog::divide_equals);
+	ClassDB::bind_method(D_METHOD("power_equals", "power"), &BigNumberLog::power_equals);
+
+	ClassDB::bind_method(D_METHOD("is_less_than", "n"), &BigNumberLog::is_less_than);
+	ClassDB::bind_method(D_METHOD("is_equal_to", "n"), &BigNumberLog::is_equal_to);
+	ClassDB::bind_method(D_METHOD("is_greater_than", "n"), &BigNumberLog::is_greater_than);
+
+	ClassDB::bind_method(D_METHOD("to_scientific", "no_decimals_on_small_values", "force_decimals"), &BigNumberLog::to_scientific, DEFVAL(false), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("to_prefix", "no_decimals_on_small_values", "use_thousand_symbol", "force_decimals", "scientific_prefix"), &BigNumberLog::to_prefix, DEFVAL(false), DEFVAL(true), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("to_aa", "no_decimals_on_small_values", "use_thousand_symbol", "force_decimals"), &BigNumberLog::to_aa, DEFVAL(false), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("to_metric_symbol", "no_decimals_on_small_values"), &BigNumberLog::to_metric_symbol, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("to_metric_name", "no_decimals_on_small_values"), &BigNumberLog::to_metric_name, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("to_short_scale", "no_decimals_on_small_values"), &BigNumberLog::to_short_scale, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("to_long_name", "no_decimals_on_small_values", "european_system"), &BigNumberLog::to_long_name, DEFVAL(false), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("format", "notation", "flags"), &BigNumberLog::format, DEFVAL(0));
+}
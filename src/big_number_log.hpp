@@ -0,0 +1,71 @@
+#pragma once
+
+#include "big_number.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+
+using namespace godot;
+
+// Number stored as log10 of its magnitude plus a sign, see
+// core/log_domain.hpp. Multiply, divide and power cost one addition or
+// multiplication, and the range goes past the int64_t exponent of BigNumber.
+class BigNumberLog : public RefCounted {
+	GDCLASS(BigNumberLog, RefCounted)
+
+public:
+	BigNumberLog();
+	~BigNumberLog();
+
+	void set_log_value(double p_log_value);
+	double get_log_value() const;
+
+	void set_negative(bool p_negative);
+	bool is_negative() const;
+
+	bool is_zero() const;
+	// Whether the exponent fits a BigNumber
+	bool is_representable() const;
+
+	// Conversion from and to the mantissa/exponent form
+	void set_value(const Variant &p_value);
+	static Ref<BigNumberLog> from_value(const Variant &p_value);
+	static Ref<BigNumberLog> from_log_value(double p_log_value, bool p_negative = false);
+	Ref<BigNumber> to_big() const;
+	Ref<BigNumber> to_big_into(const Ref<BigNumber> &r_out) const;
+	double to_float() const;
+
+	Ref<BigNumberLog> plus_equals(const Variant &n);
+	Ref<BigNumberLog> minus_equals(const Variant &n);
+	Ref<BigNumberLog> multiply_equals(const Variant &n);
+	Ref<BigNumberLog> divide_equals(const Variant &n);
+	Ref<BigNumberLog> power_equals(double p_power);
+
+	bool is_less_than(const Variant &n) const;
+	bool is_equal_to(const Variant &n) const;
+	bool is_greater_than(const Variant &n) const;
+
+	// Same output as the BigNumber formatters. Values past the BigNumber
+	// range are written as "e" followed by their scientific log10.
+	String to_scientific(bool no_decimals_on_small_values = false, bool force_decimals = false) const;
+	String to_prefix(bool no_decimals_on_small_values = false, bool use_thousand_symbol = true, bool force_decimals = true, bool scientific_prefix = false) const;
+	String to_aa(bool no_decimals_on_small_values = false, bool use_thousand_symbol = true, bool force_decimals = false) const;
+	String to_metric_symbol(bool no_decimals_on_small_values = false) const;
+	String to_metric_name(bool no_decimals_on_small_values = false) const;
+	String to_short_scale(bool no_decimals_on_small_values = false) const;
+	String to_long_name(bool no_decimals_on_small_values = false, bool european_system = false) const;
+	String format(BigNumber::Notation p_notation, BitField<BigNumber::FormatFlags> p_flags) const;
+
+	String _to_string() const;
+
+protected:
+	static void _bind_methods();
+
+private:
+	// Accepts BigNumberLog in addition to everything BigNumber takes
+	static void _get_log_values(const Variant &n, double &r_log_value, bool &r_negative);
+	String _format(BigNumber::Notation p_notation, uint32_t p_flags) const;
+
+	// 1, same default as BigNumber
+	double log_value = 0.0;
+	bool negative = false;
+};
@@ -0,0 +1,281 @@
+#include "core/batch.hpp"
+#include "core/batch_kernels.hpp"
+
+#if !defined(BIG_NUMBER_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BIG_NUMBER_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BIG_NUMBER_NEON
+#include <arm_neon.h>
+#elif defined(__wasm_simd128__)
+#define BIG_NUMBER_WASM_SIMD
+#include <wasm_simd128.h>
+#endif
+#endif
+
+#if defined(BIG_NUMBER_SSE2) && (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+#define BIG_NUMBER_CPU_SUPPORTS_BUILTIN
+#elif defined(BIG_NUMBER_SSE2) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace BigNumberBatch {
+namespace internal {
+namespace {
+void scalar_normalize(double *r_mantissas, int64_t *r_exponents, int64_t p_count) {
+	for (int64_t i = 0; i < p_count; i++) {
+		BigNumberCore::normalize(r_mantissas[i], r_exponents[i]);
+	}
+}
+
+template <bool NEGATE>
+void scalar_add(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+	for (int64_t i = 0; i < p_count; i++) {
+		double om = p_other.is_array() ? p_other.mantissas[i] : p_other.mantissa;
+		int64_t oe = p_other.is_array() ? p_other.exponents[i] : p_other.exponent;
+		BigNumberCore::add(r_mantissas[i], r_exponents[i], NEGATE ? -om : om, oe);
+	}
+}
+
+void scalar_multiply(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+	for (int64_t i = 0; i < p_count; i++) {
+		double om = p_other.is_array() ? p_other.mantissas[i] : p_other.mantissa;
+		int64_t oe = p_other.is_array() ? p_other.exponents[i] : p_other.exponent;
+		BigNumberCore::multiply(r_mantissas[i], r_exponents[i], om, oe);
+	}
+}
+
+bool scalar_divide(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+	bool ok = true;
+	for (int64_t i = 0; i < p_count; i++) {
+		double om = p_other.is_array() ? p_other.mantissas[i] : p_other.mantissa;
+		int64_t oe = p_other.is_array() ? p_other.exponents[i] : p_other.exponent;
+		if (!BigNumberCore::divide(r_mantissas[i], r_exponents[i], om, oe)) {
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+void scalar_compare(const double *p_mantissas, const int64_t *p_exponents, const Operand &p_other, int32_t *r_results, int64_t p_count) {
+	for (int64_t i = 0; i < p_count; i++) {
+		double om = p_other.is_array() ? p_other.mantissas[i] : p_other.mantissa;
+		int64_t oe = p_other.is_array() ? p_other.exponents[i] : p_other.exponent;
+		if (BigNumberCore::is_less_than(p_mantissas[i], p_exponents[i], om, oe)) {
+			r_results[i] = -1;
+		} else if (BigNumberCore::is_equal(p_mantissas[i], p_exponents[i], om, oe)) {
+			r_results[i] = 0;
+		} else {
+			r_results[i] = 1;
+		}
+	}
+}
+
+const KernelTable scalar_kernels = { "scalar", &scalar_normalize, &scalar_add<false>, &scalar_add<true>, &scalar_multiply, &scalar_divide, &scalar_compare };
+
+#if defined(BIG_NUMBER_SSE2)
+struct Sse2 {
+	using Type = __m128d;
+	using Mask = __m128d;
+	static constexpr int WIDTH = 2;
+
+	static Type load(const double *p) { return _mm_loadu_pd(p); }
+	static void store(double *r, Type a) { _mm_storeu_pd(r, a); }
+	static Type set1(double v) { return _mm_set1_pd(v); }
+	static Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+	static Type sub(Type a, Type b) { return _mm_sub_pd(a, b); }
+	static Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+	static Type div(Type a, Type b) { return _mm_div_pd(a, b); }
+	static Type abs(Type a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+	static Type neg(Type a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+	static Mask ge(Type a, Type b) { return _mm_cmpge_pd(a, b); }
+	static Mask gt(Type a, Type b) { return _mm_cmpgt_pd(a, b); }
+	static Mask lt(Type a, Type b) { return _mm_cmplt_pd(a, b); }
+	static Mask eq(Type a, Type b) { return _mm_cmpeq_pd(a, b); }
+	static Mask and_(Mask a, Mask b) { return _mm_and_pd(a, b); }
+	static Mask or_(Mask a, Mask b) { return _mm_or_pd(a, b); }
+	static Mask andnot(Mask a, Mask b) { return _mm_andnot_pd(b, a); }
+	static Type blend(Mask m, Type a, Type b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+	static int bits(Mask m) { return _mm_movemask_pd(m); }
+	static void add_shifts(int64_t *r, Type a) {
+		// Sign-extend the two int32 results to int64
+		__m128i shifts = _mm_cvttpd_epi32(a);
+		shifts = _mm_unpacklo_epi32(shifts, _mm_srai_epi32(shifts, 31));
+		__m128i *values = (__m128i *)r;
+		_mm_storeu_si128(values, _mm_add_epi64(_mm_loadu_si128(values), shifts));
+	}
+};
+
+// Without 64-bit integer compares the exponent logic of add and compare
+// costs more than two lanes save, those keep the scalar loops
+const KernelTable simd_kernels = { "sse2", &Kernels<Sse2>::normalize, &scalar_add<false>, &scalar_add<true>, &Kernels<Sse2>::multiply_entry, &Kernels<Sse2>::divide_entry, &scalar_compare };
+#elif defined(BIG_NUMBER_NEON)
+struct Neon {
+	using Type = float64x2_t;
+	using Mask = uint64x2_t;
+	static constexpr int WIDTH = 2;
+
+	static Type load(const double *p) { return vld1q_f64(p); }
+	static void store(double *r, Type a) { vst1q_f64(r, a); }
+	static Type set1(double v) { return vdupq_n_f64(v); }
+	static Type add(Type a, Type b) { return vaddq_f64(a, b); }
+	static Type sub(Type a, Type b) { return vsubq_f64(a, b); }
+	static Type mul(Type a, Type b) { return vmulq_f64(a, b); }
+	static Type div(Type a, Type b) { return vdivq_f64(a, b); }
+	static Type abs(Type a) { return vabsq_f64(a); }
+	static Type neg(Type a) { return vnegq_f64(a); }
+	static Mask ge(Type a, Type b) { return vcgeq_f64(a, b); }
+	static Mask gt(Type a, Type b) { return vcgtq_f64(a, b); }
+	static Mask lt(Type a, Type b) { return vcltq_f64(a, b); }
+	static Mask eq(Type a, Type b) { return vceqq_f64(a, b); }
+	static Mask and_(Mask a, Mask b) { return vandq_u64(a, b); }
+	static Mask or_(Mask a, Mask b) { return vorrq_u64(a, b); }
+	static Mask andnot(Mask a, Mask b) { return vbicq_u64(a, b); }
+	static Type blend(Mask m, Type a, Type b) { return vbslq_f64(m, a, b); }
+	static int bits(Mask m) { return (int)(vgetq_lane_u64(m, 0) & 1) | (int)((vgetq_lane_u64(m, 1) & 1) << 1); }
+	static void add_shifts(int64_t *r, Type a) { vst1q_s64(r, vaddq_s64(vld1q_s64(r), vcvtq_s64_f64(a))); }
+
+	using Int = int64x2_t;
+	static Int load_int(const int64_t *p) { return vld1q_s64(p); }
+	static Int set1_int(int64_t v) { return vdupq_n_s64(v); }
+	static Int add_int(Int a, Int b) { return vaddq_s64(a, b); }
+	static Int sub_int(Int a, Int b) { return vsubq_s64(a, b); }
+	static Int gt_int(Int a, Int b) { return vreinterpretq_s64_u64(vcgtq_s64(a, b)); }
+	static Int eq_int(Int a, Int b) { return vreinterpretq_s64_u64(vceqq_s64(a, b)); }
+	static Int and_int(Int a, Int b) { return vandq_s64(a, b); }
+	static Int or_int(Int a, Int b) { return vorrq_s64(a, b); }
+	static Int andnot_int(Int a, Int b) { return vbicq_s64(a, b); }
+	static int bits_int(Int m) { return bits(vreinterpretq_u64_s64(m)); }
+	static Int to_int(Mask m) { return vreinterpretq_s64_u64(m); }
+	static Type gather(const double *p, Int i) { return vsetq_lane_f64(p[vgetq_lane_s64(i, 1)], vdupq_n_f64(p[vgetq_lane_s64(i, 0)]), 1); }
+	static void store_results(int32_t *r, Int a) { vst1_s32(r, vmovn_s64(a)); }
+};
+
+const KernelTable simd_kernels = BIG_NUMBER_KERNEL_TABLE("neon", Neon);
+#elif defined(BIG_NUMBER_WASM_SIMD)
+struct WasmSimd {
+	using Type = v128_t;
+	using Mask = v128_t;
+	static constexpr int WIDTH = 2;
+
+	static Type load(const double *p) { return wasm_v128_load(p); }
+	static void store(double *r, Type a) { wasm_v128_store(r, a); }
+	static Type set1(double v) { return wasm_f64x2_splat(v); }
+	static Type add(Type a, Type b) { return wasm_f64x2_add(a, b); }
+	static Type sub(Type a, Type b) { return wasm_f64x2_sub(a, b); }
+	static Type mul(Type a, Type b) { return wasm_f64x2_mul(a, b); }
+	static Type div(Type a, Type b) { return wasm_f64x2_div(a, b); }
+	static Type abs(Type a) { return wasm_f64x2_abs(a); }
+	static Type neg(Type a) { return wasm_f64x2_neg(a); }
+	static Mask ge(Type a, Type b) { return wasm_f64x2_ge(a, b); }
+	static Mask gt(Type a, Type b) { return wasm_f64x2_gt(a, b); }
+	static Mask lt(Type a, Type b) { return wasm_f64x2_lt(a, b); }
+	static Mask eq(Type a, Type b) { return wasm_f64x2_eq(a, b); }
+	static Mask and_(Mask a, Mask b) { return wasm_v128_and(a, b); }
+	static Mask or_(Mask a, Mask b) { return wasm_v128_or(a, b); }
+	static Mask andnot(Mask a, Mask b) { return wasm_v128_andnot(a, b); }
+	static Type blend(Mask m, Type a, Type b) { return wasm_v128_bitselect(a, b, m); }
+	static int bits(Mask m) { return (int)(wasm_i64x2_extract_lane(m, 0) & 1) | (int)((wasm_i64x2_extract_lane(m, 1) & 1) << 1); }
+	static void add_shifts(int64_t *r, Type a) {
+		v128_t shifts = wasm_i64x2_extend_low_i32x4(wasm_i32x4_trunc_sat_f64x2_zero(a));
+		wasm_v128_store(r, wasm_i64x2_add(wasm_v128_load(r), shifts));
+	}
+
+	using Int = v128_t;
+	static Int load_int(const int64_t *p) { return wasm_v128_load(p); }
+	static Int set1_int(int64_t v) { return wasm_i64x2_splat(v); }
+	static Int add_int(Int a, Int b) { return wasm_i64x2_add(a, b); }
+	static Int sub_int(Int a, Int b) { return wasm_i64x2_sub(a, b); }
+	static Int gt_int(Int a, Int b) { return wasm_i64x2_gt(a, b); }
+	static Int eq_int(Int a, Int b) { return wasm_i64x2_eq(a, b); }
+	static Int and_int(Int a, Int b) { return wasm_v128_and(a, b); }
+	static Int or_int(Int a, Int b) { return wasm_v128_or(a, b); }
+	static Int andnot_int(Int a, Int b) { return wasm_v128_andnot(a, b); }
+	static int bits_int(Int m) { return bits(m); }
+	static Int to_int(Mask m) { return m; }
+	static Type gather(const double *p, Int i) { return wasm_f64x2_make(p[wasm_i64x2_extract_lane(i, 0)], p[wasm_i64x2_extract_lane(i, 1)]); }
+	static void store_results(int32_t *r, Int a) {
+		r[0] = (int32_t)wasm_i64x2_extract_lane(a, 0);
+		r[1] = (int32_t)wasm_i64x2_extract_lane(a, 1);
+	}
+};
+
+const KernelTable simd_kernels = BIG_NUMBER_KERNEL_TABLE("wasm_simd128", WasmSimd);
+#endif
+
+#if defined(BIG_NUMBER_SSE2)
+bool cpu_has_avx2() {
+#if defined(BIG_NUMBER_CPU_SUPPORTS_BUILTIN)
+	return __builtin_cpu_supports("avx2");
+#elif defined(BIG_NUMBER_SSE2) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	// The OS must also save the YMM registers on context switches
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return false;
+#endif
+}
+#endif
+
+const KernelTable &select_kernels() {
+#if defined(BIG_NUMBER_SSE2)
+	const KernelTable *avx2 = get_avx2_kernels();
+	if (avx2 != nullptr && cpu_has_avx2()) {
+		return *avx2;
+	}
+#endif
+#if defined(BIG_NUMBER_SSE2) || defined(BIG_NUMBER_NEON) || defined(BIG_NUMBER_WASM_SIMD)
+	return simd_kernels;
+#else
+	return scalar_kernels;
+#endif
+}
+
+const KernelTable &get_kernels() {
+	static const KernelTable &kernels = select_kernels();
+	return kernels;
+}
+} // namespace
+} // namespace internal
+
+void normalize(double *r_mantissas, int64_t *r_exponents, int64_t p_count) {
+	internal::get_kernels().normalize(r_mantissas, r_exponents, p_count);
+}
+
+void add(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+	internal::get_kernels().add(r_mantissas, r_exponents, p_other, p_count);
+}
+
+void subtract(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+	internal::get_kernels().subtract(r_mantissas, r_exponents, p_other, p_count);
+}
+
+void multiply(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+	internal::get_kernels().multiply(r_mantissas, r_exponents, p_other, p_count);
+}
+
+bool divide(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+	return internal::get_kernels().divide(r_mantissas, r_exponents, p_other, p_count);
+}
+
+void compare(const double *p_mantissas, const int64_t *p_exponents, const Operand &p_other, int32_t *r_results, int64_t p_count) {
+	internal::get_kernels().compare(p_mantissas, p_exponents, p_other, r_results, p_count);
+}
+
+const char *get_kernel_name() {
+	return internal::get_kernels().name;
+}
+} // namespace BigNumberBatch
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+// Batched mantissa/exponent arithmetic over contiguous arrays.
+// Uses SIMD kernels where the CPU has them (SSE2 or AVX2 on x86-64, NEON on
+// ARM64, SIMD128 on WebAssembly) and the BigNumberCore functions otherwise.
+// Every kernel produces results bit-identical to calling the BigNumberCore
+// function on each element. Define BIG_NUMBER_NO_SIMD to only build the
+// scalar path.
+namespace BigNumberBatch {
+// Right-hand side of a batch operation: one value per element, or a single
+// value applied to every element
+struct Operand {
+	const double *mantissas = nullptr;
+	const int64_t *exponents = nullptr;
+	double mantissa = 0.0;
+	int64_t exponent = 0;
+
+	static Operand array(const double *p_mantissas, const int64_t *p_exponents) {
+		Operand res;
+		res.mantissas = p_mantissas;
+		res.exponents = p_exponents;
+		return res;
+	}
+
+	static Operand broadcast(double p_mantissa, int64_t p_exponent) {
+		Operand res;
+		res.mantissa = p_mantissa;
+		res.exponent = p_exponent;
+		return res;
+	}
+
+	bool is_array() const { return mantissas != nullptr; }
+};
+
+void normalize(double *r_mantissas, int64_t *r_exponents, int64_t p_count);
+void add(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count);
+void subtract(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count);
+void multiply(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count);
+// Returns false when any divisor is zero, those elements are left untouched
+bool divide(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count);
+// -1, 0 or 1 per element, same rules as BigNumberCore::is_less_than() and is_equal()
+void compare(const double *p_mantissas, const int64_t *p_exponents, const Operand &p_other, int32_t *r_results, int64_t p_count);
+
+// Name of the kernels picked for this CPU, e.g. "avx2" or "scalar"
+const char *get_kernel_name();
+} // namespace BigNumberBatch
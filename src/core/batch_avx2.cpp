@@ -0,0 +1,99 @@
+// AVX2 versions of the batch kernels, picked at runtime by batch.cpp.
+// Everything included before the target pragma is compiled for the
+// baseline instruction set, so the shared inline functions the linker may
+// pick from this file never require AVX2.
+#include "core/batch.hpp"
+#include "core/big_number_core.hpp"
+
+#include <cstdint>
+
+#if !defined(BIG_NUMBER_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define BIG_NUMBER_AVX2
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+#endif
+
+#include "core/batch_kernels.hpp"
+
+namespace BigNumberBatch {
+namespace internal {
+#if defined(BIG_NUMBER_AVX2)
+namespace {
+struct Avx2 {
+	using Type = __m256d;
+	using Mask = __m256d;
+	static constexpr int WIDTH = 4;
+
+	static Type load(const double *p) { return _mm256_loadu_pd(p); }
+	static void store(double *r, Type a) { _mm256_storeu_pd(r, a); }
+	static Type set1(double v) { return _mm256_set1_pd(v); }
+	static Type add(Type a, Type b) { return _mm256_add_pd(a, b); }
+	static Type sub(Type a, Type b) { return _mm256_sub_pd(a, b); }
+	static Type mul(Type a, Type b) { return _mm256_mul_pd(a, b); }
+	static Type div(Type a, Type b) { return _mm256_div_pd(a, b); }
+	static Type abs(Type a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+	static Type neg(Type a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+	static Mask ge(Type a, Type b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+	static Mask gt(Type a, Type b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+	static Mask lt(Type a, Type b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+	static Mask eq(Type a, Type b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+	static Mask and_(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+	static Mask or_(Mask a, Mask b) { return _mm256_or_pd(a, b); }
+	static Mask andnot(Mask a, Mask b) { return _mm256_andnot_pd(b, a); }
+	static Type blend(Mask m, Type a, Type b) { return _mm256_blendv_pd(b, a, m); }
+	static int bits(Mask m) { return _mm256_movemask_pd(m); }
+	static void add_shifts(int64_t *r, Type a) {
+		__m256i shifts = _mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(a));
+		__m256i *values = (__m256i *)r;
+		_mm256_storeu_si256(values, _mm256_add_epi64(_mm256_loadu_si256(values), shifts));
+	}
+
+	using Int = __m256i;
+	static Int load_int(const int64_t *p) { return _mm256_loadu_si256((const __m256i *)p); }
+	static Int set1_int(int64_t v) { return _mm256_set1_epi64x(v); }
+	static Int add_int(Int a, Int b) { return _mm256_add_epi64(a, b); }
+	static Int sub_int(Int a, Int b) { return _mm256_sub_epi64(a, b); }
+	static Int gt_int(Int a, Int b) { return _mm256_cmpgt_epi64(a, b); }
+	static Int eq_int(Int a, Int b) { return _mm256_cmpeq_epi64(a, b); }
+	static Int and_int(Int a, Int b) { return _mm256_and_si256(a, b); }
+	static Int or_int(Int a, Int b) { return _mm256_or_si256(a, b); }
+	static Int andnot_int(Int a, Int b) { return _mm256_andnot_si256(b, a); }
+	static int bits_int(Int m) { return _mm256_movemask_pd(_mm256_castsi256_pd(m)); }
+	static Int to_int(Mask m) { return _mm256_castpd_si256(m); }
+	static Type gather(const double *p, Int i) { return _mm256_i64gather_pd(p, i, 8); }
+	static void store_results(int32_t *r, Int a) {
+		// The low half of every int64 lane, packed into the low 128 bits
+		__m256i packed = _mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+		_mm_storeu_si128((__m128i *)r, _mm256_castsi256_si128(packed));
+	}
+};
+
+// Constant-initialized, no AVX2 code runs before the CPU check
+const KernelTable avx2_kernels = BIG_NUMBER_KERNEL_TABLE("avx2", Avx2);
+} // namespace
+#endif
+} // namespace internal
+} // namespace BigNumberBatch
+
+#if defined(BIG_NUMBER_AVX2)
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
+
+const BigNumberBatch::internal::KernelTable *BigNumberBatch::internal::get_avx2_kernels() {
+#if defined(BIG_NUMBER_AVX2)
+	return &avx2_kernels;
+#else
+	return nullptr;
+#endif
+}
@@ -0,0 +1,355 @@
+#pragma once
+
+#include "core/batch.hpp"
+#include "core/big_number_core.hpp"
+
+// Kernel templates behind batch.hpp, only included by the translation units
+// that instantiate them for one instruction set (see batch.cpp and
+// batch_avx2.cpp). V wraps the vector type:
+//   Type, Mask, WIDTH, load, store, set1, add, sub, mul, div, abs, neg,
+//   ge, gt, lt, eq, and_, or_, andnot (a & ~b), blend, bits, and add_shifts
+//   (adds the small whole numbers of a vector to int64 values).
+// add() and compare() also need the int64 lanes of Int: load_int,
+// set1_int, add_int, sub_int, gt_int, eq_int, and_int, or_int, andnot_int,
+// bits_int, to_int (from Mask), gather (table lookup) and store_results
+// (narrowed to int32). SSE2 has neither 64-bit compares nor gathers and
+// uses the scalar loops for those.
+// Only the mantissa math is vectorized. Exponents stay int64 and are updated
+// per lane, and any lane the vector path cannot reproduce exactly (zero,
+// NaN, infinity, or more than two decades away from [1, 10)) is redone with
+// the scalar BigNumberCore function. The one thing that can differ is the
+// sign of a NaN, which the scalar path itself does not keep consistently
+// once the compiler folds a + (-b) into a - b.
+namespace BigNumberBatch {
+namespace internal {
+struct KernelTable {
+	const char *name;
+	void (*normalize)(double *, int64_t *, int64_t);
+	void (*add)(double *, int64_t *, const Operand &, int64_t);
+	void (*subtract)(double *, int64_t *, const Operand &, int64_t);
+	void (*multiply)(double *, int64_t *, const Operand &, int64_t);
+	bool (*divide)(double *, int64_t *, const Operand &, int64_t);
+	void (*compare)(const double *, const int64_t *, const Operand &, int32_t *, int64_t);
+};
+
+// Defined in batch_avx2.cpp, null when the build has no AVX2 kernels
+const KernelTable *get_avx2_kernels();
+
+struct ArraySource {
+	const double *mantissas;
+	const int64_t *exponents;
+
+	template <typename V>
+	typename V::Type load(int64_t p_index) const { return V::load(mantissas + p_index); }
+	template <typename V>
+	typename V::Int load_exponents(int64_t p_index) const { return V::load_int(exponents + p_index); }
+	double mantissa(int64_t p_index) const { return mantissas[p_index]; }
+	int64_t exponent(int64_t p_index) const { return exponents[p_index]; }
+};
+
+struct BroadcastSource {
+	double value_mantissa;
+	int64_t value_exponent;
+
+	template <typename V>
+	typename V::Type load(int64_t) const { return V::set1(value_mantissa); }
+	template <typename V>
+	typename V::Int load_exponents(int64_t) const { return V::set1_int(value_exponent); }
+	double mantissa(int64_t) const { return value_mantissa; }
+	int64_t exponent(int64_t) const { return value_exponent; }
+};
+
+template <typename V>
+struct Kernels {
+	using T = typename V::Type;
+	using M = typename V::Mask;
+	static constexpr int W = V::WIDTH;
+
+#if defined(__FP_FAST_FMA)
+	// The compiler may fuse a + b * 10^n into one rounding in BigNumberCore::add(),
+	// only sums of equal exponents are then computed the same way here
+	static constexpr bool FUSED_SCALAR_ADD = true;
+#else
+	static constexpr bool FUSED_SCALAR_ADD = false;
+#endif
+
+	// Vector version of BigNumberCore::normalize() for the mantissa part.
+	// Handles results within one decade of [1, 10), which covers every
+	// product and quotient of normalized values, or two decades with WIDE
+	// for sums of values with nearby exponents. Returns the lanes that must
+	// take the scalar path.
+	template <bool WIDE>
+	static int normalize_lanes(T p_raw, T &r_mantissas, T &r_shifts) {
+		using PowerOfTen::internal::FAST_MIN;
+		// boundaries[i] is the first value PowerOfTen::floor_log10() maps to FAST_MIN + i
+		const double *b = PowerOfTen::internal::tables.boundaries;
+
+		T a = V::abs(p_raw);
+		M from_minus_one = V::ge(a, V::set1(b[-1 - FAST_MIN]));
+		M from_zero = V::ge(a, V::set1(b[0 - FAST_MIN]));
+		M from_one = V::ge(a, V::set1(b[1 - FAST_MIN]));
+		M from_two = V::ge(a, V::set1(b[2 - FAST_MIN]));
+
+		r_shifts = V::blend(from_one, V::set1(1.0), V::blend(from_zero, V::set1(0.0), V::set1(-1.0)));
+		T divisor = V::blend(from_one, V::set1(PowerOfTen::get(1)), V::blend(from_zero, V::set1(1.0), V::set1(PowerOfTen::get(-1))));
+
+		int in_range;
+		if (WIDE) {
+			M from_minus_two = V::ge(a, V::set1(b[0]));
+			M from_three = V::ge(a, V::set1(b[3 - FAST_MIN]));
+			r_shifts = V::blend(from_two, V::set1(2.0), V::blend(from_minus_one, r_shifts, V::set1(-2.0)));
+			divisor = V::blend(from_two, V::set1(PowerOfTen::get(2)), V::blend(from_minus_one, divisor, V::set1(PowerOfTen::get(-2))));
+			in_range = V::bits(V::andnot(from_minus_two, from_three));
+		} else {
+			in_range = V::bits(V::andnot(from_minus_one, from_two));
+		}
+		r_mantissas = V::div(a, divisor);
+
+		// normalize() leaves [1, 10) alone. Should the log-based boundaries
+		// not fall exactly on 1 and 10, the lanes in between are left to it.
+		M unit = V::and_(V::ge(a, V::set1(1.0)), V::lt(a, V::set1(10.0)));
+		M mismatch = V::andnot(unit, V::andnot(from_zero, from_one));
+
+		// Zero, NaN and infinity are never in range
+		return (~in_range | V::bits(mismatch)) & ((1 << W) - 1);
+	}
+
+	// Writes one block normalized by normalize_lanes(). Lanes in p_slow are
+	// normalized from p_raw by the scalar path, lanes in p_skip are left as is.
+	static void store_lanes(double *r_mantissas, int64_t *r_exponents, T p_raw, T p_mantissas, T p_shifts, int p_slow, int p_skip) {
+		if ((p_slow | p_skip) == 0) {
+			V::store(r_mantissas, p_mantissas);
+			V::add_shifts(r_exponents, p_shifts);
+			return;
+		}
+
+		double raw[W], res[W], shifts[W];
+		V::store(raw, p_raw);
+		V::store(res, p_mantissas);
+		V::store(shifts, p_shifts);
+		for (int l = 0; l < W; l++) {
+			if (p_skip & (1 << l)) {
+				continue;
+			}
+			if (p_slow & (1 << l)) {
+				r_mantissas[l] = raw[l];
+				BigNumberCore::normalize(r_mantissas[l], r_exponents[l]);
+			} else {
+				r_mantissas[l] = res[l];
+				r_exponents[l] += (int64_t)shifts[l];
+			}
+		}
+	}
+
+	static void normalize(double *r_mantissas, int64_t *r_exponents, int64_t p_count) {
+		int64_t i = 0;
+		for (; i + W <= p_count; i += W) {
+			T raw = V::load(r_mantissas + i);
+			T res, shifts;
+			int slow = normalize_lanes<false>(raw, res, shifts);
+			store_lanes(r_mantissas + i, r_exponents + i, raw, res, shifts, slow, 0);
+		}
+		for (; i < p_count; i++) {
+			BigNumberCore::normalize(r_mantissas[i], r_exponents[i]);
+		}
+	}
+
+	template <bool NEGATE, typename S>
+	static void add(double *r_mantissas, int64_t *r_exponents, const S &p_other, int64_t p_count) {
+		using I = typename V::Int;
+		// powers[n] is PowerOfTen::get(n)
+		const double *powers = PowerOfTen::internal::tables.powers - PowerOfTen::MIN_EXPONENT;
+		const I zero = V::set1_int(0);
+
+		int64_t i = 0;
+		for (; i + W <= p_count; i += W) {
+			// Same scaling as BigNumberCore::add(). Multiplying or dividing by
+			// exactly 1.0 (10^0) is a no-op, so one expression covers every case.
+			I exp_diff = V::sub_int(p_other.template load_exponents<V>(i), V::load_int(r_exponents + i));
+			I up = V::and_int(V::gt_int(exp_diff, zero), V::gt_int(V::set1_int(248), exp_diff));
+			I down = V::and_int(V::gt_int(zero, exp_diff), V::gt_int(exp_diff, V::set1_int(-248)));
+			I scaled_lanes = V::andnot_int(V::set1_int(-1), V::eq_int(exp_diff, zero));
+			if (!FUSED_SCALAR_ADD) {
+				scaled_lanes = V::andnot_int(scaled_lanes, V::or_int(up, down));
+			}
+			// Lanes where one side is too small to matter, or where the sum may be fused
+			int special = V::bits_int(scaled_lanes);
+
+			T multipliers = V::gather(powers, V::and_int(up, exp_diff));
+			T divisors = V::gather(powers, V::and_int(down, V::sub_int(zero, exp_diff)));
+
+			T other = p_other.template load<V>(i);
+			if (NEGATE) {
+				other = V::neg(other);
+			}
+			T raw = V::add(V::load(r_mantissas + i), V::div(V::mul(other, multipliers), divisors));
+			T res, shifts;
+			int slow = normalize_lanes<true>(raw, res, shifts);
+			store_lanes(r_mantissas + i, r_exponents + i, raw, res, shifts, slow, special);
+
+			if (special) {
+				for (int l = 0; l < W; l++) {
+					if (special & (1 << l)) {
+						double other_mantissa = NEGATE ? -p_other.mantissa(i + l) : p_other.mantissa(i + l);
+						BigNumberCore::add(r_mantissas[i + l], r_exponents[i + l], other_mantissa, p_other.exponent(i + l));
+					}
+				}
+			}
+		}
+		for (; i < p_count; i++) {
+			double other_mantissa = NEGATE ? -p_other.mantissa(i) : p_other.mantissa(i);
+			BigNumberCore::add(r_mantissas[i], r_exponents[i], other_mantissa, p_other.exponent(i));
+		}
+	}
+
+	template <typename S>
+	static void multiply(double *r_mantissas, int64_t *r_exponents, const S &p_other, int64_t p_count) {
+		int64_t i = 0;
+		for (; i + W <= p_count; i += W) {
+			T raw = V::mul(V::load(r_mantissas + i), p_other.template load<V>(i));
+			T res, shifts;
+			int slow = normalize_lanes<false>(raw, res, shifts);
+			for (int l = 0; l < W; l++) {
+				r_exponents[i + l] += p_other.exponent(i + l);
+			}
+			store_lanes(r_mantissas + i, r_exponents + i, raw, res, shifts, slow, 0);
+		}
+		for (; i < p_count; i++) {
+			BigNumberCore::multiply(r_mantissas[i], r_exponents[i], p_other.mantissa(i), p_other.exponent(i));
+		}
+	}
+
+	template <typename S>
+	static bool divide(double *r_mantissas, int64_t *r_exponents, const S &p_other, int64_t p_count) {
+		bool ok = true;
+		int64_t i = 0;
+		for (; i + W <= p_count; i += W) {
+			T other = p_other.template load<V>(i);
+			// Division by zero leaves the element untouched
+			int zero = V::bits(V::eq(other, V::set1(0.0)));
+			if (zero) {
+				ok = false;
+			}
+
+			T raw = V::div(V::load(r_mantissas + i), other);
+			T res, shifts;
+			int slow = normalize_lanes<false>(raw, res, shifts);
+			for (int l = 0; l < W; l++) {
+				if (!(zero & (1 << l))) {
+					r_exponents[i + l] -= p_other.exponent(i + l);
+				}
+			}
+			store_lanes(r_mantissas + i, r_exponents + i, raw, res, shifts, slow, zero);
+		}
+		for (; i < p_count; i++) {
+			if (!BigNumberCore::divide(r_mantissas[i], r_exponents[i], p_other.mantissa(i), p_other.exponent(i))) {
+				ok = false;
+			}
+		}
+		return ok;
+	}
+
+	template <typename S>
+	static void compare(const double *p_mantissas, const int64_t *p_exponents, const S &p_other, int32_t *r_results, int64_t p_count) {
+		using I = typename V::Int;
+		const T epsilon = V::set1(BigNumberCore::CMP_EPSILON);
+		const I one = V::set1_int(1);
+		int64_t i = 0;
+		for (; i + W <= p_count; i += W) {
+			T m = V::load(p_mantissas + i);
+			T om = p_other.template load<V>(i);
+			I e = V::load_int(p_exponents + i);
+			I oe = p_other.template load_exponents<V>(i);
+
+			// Every test of is_less_than() and is_equal(), in the same operand order
+			I zero = V::to_int(V::eq(m, V::set1(0.0)));
+			I other_positive = V::to_int(V::gt(om, V::set1(0.0)));
+			I above_next = V::to_int(V::gt(m, V::mul(V::set1(10.0), om)));
+			I less = V::to_int(V::lt(m, om));
+			I below_previous = V::to_int(V::lt(V::mul(m, V::set1(10.0)), om));
+
+			T tolerance = V::mul(epsilon, V::abs(om));
+			tolerance = V::blend(V::lt(tolerance, epsilon), epsilon, tolerance);
+			I approx = V::to_int(V::or_(V::eq(om, m), V::lt(V::abs(V::sub(om, m)), tolerance)));
+
+			I lower = V::gt_int(oe, e);
+			I same = V::eq_int(e, oe);
+			I higher = V::andnot_int(V::andnot_int(V::set1_int(-1), lower), same);
+			// e == oe - 1 and e == oe + 1, written without the subtraction
+			I previous = V::eq_int(V::add_int(e, one), oe);
+			I next = V::eq_int(e, V::add_int(oe, one));
+
+			I is_less = V::or_int(V::andnot_int(lower, V::and_int(previous, above_next)), V::and_int(same, less));
+			is_less = V::or_int(is_less, V::and_int(higher, V::and_int(next, below_previous)));
+			is_less = V::or_int(V::and_int(zero, other_positive), V::andnot_int(is_less, zero));
+			I is_equal = V::andnot_int(V::and_int(same, approx), is_less);
+
+			// Masks are -1: 1 - 2 for less than, 1 - 1 for equal
+			V::store_results(r_results + i, V::add_int(one, V::add_int(V::add_int(is_less, is_less), is_equal)));
+		}
+		for (; i < p_count; i++) {
+			double om = p_other.mantissa(i);
+			int64_t oe = p_other.exponent(i);
+			if (BigNumberCore::is_less_than(p_mantissas[i], p_exponents[i], om, oe)) {
+				r_results[i] = -1;
+			} else if (BigNumberCore::is_equal(p_mantissas[i], p_exponents[i], om, oe)) {
+				r_results[i] = 0;
+			} else {
+				r_results[i] = 1;
+			}
+		}
+	}
+
+	// Entry points matching KernelTable, resolving the operand kind once per call
+
+	static void add_entry(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+		if (p_other.is_array()) {
+			add<false>(r_mantissas, r_exponents, ArraySource{ p_other.mantissas, p_other.exponents }, p_count);
+		} else {
+			add<false>(r_mantissas, r_exponents, BroadcastSource{ p_other.mantissa, p_other.exponent }, p_count);
+		}
+	}
+
+	static void subtract_entry(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+		if (p_other.is_array()) {
+			add<true>(r_mantissas, r_exponents, ArraySource{ p_other.mantissas, p_other.exponents }, p_count);
+		} else {
+			add<true>(r_mantissas, r_exponents, BroadcastSource{ p_other.mantissa, p_other.exponent }, p_count);
+		}
+	}
+
+	static void multiply_entry(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+		if (p_other.is_array()) {
+			multiply(r_mantissas, r_exponents, ArraySource{ p_other.mantissas, p_other.exponents }, p_count);
+		} else {
+			multiply(r_mantissas, r_exponents, BroadcastSource{ p_other.mantissa, p_other.exponent }, p_count);
+		}
+	}
+
+	static bool divide_entry(double *r_mantissas, int64_t *r_exponents, const Operand &p_other, int64_t p_count) {
+		if (p_other.is_array()) {
+			return divide(r_mantissas, r_exponents, ArraySource{ p_other.mantissas, p_other.exponents }, p_count);
+		}
+		return divide(r_mantissas, r_exponents, BroadcastSource{ p_other.mantissa, p_other.exponent }, p_count);
+	}
+
+	static void compare_entry(const double *p_mantissas, const int64_t *p_exponents, const Operand &p_other, int32_t *r_results, int64_t p_count) {
+		if (p_other.is_array()) {
+			compare(p_mantissas, p_exponents, ArraySource{ p_other.mantissas, p_other.exponents }, r_results, p_count);
+		} else {
+			compare(p_mantissas, p_exponents, BroadcastSource{ p_other.mantissa, p_other.exponent }, r_results, p_count);
+		}
+	}
+
+};
+} // namespace internal
+} // namespace BigNumberBatch
+
+// Aggregate initializer of a KernelTable for Kernels<V>, usable for constant
+// initialization
+#define BIG_NUMBER_KERNEL_TABLE(m_name, m_vector)                                                                       \
+	{                                                                                                                   \
+		m_name, &BigNumberBatch::internal::Kernels<m_vector>::normalize, &BigNumberBatch::internal::Kernels<m_vector>::add_entry, \
+				&BigNumberBatch::internal::Kernels<m_vector>::subtract_entry, &BigNumberBatch::internal::Kernels<m_vector>::multiply_entry, \
+				&BigNumberBatch::internal::Kernels<m_vector>::divide_entry, &BigNumberBatch::internal::Kernels<m_vector>::compare_entry \
+	}
@@ -0,0 +1,417 @@
+#pragma once
+
+#include "core/instrumentation.hpp"
+#include "core/power_of_ten.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+// Engine-independent mantissa/exponent math behind BigNumber.
+// Header-only and free of Godot types, so it can be built and benchmarked
+// on its own (see benchmark/). Every function reproduces the Godot Math and
+// String calls it replaces, results are bit-identical.
+namespace BigNumberCore {
+using PowerOfTen::LOG_10;
+
+// Math::is_equal_approx()
+constexpr double CMP_EPSILON = 0.00001;
+
+// Large enough for any num() output
+constexpr int NUM_BUFFER_SIZE = 256;
+
+// String::num() caps the decimals to this
+constexpr int NUM_MAX_DECIMALS = 32;
+
+inline bool is_equal_approx(double p_left, double p_right) {
+	if (p_left == p_right) {
+		return true;
+	}
+	double tolerance = CMP_EPSILON * std::fabs(p_left);
+	if (tolerance < CMP_EPSILON) {
+		tolerance = CMP_EPSILON;
+	}
+	return std::fabs(p_left - p_right) < tolerance;
+}
+
+// Math::snapped()
+inline double snapped(double p_value, double p_step) {
+	if (p_step != 0) {
+		p_value = std::floor(p_value / p_step + 0.5) * p_step;
+	}
+	return p_value;
+}
+
+inline void normalize(double &r_mantissa, int64_t &r_exponent) {
+	BIG_NUMBER_COUNT(COUNTER_NORMALIZE);
+	if (r_mantissa == 0.0) {
+		r_exponent = 0;
+		return;
+	}
+
+	// Handle signs
+	bool is_negative = r_mantissa < 0.0;
+	if (is_negative) {
+		r_mantissa = -r_mantissa;
+	}
+
+	if (r_mantissa >= 10.0 || r_mantissa < 1.0) {
+		int64_t exp_change = PowerOfTen::floor_log10(r_mantissa);
+
+		r_exponent += exp_change;
+		r_mantissa /= PowerOfTen::get(exp_change);
+	}
+}
+
+inline void add(double &r_mantissa, int64_t &r_exponent, double p_mantissa, int64_t p_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	int64_t exp_diff = p_exponent - r_exponent;
+
+	if (exp_diff == 0) {
+		r_mantissa += p_mantissa;
+	} else if (exp_diff > 0) {
+		if (exp_diff >= 248) {
+			r_mantissa = p_mantissa;
+			r_exponent = p_exponent;
+		} else {
+			double scaled_mantissa = p_mantissa * PowerOfTen::get(exp_diff);
+			r_mantissa += scaled_mantissa;
+		}
+	} else {
+		if (-exp_diff >= 248) {
+			// Other too small
+		} else {
+			double scaled_mantissa = p_mantissa / PowerOfTen::get(-exp_diff);
+			r_mantissa += scaled_mantissa;
+		}
+	}
+
+	normalize(r_mantissa, r_exponent);
+}
+
+inline void multiply(double &r_mantissa, int64_t &r_exponent, double p_mantissa, int64_t p_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	r_exponent += p_exponent;
+	r_mantissa *= p_mantissa;
+
+	normalize(r_mantissa, r_exponent);
+}
+
+// Returns false and leaves the value untouched when dividing by zero
+inline bool divide(double &r_mantissa, int64_t &r_exponent, double p_mantissa, int64_t p_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	if (p_mantissa == 0.0) {
+		return false;
+	}
+
+	r_exponent -= p_exponent;
+	r_mantissa /= p_mantissa;
+
+	normalize(r_mantissa, r_exponent);
+	return true;
+}
+
+inline void power_int(double &r_mantissa, int64_t &r_exponent, int64_t p_power) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	if (p_power == 0) {
+		r_mantissa = 1.0;
+		r_exponent = 0;
+		return;
+	}
+
+	// Same as the GDScript version, negative powers are not special-cased
+	int64_t new_exponent = r_exponent * p_power;
+	double new_mantissa = std::pow(r_mantissa, (double)p_power);
+
+	r_mantissa = new_mantissa;
+	r_exponent = new_exponent;
+	normalize(r_mantissa, r_exponent);
+}
+
+inline void power_float(double &r_mantissa, int64_t &r_exponent, double p_power) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	if (r_mantissa == 0.0) {
+		return;
+	}
+
+	double log_val = (double)r_exponent + (std::log(r_mantissa) / LOG_10);
+	double new_log = log_val * p_power;
+
+	int64_t new_exponent = (int64_t)std::floor(new_log);
+	double remainder = new_log - (double)new_exponent;
+	double new_mantissa = std::pow(10.0, remainder);
+
+	r_exponent = new_exponent;
+	r_mantissa = new_mantissa;
+	normalize(r_mantissa, r_exponent);
+}
+
+inline bool is_less_than(double p_mantissa, int64_t p_exponent, double p_other_mantissa, int64_t p_other_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_COMPARISON);
+	if (p_mantissa == 0.0) {
+		return p_other_mantissa > 0.0; // 0 < 0 is false
+	}
+
+	if (p_exponent < p_other_exponent) {
+		if (p_exponent == p_other_exponent - 1 && p_mantissa > 10.0 * p_other_mantissa) {
+			return false;
+		}
+		return true;
+	} else if (p_exponent == p_other_exponent) {
+		return p_mantissa < p_other_mantissa;
+	} else {
+		if (p_exponent == p_other_exponent + 1 && p_mantissa * 10.0 < p_other_mantissa) {
+			return true;
+		}
+		return false;
+	}
+}
+
+inline bool is_equal(double p_mantissa, int64_t p_exponent, double p_other_mantissa, int64_t p_other_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_COMPARISON);
+	return p_other_exponent == p_exponent && is_equal_approx(p_other_mantissa, p_mantissa);
+}
+
+inline void floor(double &r_mantissa, int64_t &r_exponent) {
+	if (r_exponent == 0) {
+		r_mantissa = std::floor(r_mantissa);
+	} else if (r_exponent < 0) {
+		r_mantissa = 0.0;
+		r_exponent = 0;
+	} else {
+		// If exponent is positive but small enough to have fractional parts visible in double precision
+		if (r_exponent < 16) {
+			double val = r_mantissa * PowerOfTen::get(r_exponent);
+			val = std::floor(val);
+			// Re-assigning from float will re-normalize
+			r_mantissa = val;
+			r_exponent = 0;
+			normalize(r_mantissa, r_exponent);
+		}
+		// Else: assume integer
+	}
+}
+
+// this - floor(this / n) * n. Returns false when n is zero, the result is
+// then computed with the quotient left undivided, as before.
+inline bool mod(double &r_mantissa, int64_t &r_exponent, double p_mantissa, int64_t p_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	double quot_mantissa = r_mantissa;
+	int64_t quot_exponent = r_exponent;
+	bool divided = divide(quot_mantissa, quot_exponent, p_mantissa, p_exponent);
+	floor(quot_mantissa, quot_exponent);
+	multiply(quot_mantissa, quot_exponent, p_mantissa, p_exponent);
+
+	add(r_mantissa, r_exponent, -quot_mantissa, quot_exponent);
+	return divided;
+}
+
+inline void square_root(double &r_mantissa, int64_t &r_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	if (r_exponent % 2 == 0) {
+		r_mantissa = std::sqrt(r_mantissa);
+		r_exponent = r_exponent / 2;
+	} else {
+		r_mantissa = std::sqrt(r_mantissa * 10.0);
+		r_exponent = (r_exponent - 1) / 2;
+	}
+
+	normalize(r_mantissa, r_exponent);
+}
+
+// r += p * factor. Both factors are brought into [1, 10) first, so the
+// product is in [1, 100) with its real exponent and can neither overflow nor
+// be added at the wrong scale. The product itself is not normalized, so the
+// value is normalized once instead of after the multiply and again after the
+// add. The sign is kept, a negative factor subtracts.
+inline void fma(double &r_mantissa, int64_t &r_exponent, double p_mantissa, int64_t p_exponent, double p_factor_mantissa, int64_t p_factor_exponent) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	if (p_mantissa == 0.0 || p_factor_mantissa == 0.0) {
+		return;
+	}
+
+	bool is_negative = (p_mantissa < 0.0) != (p_factor_mantissa < 0.0);
+	normalize(p_mantissa, p_exponent);
+	normalize(p_factor_mantissa, p_factor_exponent);
+
+	double product = p_mantissa * p_factor_mantissa;
+	add(r_mantissa, r_exponent, is_negative ? -product : product, p_exponent + p_factor_exponent);
+}
+
+// r + (p - r) * weight, as r * (1 - weight) + p * weight with a single
+// normalize
+inline void lerp(double &r_mantissa, int64_t &r_exponent, double p_mantissa, int64_t p_exponent, double p_weight) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	double from = r_mantissa * (1.0 - p_weight);
+	double to = p_mantissa * p_weight;
+	if (from == 0.0) {
+		// Nothing to add to, keep the exponent of the other side
+		r_mantissa = to;
+		r_exponent = p_exponent;
+		normalize(r_mantissa, r_exponent);
+		return;
+	}
+	r_mantissa = from;
+	if (to == 0.0) {
+		normalize(r_mantissa, r_exponent);
+		return;
+	}
+	add(r_mantissa, r_exponent, to, p_exponent);
+}
+
+// Interpolation of the log10 of the magnitudes, r * (p / r)^weight. The
+// step is computed relative to r so large exponents keep their precision.
+// Falls back to lerp() when either side is zero.
+inline void lerp_log(double &r_mantissa, int64_t &r_exponent, double p_mantissa, int64_t p_exponent, double p_weight) {
+	BIG_NUMBER_PROFILE(GROUP_ARITHMETIC);
+	if (r_mantissa == 0.0 || p_mantissa == 0.0) {
+		lerp(r_mantissa, r_exponent, p_mantissa, p_exponent, p_weight);
+		return;
+	}
+
+	double from = std::fabs(r_mantissa);
+	double step = ((double)(p_exponent - r_exponent) + std::log10(std::fabs(p_mantissa) / from)) * p_weight;
+	double whole = std::floor(step);
+
+	r_mantissa = from * std::pow(10.0, step - whole);
+	r_exponent += (int64_t)whole;
+	normalize(r_mantissa, r_exponent);
+}
+
+inline double log10(double p_mantissa, int64_t p_exponent) {
+	return (double)p_exponent + (std::log(p_mantissa) / LOG_10);
+}
+
+inline double to_float(double p_mantissa, int64_t p_exponent) {
+	return p_mantissa * PowerOfTen::get(p_exponent);
+}
+
+// Decimals String::num() uses when none are given
+inline int default_decimals(double p_value) {
+	int decimals = 14;
+	double abs_value = std::fabs(p_value);
+	if (abs_value > 10) {
+		decimals -= (int)std::floor(std::log10(abs_value));
+	}
+	return decimals;
+}
+
+namespace internal {
+// Exact powers of ten, as double and as integer
+constexpr double EXACT_POWERS[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+constexpr uint64_t INTEGER_POWERS[] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+	100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+	10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL
+};
+constexpr int MAX_FIXED_DECIMALS = 16;
+
+// Writes p_value in "%.*f" form from one integer rounding, which is exact as
+// long as the scaled value stays below 2^53. Returns 0 when the scaled value
+// is too large or too close to a tie to be sure to round like printf(),
+// which rounds the exact binary value.
+inline int write_fixed(double p_value, int p_decimals, char *r_buffer) {
+	if (p_decimals > MAX_FIXED_DECIMALS) {
+		return 0;
+	}
+	double abs_value = std::fabs(p_value);
+	double scale = EXACT_POWERS[p_decimals];
+	double scaled = abs_value * scale;
+	if (!(scaled < 9007199254740992.0)) {
+		return 0;
+	}
+
+	// abs_value * scale is exactly scaled + error. nearbyint() keeps the
+	// difference to the whole value exact, so the rounding can only differ
+	// when the error reaches across the tie.
+	double error = std::fma(abs_value, scale, -scaled);
+	double whole = std::nearbyint(scaled);
+	double tie_distance = std::fabs(std::fabs(scaled - whole) - 0.5);
+	if (tie_distance <= std::fabs(error)) {
+		return 0; // Exact ties included, printf() is platform-specific there
+	}
+
+	uint64_t digits = (uint64_t)whole;
+	uint64_t integer = digits / INTEGER_POWERS[p_decimals];
+	uint64_t fraction = digits % INTEGER_POWERS[p_decimals];
+
+	int length = 0;
+	if (std::signbit(p_value)) {
+		r_buffer[length++] = '-';
+	}
+	char reversed[20];
+	int count = 0;
+	do {
+		reversed[count++] = (char)('0' + integer % 10);
+		integer /= 10;
+	} while (integer > 0);
+	while (count > 0) {
+		r_buffer[length++] = reversed[--count];
+	}
+	if (p_decimals > 0) {
+		r_buffer[length++] = '.';
+		for (int i = p_decimals - 1; i >= 0; i--) {
+			r_buffer[length + i] = (char)('0' + fraction % 10);
+			fraction /= 10;
+		}
+		length += p_decimals;
+	}
+	r_buffer[length] = 0;
+	return length;
+}
+} // namespace internal
+
+// Digit generation, same output as String::num(p_value, p_decimals):
+// fixed notation with trailing zeroes and a trailing point removed.
+// r_buffer must hold NUM_BUFFER_SIZE chars. Returns the length.
+inline int num(double p_value, int p_decimals, char *r_buffer) {
+	if (std::isnan(p_value)) {
+		return snprintf(r_buffer, NUM_BUFFER_SIZE, "nan");
+	}
+	if (std::isinf(p_value)) {
+		return snprintf(r_buffer, NUM_BUFFER_SIZE, std::signbit(p_value) ? "-inf" : "inf");
+	}
+
+	if (p_decimals < 0) {
+		p_decimals = default_decimals(p_value);
+	}
+	if (p_decimals > NUM_MAX_DECIMALS) {
+		p_decimals = NUM_MAX_DECIMALS;
+	}
+
+	// "%lf" prints 6 decimals
+	int length = internal::write_fixed(p_value, p_decimals < 0 ? 6 : p_decimals, r_buffer);
+	if (length == 0) {
+		if (p_decimals < 0) {
+			length = snprintf(r_buffer, NUM_BUFFER_SIZE, "%lf", p_value);
+		} else {
+			length = snprintf(r_buffer, NUM_BUFFER_SIZE, "%.*lf", p_decimals, p_value);
+		}
+		if (length >= NUM_BUFFER_SIZE) {
+			length = NUM_BUFFER_SIZE - 1;
+		}
+	}
+
+	// Destroy trailing zeroes, and the point if nothing is left after it
+	bool period = false;
+	for (int i = 0; i < length; i++) {
+		if (r_buffer[i] == '.') {
+			period = true;
+			break;
+		}
+	}
+	if (period) {
+		while (length > 1 && r_buffer[length - 1] == '0') {
+			length--;
+		}
+		if (r_buffer[length - 1] == '.') {
+			length--;
+		}
+		r_buffer[length] = 0;
+	}
+	return length;
+}
+} // namespace BigNumberCore
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// Binary layout of BigNumber::to_bytes() and the batch encoders.
+// Header-only and free of Godot types, see big_number_core.hpp.
+//
+//   byte 0    format version, VERSION
+//   byte 1    KIND_VALUE or KIND_ARRAY
+//   array     element count, varint
+//   value     mantissa as the 8 little-endian bytes of the double, then
+//             the exponent as a zigzag varint (1 byte up to +-63)
+//
+// The mantissa bits are copied as is, so sign, zero and non-normalized
+// values round-trip exactly. Decoders keep reading every version they
+// ever wrote, a new layout gets a new version number. Decoders also reject
+// bytes after the value or the last element, so concatenated or corrupted
+// data is not read as valid.
+namespace BigNumberCodec {
+constexpr uint8_t VERSION = 1;
+
+constexpr uint8_t KIND_VALUE = 1;
+constexpr uint8_t KIND_ARRAY = 2;
+
+constexpr int HEADER_SIZE = 2;
+constexpr int MIN_VALUE_SIZE = 9;
+constexpr int MAX_VALUE_SIZE = 18;
+constexpr int MAX_VARINT_SIZE = 10;
+
+// LEB128, 7 bits per byte, lowest first. Returns the bytes written.
+inline int write_varint(uint8_t *r_buffer, uint64_t p_value) {
+	int length = 0;
+	while (p_value >= 0x80) {
+		r_buffer[length++] = (uint8_t)(p_value | 0x80);
+		p_value >>= 7;
+	}
+	r_buffer[length++] = (uint8_t)p_value;
+	return length;
+}
+
+// Returns the bytes read, or 0 if the data ends early or is too long
+inline int read_varint(const uint8_t *p_buffer, int64_t p_size, uint64_t &r_value) {
+	r_value = 0;
+	for (int i = 0; i < MAX_VARINT_SIZE && i < p_size; i++) {
+		r_value |= (uint64_t)(p_buffer[i] & 0x7F) << (7 * i);
+		if ((p_buffer[i] & 0x80) == 0) {
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+inline int write_value(uint8_t *r_buffer, double p_mantissa, int64_t p_exponent) {
+	uint64_t bits;
+	memcpy(&bits, &p_mantissa, sizeof(bits));
+	for (int i = 0; i < 8; i++) {
+		r_buffer[i] = (uint8_t)(bits >> (8 * i));
+	}
+
+	// Small exponents of either sign take one byte
+	uint64_t zigzag = ((uint64_t)p_exponent << 1) ^ (uint64_t)(p_exponent >> 63);
+	return 8 + write_varint(r_buffer + 8, zigzag);
+}
+
+// Returns the bytes read, or 0 if the data ends early
+inline int read_value(const uint8_t *p_buffer, int64_t p_size, double &r_mantissa, int64_t &r_exponent) {
+	if (p_size < MIN_VALUE_SIZE) {
+		return 0;
+	}
+
+	uint64_t bits = 0;
+	for (int i = 0; i < 8; i++) {
+		bits |= (uint64_t)p_buffer[i] << (8 * i);
+	}
+	memcpy(&r_mantissa, &bits, sizeof(bits));
+
+	uint64_t zigzag;
+	int length = read_varint(p_buffer + 8, p_size - 8, zigzag);
+	if (length == 0) {
+		return 0;
+	}
+	r_exponent = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+	return 8 + length;
+}
+
+inline int write_header(uint8_t *r_buffer, uint8_t p_kind) {
+	r_buffer[0] = VERSION;
+	r_buffer[1] = p_kind;
+	return HEADER_SIZE;
+}
+
+// Result of read_header()
+enum HeaderError {
+	HEADER_OK,
+	HEADER_TRUNCATED,
+	HEADER_UNKNOWN_VERSION,
+	HEADER_WRONG_KIND,
+};
+
+inline HeaderError read_header(const uint8_t *p_buffer, int64_t p_size, uint8_t p_kind) {
+	if (p_size < HEADER_SIZE) {
+		return HEADER_TRUNCATED;
+	}
+	// Version 1 is the only layout so far
+	if (p_buffer[0] != VERSION) {
+		return HEADER_UNKNOWN_VERSION;
+	}
+	if (p_buffer[1] != p_kind) {
+		return HEADER_WRONG_KIND;
+	}
+	return HEADER_OK;
+}
+
+inline const char *get_header_error_text(HeaderError p_error) {
+	switch (p_error) {
+		case HEADER_TRUNCATED:
+			return "Byte data is truncated.";
+		case HEADER_UNKNOWN_VERSION:
+			return "Byte data uses an unknown format version.";
+		case HEADER_WRONG_KIND:
+			return "Byte data holds a different kind of value.";
+		default:
+			return "";
+	}
+}
+} // namespace BigNumberCodec
@@ -0,0 +1,264 @@
+#pragma once
+
+#include "core/big_number_core.hpp"
+#include "core/log_domain.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+// Closed-form price of buying many levels at once, and the number of levels
+// a budget covers, behind the bulk-buy methods of BigNumber and
+// BigNumberArray. Header-only and free of Godot types, see big_number_core.hpp.
+//
+// Level k (0-based, counting owned levels) costs
+//   geometric: base * growth^k
+//   linear:    base + increment * k
+// Prices go through BigNumberCore::power_float(), multiply() and divide(),
+// so they match the same steps done with BigNumber methods.
+namespace BulkBuy {
+// Returned by the *_max functions when every count is affordable
+constexpr int64_t UNLIMITED = INT64_MAX;
+
+// Largest log10 still handled as a plain double
+constexpr double DOUBLE_LOG_LIMIT = 300.0;
+
+// Counts are clamped below this, the largest double under INT64_MAX
+constexpr double MAX_COUNT = 9.2e18;
+
+inline int64_t to_count(double p_count) {
+	if (!(p_count >= 0.0)) {
+		return 0; // Also NaN
+	}
+	if (p_count >= MAX_COUNT) {
+		return UNLIMITED;
+	}
+	return (int64_t)std::floor(p_count);
+}
+
+// (growth^n - 1) / (growth - 1), the price of n levels in units of the
+// first one. expm1() keeps it exact for growth close to 1. The division is
+// done on normalized parts, with growth within 1e-8 of 1 the quotient can
+// pass the double range while growth^n - 1 does not.
+inline void geometric_series(double p_growth, double p_count, double &r_mantissa, int64_t &r_exponent) {
+	r_exponent = 0;
+	if (p_growth == 1.0) {
+		r_mantissa = p_count;
+		BigNumberCore::normalize(r_mantissa, r_exponent);
+		return;
+	}
+
+	double ln_growth = std::log1p(p_growth - 1.0);
+	double log_power = p_count * ln_growth / BigNumberCore::LOG_10;
+	if (log_power < DOUBLE_LOG_LIMIT) {
+		r_mantissa = std::expm1(p_count * ln_growth);
+		BigNumberCore::normalize(r_mantissa, r_exponent);
+		double step_mantissa = p_growth - 1.0;
+		int64_t step_exponent = 0;
+		BigNumberCore::normalize(step_mantissa, step_exponent);
+		BigNumberCore::divide(r_mantissa, r_exponent, step_mantissa, step_exponent);
+		return;
+	}
+	// growth^n dwarfs the 1
+	LogDomain::to_parts(log_power - std::log10(p_growth - 1.0), r_mantissa, r_exponent);
+}
+
+// Price of level p_owned, base * growth^owned
+inline void geometric_price(double p_base_mantissa, int64_t p_base_exponent, double p_growth, int64_t p_owned, double &r_mantissa, int64_t &r_exponent) {
+	double growth_mantissa = p_growth;
+	int64_t growth_exponent = 0;
+	BigNumberCore::normalize(growth_mantissa, growth_exponent);
+	BigNumberCore::power_float(growth_mantissa, growth_exponent, (double)p_owned);
+
+	r_mantissa = p_base_mantissa;
+	r_exponent = p_base_exponent;
+	BigNumberCore::multiply(r_mantissa, r_exponent, growth_mantissa, growth_exponent);
+}
+
+// Price of levels p_owned to p_owned + p_count - 1, p_growth > 0
+inline void geometric_cost(double p_base_mantissa, int64_t p_base_exponent, double p_growth, int64_t p_owned, int64_t p_count, double &r_mantissa, int64_t &r_exponent) {
+	if (p_count <= 0) {
+		r_mantissa = 0.0;
+		r_exponent = 0;
+		return;
+	}
+	geometric_price(p_base_mantissa, p_base_exponent, p_growth, p_owned, r_mantissa, r_exponent);
+
+	double series_mantissa;
+	int64_t series_exponent;
+	geometric_series(p_growth, (double)p_count, series_mantissa, series_exponent);
+	BigNumberCore::multiply(r_mantissa, r_exponent, series_mantissa, series_exponent);
+}
+
+// Price of levels p_owned to p_owned + p_count - 1
+inline void linear_cost(double p_base_mantissa, int64_t p_base_exponent, double p_increment_mantissa, int64_t p_increment_exponent, int64_t p_owned, int64_t p_count, double &r_mantissa, int64_t &r_exponent) {
+	if (p_count <= 0) {
+		r_mantissa = 0.0;
+		r_exponent = 0;
+		return;
+	}
+
+	// n * (base + increment * owned) + increment * n * (n - 1) / 2
+	double first_mantissa = p_increment_mantissa;
+	int64_t first_exponent = p_increment_exponent;
+	double owned_mantissa = (double)p_owned;
+	int64_t owned_exponent = 0;
+	BigNumberCore::normalize(owned_mantissa, owned_exponent);
+	BigNumberCore::multiply(first_mantissa, first_exponent, owned_mantissa, owned_exponent);
+	BigNumberCore::add(first_mantissa, first_exponent, p_base_mantissa, p_base_exponent);
+
+	double count_mantissa = (double)p_count;
+	int64_t count_exponent = 0;
+	BigNumberCore::normalize(count_mantissa, count_exponent);
+	r_mantissa = first_mantissa;
+	r_exponent = first_exponent;
+	BigNumberCore::multiply(r_mantissa, r_exponent, count_mantissa, count_exponent);
+
+	double pairs_mantissa = (double)p_count * (double)(p_count - 1) * 0.5;
+	int64_t pairs_exponent = 0;
+	BigNumberCore::normalize(pairs_mantissa, pairs_exponent);
+	BigNumberCore::multiply(pairs_mantissa, pairs_exponent, p_increment_mantissa, p_increment_exponent);
+	BigNumberCore::add(r_mantissa, r_exponent, pairs_mantissa, pairs_exponent);
+}
+
+namespace internal {
+// A cost that left the double range (inf or NaN mantissa) never fits
+inline bool fits(double p_cost_mantissa, int64_t p_cost_exponent, double p_budget_mantissa, int64_t p_budget_exponent) {
+	return std::isfinite(p_cost_mantissa) && !BigNumberCore::is_less_than(p_budget_mantissa, p_budget_exponent, p_cost_mantissa, p_cost_exponent);
+}
+
+// Moves the closed-form estimate onto the exact boundary of p_cost(n) <= budget,
+// it is off by one at most when rounding lands next to an integer
+template <typename C>
+int64_t settle(int64_t p_count, const C &p_cost, double p_budget_mantissa, int64_t p_budget_exponent) {
+	if (p_count == UNLIMITED) {
+		return p_count;
+	}
+	double m;
+	int64_t e;
+	for (int i = 0; i < 2 && p_count > 0; i++) {
+		p_cost(p_count, m, e);
+		if (fits(m, e, p_budget_mantissa, p_budget_exponent)) {
+			break;
+		}
+		p_count--;
+	}
+	for (int i = 0; i < 2 && p_count < UNLIMITED; i++) {
+		p_cost(p_count + 1, m, e);
+		if (!fits(m, e, p_budget_mantissa, p_budget_exponent)) {
+			break;
+		}
+		p_count++;
+	}
+	return p_count;
+}
+
+// p_mantissa * 10^(p_exponent - p_unit), zero stays zero when the scale
+// overflows
+inline double scale_to(double p_mantissa, int64_t p_exponent, int64_t p_unit) {
+	if (p_mantissa == 0.0) {
+		return 0.0;
+	}
+	return p_mantissa * PowerOfTen::get(p_exponent - p_unit);
+}
+
+// p_value as a double, infinity past the double range
+inline double to_double(double p_mantissa, int64_t p_exponent) {
+	if (p_exponent > PowerOfTen::MAX_EXPONENT) {
+		return INFINITY;
+	}
+	return BigNumberCore::to_float(p_mantissa, p_exponent);
+}
+} // namespace internal
+
+// Largest n whose geometric_cost() fits the budget
+inline int64_t geometric_max(double p_base_mantissa, int64_t p_base_exponent, double p_growth, int64_t p_owned, double p_budget_mantissa, int64_t p_budget_exponent) {
+	if (p_budget_mantissa == 0.0) {
+		return 0;
+	}
+	if (p_base_mantissa == 0.0) {
+		return UNLIMITED;
+	}
+
+	// Budget in units of the next level's price
+	double ratio_mantissa = p_budget_mantissa;
+	int64_t ratio_exponent = p_budget_exponent;
+	double price_mantissa;
+	int64_t price_exponent;
+	geometric_price(p_base_mantissa, p_base_exponent, p_growth, p_owned, price_mantissa, price_exponent);
+	if (!BigNumberCore::divide(ratio_mantissa, ratio_exponent, price_mantissa, price_exponent)) {
+		return UNLIMITED; // The price underflowed to zero
+	}
+
+	// Solve ratio = (growth^n - 1) / (growth - 1) for n
+	double count;
+	if (p_growth == 1.0) {
+		count = internal::to_double(ratio_mantissa, ratio_exponent);
+	} else {
+		double ln_growth = std::log1p(p_growth - 1.0);
+		double scaled_mantissa = ratio_mantissa;
+		int64_t scaled_exponent = ratio_exponent;
+		double step_mantissa = std::fabs(p_growth - 1.0);
+		int64_t step_exponent = 0;
+		BigNumberCore::normalize(step_mantissa, step_exponent);
+		BigNumberCore::multiply(scaled_mantissa, scaled_exponent, step_mantissa, step_exponent);
+
+		if (p_growth < 1.0) {
+			// The series converges to 1 / (1 - growth)
+			double scaled = internal::to_double(scaled_mantissa, scaled_exponent);
+			if (scaled >= 1.0) {
+				return UNLIMITED;
+			}
+			count = std::log1p(-scaled) / ln_growth;
+		} else if (scaled_exponent < DOUBLE_LOG_LIMIT) {
+			count = std::log1p(BigNumberCore::to_float(scaled_mantissa, scaled_exponent)) / ln_growth;
+		} else {
+			count = BigNumberCore::log10(scaled_mantissa, scaled_exponent) * BigNumberCore::LOG_10 / ln_growth;
+		}
+	}
+
+	auto cost = [&](int64_t p_count, double &r_mantissa, int64_t &r_exponent) {
+		geometric_cost(p_base_mantissa, p_base_exponent, p_growth, p_owned, p_count, r_mantissa, r_exponent);
+	};
+	return internal::settle(to_count(count), cost, p_budget_mantissa, p_budget_exponent);
+}
+
+// Largest n whose linear_cost() fits the budget
+inline int64_t linear_max(double p_base_mantissa, int64_t p_base_exponent, double p_increment_mantissa, int64_t p_increment_exponent, int64_t p_owned, double p_budget_mantissa, int64_t p_budget_exponent) {
+	if (p_budget_mantissa == 0.0) {
+		return 0;
+	}
+
+	// Price of the next level
+	double first_mantissa = p_increment_mantissa;
+	int64_t first_exponent = p_increment_exponent;
+	double owned_mantissa = (double)p_owned;
+	int64_t owned_exponent = 0;
+	BigNumberCore::normalize(owned_mantissa, owned_exponent);
+	BigNumberCore::multiply(first_mantissa, first_exponent, owned_mantissa, owned_exponent);
+	BigNumberCore::add(first_mantissa, first_exponent, p_base_mantissa, p_base_exponent);
+
+	// Solve d/2 n^2 + (a - d/2) n = budget, in units of 10^budget_exponent
+	// so the budget itself is in [1, 10)
+	double budget = p_budget_mantissa;
+	double a = internal::scale_to(first_mantissa, first_exponent, p_budget_exponent);
+	double d = internal::scale_to(p_increment_mantissa, p_increment_exponent, p_budget_exponent);
+
+	double count;
+	if (d == 0.0) {
+		if (a == 0.0) {
+			return UNLIMITED;
+		}
+		count = budget / a;
+	} else {
+		// Stable root of the quadratic, no cancellation on either branch
+		double b = a - 0.5 * d;
+		double root = std::sqrt(b * b + 2.0 * d * budget);
+		count = b >= 0.0 ? 2.0 * budget / (b + root) : (root - b) / d;
+	}
+
+	auto cost = [&](int64_t p_count, double &r_mantissa, int64_t &r_exponent) {
+		linear_cost(p_base_mantissa, p_base_exponent, p_increment_mantissa, p_increment_exponent, p_owned, p_count, r_mantissa, r_exponent);
+	};
+	return internal::settle(to_count(count), cost, p_budget_mantissa, p_budget_exponent);
+}
+} // namespace BulkBuy
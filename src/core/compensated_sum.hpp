@@ -0,0 +1,159 @@
+#pragma once
+
+#include "core/power_of_ten.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+// Summation of many mantissa/exponent values without the precision loss of
+// repeated BigNumberCore::add(), behind BigNumberAccumulator.
+// Header-only and free of Godot types, see big_number_core.hpp.
+//
+// Values are kept in buckets keyed by their exact exponent, so adding one
+// never scales its mantissa. Each bucket is a Neumaier compensated sum, the
+// running compensation holds the low-order bits every addition rounds off.
+// Buckets are only scaled to a common exponent once, in get_total().
+namespace CompensatedSum {
+// Decades kept in separate buckets, below the highest exponent added so
+// far. Lower values are scaled into the lowest bucket, which is exact to
+// far more than the final double can hold.
+constexpr int64_t WINDOW = 64;
+
+// Neumaier's variant of Kahan summation, also exact when p_value is larger
+// than the running sum
+inline void add(double &r_sum, double &r_compensation, double p_value) {
+	double total = r_sum + p_value;
+	if (std::fabs(r_sum) >= std::fabs(p_value)) {
+		r_compensation += (r_sum - total) + p_value;
+	} else {
+		r_compensation += (p_value - total) + r_sum;
+	}
+	r_sum = total;
+}
+
+// Adds p_value * p_scale, the rounding error of the product goes to the
+// compensation
+inline void add_scaled(double &r_sum, double &r_compensation, double p_value, double p_scale) {
+	double product = p_value * p_scale;
+	r_compensation += std::fma(p_value, p_scale, -product);
+	add(r_sum, r_compensation, product);
+}
+
+struct Bucket {
+	double sum;
+	double compensation;
+};
+
+class Accumulator {
+public:
+	Accumulator() {
+		clear();
+	}
+
+	// p_mantissa is expected normalized, as BigNumber values are
+	void add(double p_mantissa, int64_t p_exponent) {
+		count++;
+		if (p_mantissa == 0.0) {
+			return;
+		}
+		if (has_values && p_exponent <= top && p_exponent > top - WINDOW) {
+			Bucket &bucket = buckets[p_exponent & (WINDOW - 1)];
+			CompensatedSum::add(bucket.sum, bucket.compensation, p_mantissa);
+			return;
+		}
+		_add_outside(p_mantissa, p_exponent);
+	}
+
+	// Result is not normalized, its exponent is the highest one added
+	void get_total(double &r_mantissa, int64_t &r_exponent) const {
+		r_mantissa = 0.0;
+		r_exponent = 0;
+		if (!has_values) {
+			return;
+		}
+
+		// Smallest first, scaled down to the highest exponent
+		double sum = 0.0;
+		double compensation = 0.0;
+		for (int64_t e = top - WINDOW + 1; e <= top; e++) {
+			const Bucket &bucket = buckets[e & (WINDOW - 1)];
+			if (bucket.sum == 0.0 && bucket.compensation == 0.0) {
+				continue;
+			}
+			double scale = PowerOfTen::get(e - top);
+			add_scaled(sum, compensation, bucket.sum, scale);
+			compensation += bucket.compensation * scale;
+		}
+		r_mantissa = sum + compensation;
+		r_exponent = top;
+	}
+
+	void clear() {
+		for (int64_t i = 0; i < WINDOW; i++) {
+			buckets[i] = { 0.0, 0.0 };
+		}
+		top = 0;
+		has_values = false;
+		count = 0;
+	}
+
+	bool is_empty() const {
+		return !has_values;
+	}
+
+	// Calls to add() since the last clear(), zeros included
+	int64_t get_count() const {
+		return count;
+	}
+
+private:
+	void _add_outside(double p_mantissa, int64_t p_exponent) {
+		if (!has_values) {
+			top = p_exponent;
+			has_values = true;
+		} else if (p_exponent > top) {
+			_raise_top(p_exponent);
+		} else {
+			// Too far below the highest value to get its own bucket
+			int64_t low = top - WINDOW + 1;
+			Bucket &bucket = buckets[low & (WINDOW - 1)];
+			add_scaled(bucket.sum, bucket.compensation, p_mantissa, PowerOfTen::get(p_exponent - low));
+			return;
+		}
+		Bucket &bucket = buckets[p_exponent & (WINDOW - 1)];
+		CompensatedSum::add(bucket.sum, bucket.compensation, p_mantissa);
+	}
+
+	// Slides the window up. Buckets leaving it are folded into the new
+	// lowest one, their slots are the ones the new exponents reuse.
+	void _raise_top(int64_t p_exponent) {
+		int64_t old_low = top - WINDOW + 1;
+		int64_t new_low = p_exponent - WINDOW + 1;
+		int64_t end = new_low < top + 1 ? new_low : top + 1;
+
+		double sum = 0.0;
+		double compensation = 0.0;
+		for (int64_t e = old_low; e < end; e++) {
+			Bucket &bucket = buckets[e & (WINDOW - 1)];
+			if (bucket.sum == 0.0 && bucket.compensation == 0.0) {
+				continue;
+			}
+			double scale = PowerOfTen::get(e - new_low);
+			add_scaled(sum, compensation, bucket.sum, scale);
+			compensation += bucket.compensation * scale;
+			bucket = { 0.0, 0.0 };
+		}
+
+		Bucket &low = buckets[new_low & (WINDOW - 1)];
+		CompensatedSum::add(low.sum, low.compensation, sum);
+		low.compensation += compensation;
+		top = p_exponent;
+	}
+
+	// Ring indexed by exponent, covering top - WINDOW + 1 to top
+	Bucket buckets[WINDOW];
+	int64_t top;
+	bool has_values;
+	int64_t count;
+};
+} // namespace CompensatedSum
@@ -0,0 +1,74 @@
+#include "core/instrumentation.hpp"
+
+#ifdef BIG_NUMBER_INSTRUMENTATION
+
+#include <mutex>
+#include <vector>
+
+namespace Instrumentation {
+namespace {
+// Live threads, and what finished threads counted
+struct Registry {
+	std::mutex mutex;
+	std::vector<ThreadCounters *> threads;
+	Totals retired;
+};
+
+Registry &get_registry() {
+	// Never destroyed, threads can still finish during static destruction
+	static Registry *registry = new Registry;
+	return *registry;
+}
+
+void add_to(const ThreadCounters &p_counters, Totals &r_totals) {
+	for (int i = 0; i < COUNTER_MAX; i++) {
+		r_totals.counters[i] += p_counters.counters[i].load(std::memory_order_relaxed);
+	}
+	for (int i = 0; i < GROUP_MAX; i++) {
+		r_totals.calls[i] += p_counters.calls[i].load(std::memory_order_relaxed);
+		r_totals.sampled_calls[i] += p_counters.sampled_calls[i].load(std::memory_order_relaxed);
+		r_totals.sampled_nanoseconds[i] += p_counters.sampled_nanoseconds[i].load(std::memory_order_relaxed);
+	}
+}
+} // namespace
+
+ThreadCounters::ThreadCounters() {
+	for (int i = 0; i < COUNTER_MAX; i++) {
+		counters[i].store(0, std::memory_order_relaxed);
+	}
+	for (int i = 0; i < GROUP_MAX; i++) {
+		calls[i].store(0, std::memory_order_relaxed);
+		sampled_calls[i].store(0, std::memory_order_relaxed);
+		sampled_nanoseconds[i].store(0, std::memory_order_relaxed);
+	}
+
+	Registry &registry = get_registry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	registry.threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+	Registry &registry = get_registry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	add_to(*this, registry.retired);
+	for (size_t i = 0; i < registry.threads.size(); i++) {
+		if (registry.threads[i] == this) {
+			registry.threads[i] = registry.threads.back();
+			registry.threads.pop_back();
+			break;
+		}
+	}
+}
+
+Totals get_totals() {
+	Registry &registry = get_registry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	Totals totals = registry.retired;
+	for (const ThreadCounters *counters : registry.threads) {
+		add_to(*counters, totals);
+	}
+	return totals;
+}
+} // namespace Instrumentation
+
+#endif // BIG_NUMBER_INSTRUMENTATION
@@ -0,0 +1,132 @@
+#pragma once
+
+// Opt-in counters and sampled timings of the hot paths, shown as Performance
+// monitors (see performance_monitors.hpp). Built with `scons instrumentation=yes`,
+// which defines BIG_NUMBER_INSTRUMENTATION. Without it the macros expand to
+// nothing and this header declares nothing else. Free of Godot types, see
+// big_number_core.hpp.
+//
+// BIG_NUMBER_PROFILE(GROUP_*) at the top of a function counts the call and
+// times one in SAMPLE_INTERVAL of them. Calls made from inside another
+// profiled call are counted but not timed, their time belongs to the
+// outermost call. BIG_NUMBER_COUNT(COUNTER_*) only counts.
+//
+// Each thread writes its own counters without atomic read-modify-writes,
+// readers add them up under a mutex.
+#ifdef BIG_NUMBER_INSTRUMENTATION
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Instrumentation {
+enum Group {
+	GROUP_ARITHMETIC,
+	GROUP_COMPARISON,
+	GROUP_FORMAT,
+	GROUP_PARSE,
+	GROUP_ARRAY,
+	GROUP_MAX,
+};
+
+enum Counter {
+	COUNTER_OBJECTS_CREATED,
+	COUNTER_NORMALIZE,
+	COUNTER_MAX,
+};
+
+// One outermost call per group in this many is timed
+constexpr uint32_t SAMPLE_INTERVAL = 64;
+
+struct ThreadCounters {
+	// Written by the owning thread only, read by any
+	std::atomic<int64_t> counters[COUNTER_MAX];
+	std::atomic<int64_t> calls[GROUP_MAX];
+	std::atomic<int64_t> sampled_calls[GROUP_MAX];
+	std::atomic<int64_t> sampled_nanoseconds[GROUP_MAX];
+
+	// Owning thread only
+	int depth = 0;
+	uint32_t ticks[GROUP_MAX] = {};
+
+	ThreadCounters();
+	~ThreadCounters();
+};
+
+// Sums over every thread, including finished ones
+struct Totals {
+	int64_t counters[COUNTER_MAX] = {};
+	int64_t calls[GROUP_MAX] = {};
+	int64_t sampled_calls[GROUP_MAX] = {};
+	int64_t sampled_nanoseconds[GROUP_MAX] = {};
+
+	// Time spent in the outermost calls of p_group, from the samples
+	double get_estimated_milliseconds(Group p_group) const {
+		return (double)sampled_nanoseconds[p_group] * SAMPLE_INTERVAL / 1000000.0;
+	}
+
+	// Mean duration of a sampled call of p_group, 0 before the first sample
+	double get_microseconds_per_call(Group p_group) const {
+		if (sampled_calls[p_group] == 0) {
+			return 0.0;
+		}
+		return (double)sampled_nanoseconds[p_group] / (double)sampled_calls[p_group] / 1000.0;
+	}
+};
+
+Totals get_totals();
+
+inline ThreadCounters &get_thread_counters() {
+	thread_local ThreadCounters counters;
+	return counters;
+}
+
+// Single writer, so a relaxed load and store is enough
+inline void bump(std::atomic<int64_t> &r_value, int64_t p_amount = 1) {
+	r_value.store(r_value.load(std::memory_order_relaxed) + p_amount, std::memory_order_relaxed);
+}
+
+inline void count(Counter p_counter) {
+	bump(get_thread_counters().counters[p_counter]);
+}
+
+class ScopedCall {
+	ThreadCounters &counters;
+	Group group;
+	bool timed;
+	std::chrono::steady_clock::time_point start;
+
+public:
+	explicit ScopedCall(Group p_group) :
+			counters(get_thread_counters()), group(p_group) {
+		bump(counters.calls[group]);
+		timed = counters.depth == 0 && ++counters.ticks[group] % SAMPLE_INTERVAL == 0;
+		counters.depth++;
+		if (timed) {
+			start = std::chrono::steady_clock::now();
+		}
+	}
+
+	~ScopedCall() {
+		if (timed) {
+			int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			bump(counters.sampled_nanoseconds[group], elapsed);
+			bump(counters.sampled_calls[group]);
+		}
+		counters.depth--;
+	}
+
+	ScopedCall(const ScopedCall &) = delete;
+	ScopedCall &operator=(const ScopedCall &) = delete;
+};
+} // namespace Instrumentation
+
+#define BIG_NUMBER_PROFILE(m_group) Instrumentation::ScopedCall _instrumentation_call(Instrumentation::m_group)
+#define BIG_NUMBER_COUNT(m_counter) Instrumentation::count(Instrumentation::m_counter)
+
+#else
+
+#define BIG_NUMBER_PROFILE(m_group) ((void)0)
+#define BIG_NUMBER_COUNT(m_counter) ((void)0)
+
+#endif // BIG_NUMBER_INSTRUMENTATION
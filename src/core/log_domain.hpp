@@ -0,0 +1,119 @@
+#pragma once
+
+#include "core/big_number_core.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+// Values stored as log10 of their magnitude plus a sign, behind BigNumberLog.
+// Header-only and free of Godot types, see big_number_core.hpp.
+//
+// Multiplication and division become additions of the logs and powers a
+// multiplication, with no pow() or normalization per step. Zero is -inf.
+// The log is a double, so values reach far beyond the int64_t exponent of
+// the mantissa/exponent form, at the cost of mantissa precision: the
+// mantissa keeps about 15 - log10(|log|) significant digits.
+namespace LogDomain {
+// Beyond this the integer part of the log no longer fits int64_t
+constexpr double MAX_EXPONENT = 9.2e18;
+
+// Mantissa tolerance of BigNumberCore::is_equal(), as a difference of logs
+constexpr double EQUAL_EPSILON = BigNumberCore::CMP_EPSILON / BigNumberCore::LOG_10;
+
+inline double from_parts(double p_mantissa, int64_t p_exponent) {
+	if (p_mantissa == 0.0) {
+		return -INFINITY;
+	}
+	return BigNumberCore::log10(std::fabs(p_mantissa), p_exponent);
+}
+
+// Positive mantissa/exponent of 10^p_log, the same steps as the end of
+// BigNumberCore::power_float(). Returns false when the exponent does not fit.
+inline bool to_parts(double p_log, double &r_mantissa, int64_t &r_exponent) {
+	if (p_log == -INFINITY) {
+		r_mantissa = 0.0;
+		r_exponent = 0;
+		return true;
+	}
+	if (!(std::fabs(p_log) < MAX_EXPONENT)) {
+		return false; // Also NaN
+	}
+
+	double floor_log = std::floor(p_log);
+	r_exponent = (int64_t)floor_log;
+	r_mantissa = std::pow(10.0, p_log - floor_log);
+	BigNumberCore::normalize(r_mantissa, r_exponent);
+	return true;
+}
+
+// r = r + p, log10(10^a + 10^b) = a + log10(1 + 10^(b - a)) for a >= b
+inline void add(double &r_log, bool &r_negative, double p_log, bool p_negative) {
+	if (p_log == -INFINITY) {
+		return;
+	}
+	if (r_log == -INFINITY) {
+		r_log = p_log;
+		r_negative = p_negative;
+		return;
+	}
+
+	double high = r_log;
+	double low = p_log;
+	bool negative = r_negative;
+	if (p_log > r_log) {
+		high = p_log;
+		low = r_log;
+		negative = p_negative;
+	}
+
+	double ratio = std::pow(10.0, low - high);
+	if (r_negative == p_negative) {
+		r_log = high + std::log1p(ratio) / BigNumberCore::LOG_10;
+	} else if (ratio == 1.0) {
+		r_log = -INFINITY;
+		negative = false;
+	} else {
+		r_log = high + std::log1p(-ratio) / BigNumberCore::LOG_10;
+	}
+	r_negative = negative;
+}
+
+inline void multiply(double &r_log, bool &r_negative, double p_log, bool p_negative) {
+	r_log += p_log;
+	r_negative = r_negative != p_negative && r_log != -INFINITY;
+}
+
+// Returns false and leaves the value untouched when dividing by zero
+inline bool divide(double &r_log, bool &r_negative, double p_log, bool p_negative) {
+	if (p_log == -INFINITY) {
+		return false;
+	}
+	r_log -= p_log;
+	r_negative = r_negative != p_negative && r_log != -INFINITY;
+	return true;
+}
+
+// Zero stays zero, as in BigNumberCore::power_float(). A negative value
+// keeps its sign for odd integer powers only, other powers use its magnitude.
+inline void power(double &r_log, bool &r_negative, double p_power) {
+	if (r_log == -INFINITY) {
+		return;
+	}
+	r_log *= p_power;
+	r_negative = r_negative && std::fmod(std::fabs(p_power), 2.0) == 1.0;
+}
+
+inline bool is_less_than(double p_log, bool p_negative, double p_other_log, bool p_other_negative) {
+	if (p_negative != p_other_negative) {
+		return p_negative;
+	}
+	return p_negative ? p_log > p_other_log : p_log < p_other_log;
+}
+
+inline bool is_equal(double p_log, bool p_negative, double p_other_log, bool p_other_negative) {
+	if (p_log == p_other_log) {
+		return p_negative == p_other_negative || p_log == -INFINITY;
+	}
+	return p_negative == p_other_negative && std::fabs(p_log - p_other_log) < EQUAL_EPSILON;
+}
+} // namespace LogDomain
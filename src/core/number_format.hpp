@@ -0,0 +1,549 @@
+#pragma once
+
+#include "core/big_number_core.hpp"
+
+#include <cstdint>
+
+// The notations of BigNumber::format(), written straight into a char32_t
+// buffer. Header-only and free of Godot types, see big_number_core.hpp.
+//
+// Each function is the String version it replaced, step by step: the digits
+// come from BigNumberCore::num() and are split at the point, then cut and
+// joined with the separators in place, so the output is byte-identical. The
+// caller builds a single String from the buffer at the end.
+namespace NumberFormat {
+constexpr const char *METRIC_SYMBOLS[] = {
+	"", "k", "M", "G", "T", "P", "E", "Z", "Y", "R", "Q",
+	"V", "U", "Td", "S", "Ri", "Qx", "Pp", "O", "N", "Mi"
+};
+
+constexpr const char *METRIC_NAMES[] = {
+	"", "kilo", "mega", "giga", "tera", "peta", "exa", "zetta", "yotta", "ronna", "quetta",
+	"vunda", "uda", "treda", "sorta", "rinta", "quexa", "pepta", "ocha", "nena", "ming"
+};
+
+constexpr const char *SHORT_SCALE_NAMES[] = {
+	"", "thousand", "million", "billion", "trillion", "quadrillion", "quintillion", "sextillion", "septillion", "octillion", "nonillion",
+	"decillion", "undecillion", "duodecillion", "tredecillion", "quattuordecillion", "quindecillion", "sexdecillion", "septendecillion", "octodecillion", "novemdecillion"
+};
+
+// Entries of each of the three tables above
+constexpr int64_t TABLE_SIZE = sizeof(METRIC_SYMBOLS) / sizeof(METRIC_SYMBOLS[0]);
+
+// AA suffixes of the first powers of 1000, later ones are generated as
+// bijective base 26 letters
+constexpr const char *SUFFIXES_AA[] = { "", "k", "m", "b", "t" };
+constexpr int64_t SUFFIXES_AA_SIZE = sizeof(SUFFIXES_AA) / sizeof(SUFFIXES_AA[0]);
+
+// Letters of the longest generated AA suffix, for target INT64_MAX / 3
+constexpr int AA_MAX_LETTERS = 14;
+
+// Longest suffix of any table
+constexpr int64_t MAX_SUFFIX_LENGTH = 17;
+
+// Latin prefixes of the long names, same tables as test_project/big.gd
+constexpr const char *LATIN_ONES[] = {
+	"", "un", "duo", "tre", "quattuor", "quin", "sex", "septen", "octo", "novem"
+};
+
+constexpr const char *LATIN_TENS[] = {
+	"", "dec", "vigin", "trigin", "quadragin", "quinquagin", "sexagin", "septuagin", "octogin", "nonagin"
+};
+
+constexpr const char *LATIN_HUNDREDS[] = {
+	"", "cen", "duocen", "trecen", "quadringen", "quingen", "sescen", "septingen", "octingen", "nongen"
+};
+
+// Latin powers below ten, "mi" for million up to "non" for nonillion
+constexpr const char *LATIN_SPECIAL[] = {
+	"", "mi", "bi", "tri", "quadri", "quin", "sex", "sept", "oct", "non"
+};
+
+// Latin powers from here on are spelled group by group, see write_long_name()
+constexpr int64_t LONG_NAME_GROUPED_POWER = 10000;
+
+// Bounds of a long name for a Latin power up to INT64_MAX / 3: seven groups
+// of three Latin prefixes with up to 21 "millia", and the ending
+constexpr int64_t LONG_NAME_MAX_LETTERS = 330;
+constexpr int64_t LONG_NAME_MAX_SEPARATORS = 48;
+
+// Covers the output of the default options, see get_max_length(). With
+// them the bound is 610 characters, most of it for long names.
+constexpr int64_t STACK_BUFFER_SIZE = 1024;
+
+struct Separator {
+	const char32_t *text = nullptr;
+	int64_t length = 0;
+};
+
+// BigNumber::FormatOptions fields the formatters read, separators borrowed
+// from the options' Strings
+struct Settings {
+	bool dynamic_decimals = false;
+	int dynamic_numbers = 4;
+	int small_decimals = 2;
+	int thousand_decimals = 2;
+	int big_decimals = 2;
+	int scientific_decimals = 2;
+	Separator thousand_separator;
+	Separator decimal_separator;
+	Separator suffix_separator;
+	Separator reading_separator;
+	Separator thousand_name;
+
+	// Options version the separators belong to, keys the LongNameMemo
+	uint64_t version = 0;
+};
+
+// Upper bound of the characters any notation writes with these settings,
+// without the terminating zero
+constexpr int64_t get_max_length(const Settings &p_settings) {
+	int64_t decimals = p_settings.scientific_decimals;
+	decimals = p_settings.small_decimals > decimals ? p_settings.small_decimals : decimals;
+	decimals = p_settings.thousand_decimals > decimals ? p_settings.thousand_decimals : decimals;
+	decimals = p_settings.big_decimals > decimals ? p_settings.big_decimals : decimals;
+	decimals = decimals > 0 ? decimals : 0;
+
+	int64_t separator = p_settings.decimal_separator.length > p_settings.thousand_separator.length
+			? p_settings.decimal_separator.length
+			: p_settings.thousand_separator.length;
+
+	int64_t suffix = LONG_NAME_MAX_LETTERS + LONG_NAME_MAX_SEPARATORS * p_settings.reading_separator.length;
+	suffix = p_settings.thousand_name.length > suffix ? p_settings.thousand_name.length : suffix;
+
+	// Digits, padding, separators, "e" and an exponent, suffix
+	return BigNumberCore::NUM_BUFFER_SIZE + decimals + separator + 1 + 20 + p_settings.suffix_separator.length + suffix;
+}
+
+// Default options: one-character thousand and decimal separators. One more
+// for the terminating zero.
+static_assert([] {
+	Settings settings;
+	settings.thousand_separator.length = 1;
+	settings.decimal_separator.length = 1;
+	return get_max_length(settings) + 1;
+}() <= STACK_BUFFER_SIZE,
+		"The default options must fit in the stack buffer");
+
+struct Writer {
+	char32_t *buffer;
+	int64_t length = 0;
+
+	explicit Writer(char32_t *p_buffer) :
+			buffer(p_buffer) {}
+
+	void write(const char *p_text, int64_t p_length) {
+		for (int64_t i = 0; i < p_length; i++) {
+			buffer[length++] = (char32_t)(unsigned char)p_text[i];
+		}
+	}
+
+	void write(const char *p_text) {
+		while (*p_text != 0) {
+			buffer[length++] = (char32_t)(unsigned char)*p_text++;
+		}
+	}
+
+	void write(const Separator &p_separator) {
+		for (int64_t i = 0; i < p_separator.length; i++) {
+			buffer[length++] = p_separator.text[i];
+		}
+	}
+
+	// String::num_int64()
+	void write_int(int64_t p_value) {
+		uint64_t magnitude = p_value < 0 ? (uint64_t)0 - (uint64_t)p_value : (uint64_t)p_value;
+		char reversed[20];
+		int count = 0;
+		do {
+			reversed[count++] = (char)('0' + magnitude % 10);
+			magnitude /= 10;
+		} while (magnitude > 0);
+		if (p_value < 0) {
+			buffer[length++] = '-';
+		}
+		while (count > 0) {
+			buffer[length++] = (char32_t)reversed[--count];
+		}
+	}
+
+	// Terminates the buffer for the String constructor
+	const char32_t *finish() {
+		buffer[length] = 0;
+		return buffer;
+	}
+};
+
+namespace internal {
+// BigNumberCore::num() split at the point. Fractions padded with zeroes
+// behave as if the zeroes were printed.
+struct Digits {
+	char text[BigNumberCore::NUM_BUFFER_SIZE];
+	int integer_length = 0;
+	int fraction_length = 0;
+	int padded_length = 0;
+
+	Digits(double p_value, int p_decimals) {
+		int length = BigNumberCore::num(p_value, p_decimals, text);
+		integer_length = length;
+		for (int i = 0; i < length; i++) {
+			if (text[i] == '.') {
+				integer_length = i;
+				fraction_length = length - i - 1;
+				break;
+			}
+		}
+		padded_length = fraction_length;
+	}
+
+	void pad(int p_decimals) {
+		padded_length = p_decimals > padded_length ? p_decimals : padded_length;
+	}
+
+	void write_integer(Writer &r_writer) const {
+		r_writer.write(text, integer_length);
+	}
+
+	// First p_count fraction digits, as far as there are
+	void write_fraction(int p_count, Writer &r_writer) const {
+		int count = p_count < padded_length ? p_count : padded_length;
+		int printed = count < fraction_length ? count : fraction_length;
+		r_writer.write(text + integer_length + 1, printed);
+		for (int i = printed; i < count; i++) {
+			r_writer.buffer[r_writer.length++] = '0';
+		}
+	}
+};
+
+inline int clamp_limit(int p_limit, int p_decimals) {
+	p_limit = p_limit < p_decimals ? p_limit : p_decimals;
+	return p_limit > 0 ? p_limit : 0;
+}
+
+// Decimal digits of String::num_int64()
+inline int int_length(int64_t p_value) {
+	uint64_t magnitude = p_value < 0 ? (uint64_t)0 - (uint64_t)p_value : (uint64_t)p_value;
+	int length = p_value < 0 ? 2 : 1;
+	while (magnitude >= 10) {
+		magnitude /= 10;
+		length++;
+	}
+	return length;
+}
+
+inline bool is_separator_char(char32_t p_char, const Separator &p_separator) {
+	for (int64_t i = 0; i < p_separator.length; i++) {
+		if (p_separator.text[i] == p_char) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Hundreds, ones and tens of a group below 1000, in the order big.gd writes them
+inline void write_latin_group(int64_t p_group, const Separator &p_separator, Writer &r_writer) {
+	r_writer.write(LATIN_HUNDREDS[p_group / 100]);
+	r_writer.write(p_separator);
+	r_writer.write(LATIN_ONES[p_group % 10]);
+	r_writer.write(p_separator);
+	r_writer.write(LATIN_TENS[(p_group / 10) % 10]);
+}
+} // namespace internal
+
+// The mantissa shifted by the exponent modulo 3, the digits prefix() prints
+inline double scale_prefix(double p_mantissa, int64_t p_exponent) {
+	static constexpr double SCALES[] = { 1.0, 10.0, 100.0 };
+	int64_t shift = p_exponent % 3;
+	return shift > 0 ? p_mantissa * SCALES[shift] : p_mantissa;
+}
+
+inline void scientific(double p_mantissa, int64_t p_exponent, bool p_no_decimals_on_small_values, bool p_force_decimals, const Settings &p_settings, Writer &r_writer) {
+	int scientific_decimals = p_settings.scientific_decimals;
+
+	if (p_exponent < 3) {
+		double decimal_increments = 1.0 / (PowerOfTen::get(scientific_decimals) / 10.0);
+		double value = BigNumberCore::snapped(p_mantissa * PowerOfTen::get(p_exponent), decimal_increments);
+		internal::Digits digits(value, scientific_decimals);
+		digits.write_integer(r_writer);
+		if (p_no_decimals_on_small_values || digits.fraction_length == 0) {
+			return;
+		}
+
+		int limit = scientific_decimals;
+		if (p_settings.dynamic_decimals) {
+			limit = p_settings.dynamic_numbers - digits.integer_length;
+		}
+		limit = internal::clamp_limit(limit, scientific_decimals);
+		if (limit > 0) {
+			r_writer.write(p_settings.decimal_separator);
+			digits.write_fraction(limit, r_writer);
+		}
+		return;
+	}
+
+	// Mantissa is 1.0 to 10.0, printed with extra precision
+	internal::Digits digits(p_mantissa, scientific_decimals + 2);
+	if (p_force_decimals) {
+		digits.pad(scientific_decimals);
+	}
+
+	int limit = scientific_decimals;
+	if (p_settings.dynamic_decimals) {
+		limit = p_settings.dynamic_numbers - 1 - internal::int_length(p_exponent);
+	}
+	limit = internal::clamp_limit(limit, scientific_decimals);
+
+	digits.write_integer(r_writer);
+	if (p_force_decimals || (limit > 0 && digits.padded_length > 0)) {
+		r_writer.write(p_settings.decimal_separator);
+		digits.write_fraction(limit, r_writer);
+	}
+	r_writer.write("e", 1);
+	r_writer.write_int(p_exponent);
+}
+
+inline void prefix(double p_mantissa, int64_t p_exponent, bool p_no_decimals_on_small_values, bool p_use_thousand_symbol, bool p_force_decimals, bool p_scientific_prefix, const Settings &p_settings, Writer &r_writer) {
+	double number = p_scientific_prefix ? p_mantissa : scale_prefix(p_mantissa, p_exponent);
+	internal::Digits digits(number, -1);
+
+	if (p_force_decimals) {
+		int max_decimals = p_settings.small_decimals;
+		max_decimals = p_settings.thousand_decimals > max_decimals ? p_settings.thousand_decimals : max_decimals;
+		max_decimals = p_settings.big_decimals > max_decimals ? p_settings.big_decimals : max_decimals;
+		digits.pad(max_decimals);
+	}
+
+	digits.write_integer(r_writer);
+	if (p_no_decimals_on_small_values && p_exponent < 3) {
+		return;
+	}
+
+	// Decimals of the range, and the default limit before the dynamic one
+	int decimals;
+	int limit;
+	if (p_exponent < 3) {
+		decimals = p_settings.small_decimals;
+		limit = decimals;
+	} else if (p_exponent < 6) {
+		decimals = p_settings.thousand_decimals;
+		if (!p_use_thousand_symbol) {
+			// The digits below one thousand, after a thousand separator
+			if (decimals != 0) {
+				r_writer.write(p_settings.thousand_separator);
+				digits.write_fraction(3, r_writer);
+			}
+			return;
+		}
+		limit = 3;
+	} else {
+		decimals = p_settings.big_decimals;
+		limit = decimals;
+	}
+
+	if (decimals == 0 || digits.padded_length == 0) {
+		return;
+	}
+	if (p_settings.dynamic_decimals) {
+		limit = p_settings.dynamic_numbers - digits.integer_length;
+	}
+	limit = internal::clamp_limit(limit, decimals);
+	// The separator stays even when the limit cuts every digit
+	r_writer.write(p_settings.decimal_separator);
+	digits.write_fraction(limit, r_writer);
+}
+
+// Suffix of the power of 1000 p_target, letters from "aa" onward
+inline void write_aa_suffix(int64_t p_target, Writer &r_writer) {
+	if (p_target >= 0 && p_target < SUFFIXES_AA_SIZE) {
+		r_writer.write(SUFFIXES_AA[p_target]);
+		return;
+	}
+	char letters[AA_MAX_LETTERS];
+	int count = AA_MAX_LETTERS;
+	int64_t offset = p_target + 22; // Offset matching standard AA
+	while (offset > 0) {
+		offset -= 1;
+		letters[--count] = (char)('a' + offset % 26);
+		offset /= 26;
+	}
+	r_writer.write(letters + count, AA_MAX_LETTERS - count);
+}
+
+inline void aa(double p_mantissa, int64_t p_exponent, bool p_no_decimals_on_small_values, bool p_use_thousand_symbol, bool p_force_decimals, const Settings &p_settings, Writer &r_writer) {
+	int64_t target = p_exponent / 3;
+	prefix(p_mantissa, p_exponent, p_no_decimals_on_small_values, p_use_thousand_symbol, p_force_decimals, false, p_settings, r_writer);
+	r_writer.write(p_settings.suffix_separator);
+	if (p_use_thousand_symbol || target != 1) {
+		write_aa_suffix(target, r_writer);
+	}
+}
+
+// Long name of the power of 1000 p_target, from 2 (million) on, such as
+// "vigintillion". Same names as getLongName() of test_project/big.gd:
+// American names count Latin powers from million, European ones switch
+// between "llion" and "lliard" every power of 1000.
+//
+// big.gd writes the thousands of the Latin power as that many "millia", and
+// only its last digit. From LONG_NAME_GROUPED_POWER on, each group of three
+// digits is spelled instead, followed by one "millia" per group below it, as
+// in the system by Landon Curt Noll it is based on. A group of 1 above the
+// lowest is written as its "millia" alone.
+inline void write_long_name(int64_t p_target, bool p_european, const Settings &p_settings, Writer &r_writer) {
+	const Separator &separator = p_settings.reading_separator;
+	int64_t power = p_european ? p_target / 2 : p_target - 1;
+	int64_t start = r_writer.length;
+
+	if (power < 10) {
+		r_writer.write(LATIN_SPECIAL[power]);
+		r_writer.write(separator);
+		r_writer.write(separator);
+	} else if (power < LONG_NAME_GROUPED_POWER) {
+		for (int64_t i = 0; i < power / 1000; i++) {
+			r_writer.write("millia", 6);
+			r_writer.write(separator);
+		}
+		internal::write_latin_group(power % 1000, separator, r_writer);
+	} else {
+		int64_t groups[7];
+		int count = 0;
+		for (int64_t rest = power; rest > 0; rest /= 1000) {
+			groups[count++] = rest % 1000;
+		}
+		bool first = true;
+		for (int level = count - 1; level >= 0; level--) {
+			if (groups[level] == 0) {
+				continue;
+			}
+			if (!first) {
+				r_writer.write(separator);
+			}
+			first = false;
+			bool latin = groups[level] != 1 || level == 0;
+			if (latin) {
+				internal::write_latin_group(groups[level], separator, r_writer);
+			}
+			for (int i = 0; i < level; i++) {
+				if (latin || i > 0) {
+					r_writer.write(separator);
+				}
+				r_writer.write("millia", 6);
+			}
+		}
+	}
+
+	// Like String.lstrip() and rstrip(), every character of the separator
+	// goes, not only whole separators
+	int64_t begin = start;
+	int64_t end = r_writer.length;
+	while (begin < end && internal::is_separator_char(r_writer.buffer[begin], separator)) {
+		begin++;
+	}
+	while (end > begin && internal::is_separator_char(r_writer.buffer[end - 1], separator)) {
+		end--;
+	}
+	for (int64_t i = begin; i < end; i++) {
+		r_writer.buffer[start + i - begin] = r_writer.buffer[i];
+	}
+	r_writer.length = start + end - begin;
+
+	r_writer.write(separator);
+	int64_t power_kilo = power % 1000;
+	if (power_kilo > 0 && power_kilo < 5 && power < 1000) {
+		// "mi", "bi", "tri" and "quadri" take "llion" directly
+	} else if ((power_kilo >= 7 && power_kilo <= 10) || (power_kilo / 10) % 10 == 1) {
+		r_writer.write("i", 1);
+	} else {
+		r_writer.write("ti", 2);
+	}
+	if (p_european && p_target % 2 == 1) {
+		r_writer.write("lliard", 6);
+	} else {
+		r_writer.write("llion", 5);
+	}
+}
+
+// Names written by write_long_name(), per power of 1000, for one thread.
+// Direct-mapped: a colliding group replaces the entry.
+struct LongNameMemo {
+	static constexpr int SIZE = 32;
+	// Longer names are generated every time
+	static constexpr int64_t MAX_LENGTH = 96;
+
+	struct Entry {
+		int64_t target = -1;
+		uint64_t version = 0;
+		bool european = false;
+		int64_t length = 0;
+		char32_t text[MAX_LENGTH];
+	};
+
+	Entry entries[SIZE];
+
+	void write(int64_t p_target, bool p_european, const Settings &p_settings, Writer &r_writer) {
+		uint64_t hash = ((uint64_t)p_target * 0x9E3779B97F4A7C15ULL) >> 59;
+		Entry &entry = entries[(hash ^ (p_european ? 1 : 0)) & (SIZE - 1)];
+		if (entry.target == p_target && entry.european == p_european && entry.version == p_settings.version) {
+			for (int64_t i = 0; i < entry.length; i++) {
+				r_writer.buffer[r_writer.length++] = entry.text[i];
+			}
+			return;
+		}
+
+		int64_t start = r_writer.length;
+		write_long_name(p_target, p_european, p_settings, r_writer);
+		int64_t length = r_writer.length - start;
+		if (length <= MAX_LENGTH) {
+			entry.target = p_target;
+			entry.european = p_european;
+			entry.version = p_settings.version;
+			entry.length = length;
+			for (int64_t i = 0; i < length; i++) {
+				entry.text[i] = r_writer.buffer[start + i];
+			}
+		}
+	}
+};
+
+// Prefix notation and the thousand name or a long name. p_memo can be null.
+inline void long_name(double p_mantissa, int64_t p_exponent, bool p_no_decimals_on_small_values, bool p_european, const Settings &p_settings, LongNameMemo *p_memo, Writer &r_writer) {
+	prefix(p_mantissa, p_exponent, p_no_decimals_on_small_values, true, true, false, p_settings, r_writer);
+	if (p_exponent < 3) {
+		return;
+	}
+	r_writer.write(p_settings.suffix_separator);
+	if (p_exponent < 6) {
+		r_writer.write(p_settings.thousand_name);
+		return;
+	}
+	int64_t target = p_exponent / 3;
+	if (p_memo != nullptr) {
+		p_memo->write(target, p_european, p_settings, r_writer);
+	} else {
+		write_long_name(target, p_european, p_settings, r_writer);
+	}
+}
+
+// Prefix notation and a name of p_table, scientific past the table
+inline void table(const char *const *p_table, double p_mantissa, int64_t p_exponent, bool p_no_decimals_on_small_values, const Settings &p_settings, Writer &r_writer) {
+	int64_t target = p_exponent / 3;
+	if (target < 0 || target >= TABLE_SIZE) {
+		scientific(p_mantissa, p_exponent, false, false, p_settings, r_writer);
+		return;
+	}
+	prefix(p_mantissa, p_exponent, p_no_decimals_on_small_values, true, true, false, p_settings, r_writer);
+	r_writer.write(p_settings.suffix_separator);
+	r_writer.write(p_table[target]);
+}
+
+inline void metric_symbol(double p_mantissa, int64_t p_exponent, bool p_no_decimals_on_small_values, const Settings &p_settings, Writer &r_writer) {
+	table(METRIC_SYMBOLS, p_mantissa, p_exponent, p_no_decimals_on_small_values, p_settings, r_writer);
+}
+
+inline void metric_name(double p_mantissa, int64_t p_exponent, bool p_no_decimals_on_small_values, const Settings &p_settings, Writer &r_writer) {
+	table(METRIC_NAMES, p_mantissa, p_exponent, p_no_decimals_on_small_values, p_settings, r_writer);
+}
+
+inline void short_scale(double p_mantissa, int64_t p_exponent, bool p_no_decimals_on_small_values, const Settings &p_settings, Writer &r_writer) {
+	table(SHORT_SCALE_NAMES, p_mantissa, p_exponent, p_no_decimals_on_small_values, p_settings, r_writer);
+}
+} // namespace NumberFormat
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Shared power-of-ten lookups used by normalization, addition and formatting.
+// Every value is produced once at load time with the same libm calls the
+// original code used, so results are bit-identical to calling them directly.
+// Header-only and free of Godot types, see big_number_core.hpp.
+namespace PowerOfTen {
+// Smallest and largest n for which 10^n is representable as a double
+// (10^-324 rounds to zero, 10^309 overflows).
+constexpr int64_t MIN_EXPONENT = -324;
+constexpr int64_t MAX_EXPONENT = 308;
+
+// ln(10)
+constexpr double LOG_10 = 2.302585092994046;
+
+namespace internal {
+// Range of floor_log10 results resolved by comparison only
+constexpr int64_t FAST_MIN = -2;
+constexpr int64_t FAST_MAX = 2;
+
+inline int64_t log_floor_log10(double p_value) {
+	return (int64_t)std::floor(std::log(p_value) / LOG_10);
+}
+
+// Smallest positive double whose log_floor_log10() is at least p_digits.
+// The log-based result is monotonic, so a binary search over the bit
+// patterns of positive doubles finds the exact switching point, including
+// the places where rounding moves it away from the true power of ten
+// (e.g. 1000.0 still floors to 2).
+inline double find_boundary(int64_t p_digits) {
+	uint64_t lo = 1; // Smallest subnormal
+	uint64_t hi = 0x7fefffffffffffffULL; // Largest finite double
+	while (lo < hi) {
+		uint64_t mid = lo + (hi - lo) / 2;
+		double value;
+		memcpy(&value, &mid, sizeof(value));
+		if (log_floor_log10(value) >= p_digits) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	double res;
+	memcpy(&res, &lo, sizeof(res));
+	return res;
+}
+
+struct Tables {
+	double powers[MAX_EXPONENT - MIN_EXPONENT + 1];
+	// boundaries[i] is the first value that floors to FAST_MIN + i
+	double boundaries[FAST_MAX - FAST_MIN + 2];
+
+	Tables() {
+		for (int64_t i = MIN_EXPONENT; i <= MAX_EXPONENT; i++) {
+			powers[i - MIN_EXPONENT] = std::pow(10.0, (double)i);
+		}
+		for (int64_t i = FAST_MIN; i <= FAST_MAX + 1; i++) {
+			boundaries[i - FAST_MIN] = find_boundary(i);
+		}
+	}
+};
+
+inline const Tables tables;
+} // namespace internal
+
+// Returns pow(10.0, p_exponent), from the table when in range.
+inline double get(int64_t p_exponent) {
+	if (p_exponent >= MIN_EXPONENT && p_exponent <= MAX_EXPONENT) {
+		return internal::tables.powers[p_exponent - MIN_EXPONENT];
+	}
+	return std::pow(10.0, (double)p_exponent);
+}
+
+// Returns floor(log10(p_value)) exactly as floor(log(p_value) / ln(10))
+// computes it, for p_value > 0. Values within two decades of [1, 10) are
+// resolved with a few comparisons instead of a log call.
+inline int64_t floor_log10(double p_value) {
+	using namespace internal;
+	const double *b = tables.boundaries;
+	if (p_value >= b[0] && p_value < b[FAST_MAX - FAST_MIN + 1]) {
+		int64_t digits = FAST_MIN;
+		while (p_value >= b[digits - FAST_MIN + 1]) {
+			digits++;
+		}
+		return digits;
+	}
+	return log_floor_log10(p_value);
+}
+} // namespace PowerOfTen
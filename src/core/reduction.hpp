@@ -0,0 +1,128 @@
+#pragma once
+
+#include "core/big_number_core.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+// Reductions over packed mantissa/exponent buffers, behind the BigNumberArray
+// reductions. Header-only and free of Godot types, see big_number_core.hpp.
+// Orderings use is_less() below, ties keep the lowest index.
+namespace Reduction {
+// Mantissas in [1, 10) multiplied this many times stay below 1e128, far
+// from overflowing a double
+constexpr int64_t PRODUCT_BLOCK = 128;
+
+// Same as repeated BigNumberCore::multiply(), normalizing once per block
+// instead of once per element
+inline void product(const double *p_mantissas, const int64_t *p_exponents, int64_t p_count, double &r_mantissa, int64_t &r_exponent) {
+	r_mantissa = 1.0;
+	r_exponent = 0;
+	for (int64_t begin = 0; begin < p_count; begin += PRODUCT_BLOCK) {
+		int64_t end = begin + PRODUCT_BLOCK < p_count ? begin + PRODUCT_BLOCK : p_count;
+		for (int64_t i = begin; i < end; i++) {
+			r_mantissa *= p_mantissas[i];
+			r_exponent += p_exponents[i];
+		}
+		BigNumberCore::normalize(r_mantissa, r_exponent);
+	}
+}
+
+// log10 of the sum of the absolute values, max + log10(sum(10^(l - max)))
+// over the log10 of each element. -inf when every element is zero.
+inline double log_sum(const double *p_mantissas, const int64_t *p_exponents, int64_t p_count) {
+	double max_log = -INFINITY;
+	for (int64_t i = 0; i < p_count; i++) {
+		if (p_mantissas[i] != 0.0) {
+			double log_value = BigNumberCore::log10(std::fabs(p_mantissas[i]), p_exponents[i]);
+			max_log = log_value > max_log ? log_value : max_log;
+		}
+	}
+	if (max_log == -INFINITY) {
+		return max_log;
+	}
+
+	double sum = 0.0;
+	for (int64_t i = 0; i < p_count; i++) {
+		if (p_mantissas[i] != 0.0) {
+			sum += std::pow(10.0, BigNumberCore::log10(std::fabs(p_mantissas[i]), p_exponents[i]) - max_log);
+		}
+	}
+	return max_log + std::log10(sum);
+}
+
+// -1, 0 or 1. NaN counts as zero, so it still has a place in the order.
+inline int get_sign(double p_mantissa) {
+	return p_mantissa > 0.0 ? 1 : (p_mantissa < 0.0 ? -1 : 0);
+}
+
+// Numeric order of the values, a strict weak ordering as the std sorting
+// algorithms need. BigNumberCore::is_less_than() compares exponents first
+// and does not check zero on the right-hand side or the signs, so it puts
+// 0.02 below 0 and -5000 above 1. Unnormalized inputs are normalized on
+// copies, the same order as SortKey::encode().
+inline bool is_less(double p_mantissa, int64_t p_exponent, double p_other_mantissa, int64_t p_other_exponent) {
+	int sign = get_sign(p_mantissa);
+	int other_sign = get_sign(p_other_mantissa);
+	if (sign != other_sign) {
+		return sign < other_sign;
+	}
+	if (sign == 0) {
+		return false;
+	}
+
+	bool infinite = std::isinf(p_mantissa);
+	bool other_infinite = std::isinf(p_other_mantissa);
+	bool magnitude_less;
+	bool magnitude_greater;
+	if (infinite || other_infinite) {
+		magnitude_less = !infinite;
+		magnitude_greater = !other_infinite;
+	} else {
+		// normalize() drops the sign
+		BigNumberCore::normalize(p_mantissa, p_exponent);
+		BigNumberCore::normalize(p_other_mantissa, p_other_exponent);
+		magnitude_less = p_exponent < p_other_exponent || (p_exponent == p_other_exponent && p_mantissa < p_other_mantissa);
+		magnitude_greater = p_exponent > p_other_exponent || (p_exponent == p_other_exponent && p_mantissa > p_other_mantissa);
+	}
+	return sign > 0 ? magnitude_less : magnitude_greater;
+}
+
+// Index of the smallest element, or of the largest when p_largest is set.
+// -1 when empty.
+inline int64_t extreme_index(const double *p_mantissas, const int64_t *p_exponents, int64_t p_count, bool p_largest) {
+	if (p_count == 0) {
+		return -1;
+	}
+	int64_t best = 0;
+	for (int64_t i = 1; i < p_count; i++) {
+		bool better = p_largest
+				? is_less(p_mantissas[best], p_exponents[best], p_mantissas[i], p_exponents[i])
+				: is_less(p_mantissas[i], p_exponents[i], p_mantissas[best], p_exponents[best]);
+		if (better) {
+			best = i;
+		}
+	}
+	return best;
+}
+
+// Ordering of element indices for the std sorting algorithms. Equal values
+// compare by index, so even unstable algorithms give the stable order.
+struct IndexLess {
+	const double *mantissas;
+	const int64_t *exponents;
+	bool descending;
+
+	bool operator()(int64_t p_left, int64_t p_right) const {
+		int64_t first = descending ? p_right : p_left;
+		int64_t second = descending ? p_left : p_right;
+		if (is_less(mantissas[first], exponents[first], mantissas[second], exponents[second])) {
+			return true;
+		}
+		if (is_less(mantissas[second], exponents[second], mantissas[first], exponents[first])) {
+			return false;
+		}
+		return p_left < p_right;
+	}
+};
+} // namespace Reduction
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "core/big_number_core.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+// Order-preserving int64_t keys, behind BigNumber::to_sort_key() and the
+// batch version. Header-only and free of Godot types, see big_number_core.hpp.
+//
+// Keys follow numeric order: if a < b as numbers then key(a) <= key(b), so
+// plain integer sorting, radix sorting and binary search order values the
+// same way the BigNumberArray sorts do (Reduction::is_less()), which are
+// the reference order. BigNumberCore::is_less_than() can disagree: it
+// compares exponents first, so it puts 0.02 below 0 and orders negative
+// mantissas by value only at equal exponents.
+//
+//   zero      0
+//   positive  1 + (biased exponent << MANTISSA_BITS | mantissa fraction)
+//   negative  minus the key of the magnitude
+//
+// The exponent is clamped to the int32_t range and biased by EXPONENT_BIAS.
+// The fraction is (mantissa - 1) / 9 in MANTISSA_BITS fixed point, so
+// values whose normalized mantissas differ by less than MANTISSA_STEP, about
+// 8 significant digits, can share a key.
+namespace SortKey {
+constexpr int MANTISSA_BITS = 30;
+constexpr int EXPONENT_BITS = 32;
+
+constexpr int64_t MIN_EXPONENT = INT32_MIN;
+constexpr int64_t MAX_EXPONENT = INT32_MAX;
+constexpr int64_t EXPONENT_BIAS = -MIN_EXPONENT;
+
+constexpr int64_t FRACTION_COUNT = int64_t(1) << MANTISSA_BITS;
+constexpr int64_t FRACTION_MASK = FRACTION_COUNT - 1;
+constexpr double MANTISSA_STEP = 9.0 / (double)FRACTION_COUNT;
+
+// Keys of the largest and smallest values, every key is in between
+constexpr int64_t MAX_KEY = int64_t(1) << (MANTISSA_BITS + EXPONENT_BITS);
+constexpr int64_t MIN_KEY = -MAX_KEY;
+
+inline int64_t encode(double p_mantissa, int64_t p_exponent) {
+	if (p_mantissa == 0.0 || std::isnan(p_mantissa)) {
+		return 0;
+	}
+	// normalize() drops the sign
+	bool negative = p_mantissa < 0.0;
+	if (std::isinf(p_mantissa)) {
+		return negative ? MIN_KEY : MAX_KEY;
+	}
+	BigNumberCore::normalize(p_mantissa, p_exponent);
+
+	int64_t biased;
+	int64_t fraction;
+	if (p_exponent > MAX_EXPONENT) {
+		biased = MAX_EXPONENT + EXPONENT_BIAS;
+		fraction = FRACTION_MASK;
+	} else if (p_exponent < MIN_EXPONENT) {
+		biased = 0;
+		fraction = 0;
+	} else {
+		biased = p_exponent + EXPONENT_BIAS;
+		// Mantissas rounded to 10.0 still map inside the range
+		fraction = (int64_t)((p_mantissa - 1.0) * ((double)FRACTION_COUNT / 9.0));
+		fraction = fraction < 0 ? 0 : (fraction > FRACTION_MASK ? FRACTION_MASK : fraction);
+	}
+
+	int64_t key = 1 + ((biased << MANTISSA_BITS) | fraction);
+	return negative ? -key : key;
+}
+
+// Lowest value with this key, normalized, keeps the sign
+inline void decode(int64_t p_key, double &r_mantissa, int64_t &r_exponent) {
+	if (p_key == 0) {
+		r_mantissa = 0.0;
+		r_exponent = 0;
+		return;
+	}
+	bool negative = p_key < 0;
+	uint64_t magnitude = negative ? (uint64_t)0 - (uint64_t)p_key : (uint64_t)p_key;
+	if (magnitude > (uint64_t)MAX_KEY) {
+		magnitude = (uint64_t)MAX_KEY;
+	}
+	magnitude -= 1;
+
+	r_exponent = (int64_t)(magnitude >> MANTISSA_BITS) - EXPONENT_BIAS;
+	r_mantissa = 1.0 + (double)(magnitude & FRACTION_MASK) * MANTISSA_STEP;
+	if (negative) {
+		r_mantissa = -r_mantissa;
+	}
+}
+} // namespace SortKey
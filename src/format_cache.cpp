@@ -0,0 +1,146 @@
+#include "format_cache.hpp"
+
+FormatCache::State &FormatCache::_get_state() {
+	static State state;
+	return state;
+}
+
+uint32_t FormatCache::KeyHasher::hash(const Key &p_key) {
+	// 64-bit mix of every field, folded down to 32 bits
+	uint64_t h = (uint64_t)p_key.quantized * 0x9E3779B97F4A7C15ULL;
+	h ^= (uint64_t)p_key.exponent + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2);
+	h ^= p_key.options_version + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+	h ^= ((uint64_t)p_key.notation << 32 | p_key.flags) + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2);
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	return (uint32_t)h;
+}
+
+void FormatCache::set_capacity(int64_t p_capacity) {
+	ERR_FAIL_COND_MSG(p_capacity < 0, "BigNumber Error: Format cache capacity cannot be negative.");
+
+	State &state = _get_state();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	state.capacity.store((uint32_t)p_capacity, std::memory_order_relaxed);
+	_clear(state);
+}
+
+int64_t FormatCache::get_capacity() {
+	return _get_state().capacity.load(std::memory_order_relaxed);
+}
+
+bool FormatCache::is_enabled() {
+	return _get_state().capacity.load(std::memory_order_relaxed) > 0;
+}
+
+bool FormatCache::lookup(const Key &p_key, String &r_value) {
+	State &state = _get_state();
+	// Formatting again is cheaper than waiting for another thread
+	std::unique_lock<std::mutex> lock(state.mutex, std::try_to_lock);
+	if (!lock.owns_lock()) {
+		state.misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	HashMap<Key, uint32_t, KeyHasher>::Iterator it = state.map.find(p_key);
+	if (it == state.map.end()) {
+		state.misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	uint32_t index = it->value;
+	if (index != state.head) {
+		_unlink(state, index);
+		_push_front(state, index);
+	}
+	r_value = state.entries[index].value;
+	state.hits.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+void FormatCache::store(const Key &p_key, const String &p_value) {
+	State &state = _get_state();
+	std::unique_lock<std::mutex> lock(state.mutex, std::try_to_lock);
+	if (!lock.owns_lock()) {
+		return;
+	}
+
+	uint32_t capacity = state.capacity.load(std::memory_order_relaxed);
+	if (capacity == 0 || state.map.has(p_key)) {
+		return;
+	}
+
+	uint32_t index;
+	if (state.entries.size() < capacity) {
+		index = state.entries.size();
+		state.entries.push_back(Entry());
+	} else {
+		// Reuse the least recently used slot
+		index = state.tail;
+		state.map.erase(state.entries[index].key);
+		_unlink(state, index);
+	}
+
+	Entry &entry = state.entries[index];
+	entry.key = p_key;
+	entry.value = p_value;
+	state.map.insert(p_key, index);
+	_push_front(state, index);
+}
+
+void FormatCache::clear() {
+	State &state = _get_state();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	_clear(state);
+}
+
+int64_t FormatCache::get_hits() {
+	return _get_state().hits.load(std::memory_order_relaxed);
+}
+
+int64_t FormatCache::get_misses() {
+	return _get_state().misses.load(std::memory_order_relaxed);
+}
+
+void FormatCache::reset_stats() {
+	State &state = _get_state();
+	state.hits.store(0, std::memory_order_relaxed);
+	state.misses.store(0, std::memory_order_relaxed);
+}
+
+void FormatCache::_clear(State &r_state) {
+	r_state.map.clear();
+	r_state.entries.clear();
+	r_state.head = INVALID;
+	r_state.tail = INVALID;
+}
+
+void FormatCache::_unlink(State &r_state, uint32_t p_index) {
+	Entry &entry = r_state.entries[p_index];
+	if (entry.prev != INVALID) {
+		r_state.entries[entry.prev].next = entry.next;
+	} else {
+		r_state.head = entry.next;
+	}
+	if (entry.next != INVALID) {
+		r_state.entries[entry.next].prev = entry.prev;
+	} else {
+		r_state.tail = entry.prev;
+	}
+	entry.prev = INVALID;
+	entry.next = INVALID;
+}
+
+void FormatCache::_push_front(State &r_state, uint32_t p_index) {
+	Entry &entry = r_state.entries[p_index];
+	entry.prev = INVALID;
+	entry.next = r_state.head;
+	if (r_state.head != INVALID) {
+		r_state.entries[r_state.head].prev = p_index;
+	}
+	r_state.head = p_index;
+	if (r_state.tail == INVALID) {
+		r_state.tail = p_index;
+	}
+}
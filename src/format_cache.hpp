@@ -0,0 +1,73 @@
+#pragma once
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <atomic>
+#include <mutex>
+
+using namespace godot;
+
+// Bounded LRU cache of formatted strings, shared by every BigNumber.
+// Disabled (capacity 0) by default. Safe to use from any thread: lookups and
+// stores skip the cache instead of waiting while another thread holds it.
+class FormatCache {
+public:
+	struct Key {
+		// Mantissa quantized at the displayed precision
+		int64_t quantized = 0;
+		int64_t exponent = 0;
+		uint64_t options_version = 0;
+		uint32_t notation = 0;
+		uint32_t flags = 0;
+
+		bool operator==(const Key &p_other) const {
+			return quantized == p_other.quantized && exponent == p_other.exponent && options_version == p_other.options_version && notation == p_other.notation && flags == p_other.flags;
+		}
+	};
+
+	struct KeyHasher {
+		static uint32_t hash(const Key &p_key);
+	};
+
+	static void set_capacity(int64_t p_capacity);
+	static int64_t get_capacity();
+	static bool is_enabled();
+
+	// Returns true and fills r_value on a hit
+	static bool lookup(const Key &p_key, String &r_value);
+	static void store(const Key &p_key, const String &p_value);
+	static void clear();
+
+	static int64_t get_hits();
+	static int64_t get_misses();
+	static void reset_stats();
+
+private:
+	static const uint32_t INVALID = 0xFFFFFFFF;
+
+	struct Entry {
+		Key key;
+		String value;
+		uint32_t prev = INVALID;
+		uint32_t next = INVALID;
+	};
+
+	struct State {
+		// Guards everything but the atomics
+		std::mutex mutex;
+		HashMap<Key, uint32_t, KeyHasher> map;
+		LocalVector<Entry> entries;
+		std::atomic<uint32_t> capacity{ 0 };
+		uint32_t head = INVALID; // Most recently used
+		uint32_t tail = INVALID; // Least recently used
+		std::atomic<int64_t> hits{ 0 };
+		std::atomic<int64_t> misses{ 0 };
+	};
+
+	static State &_get_state();
+	static void _clear(State &r_state);
+	static void _unlink(State &r_state, uint32_t p_index);
+	static void _push_front(State &r_state, uint32_t p_index);
+};
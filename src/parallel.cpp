@@ -0,0 +1,15 @@
+#include "parallel.hpp"
+
+#include <atomic>
+
+namespace {
+std::atomic<int64_t> threshold(32768);
+} // namespace
+
+void Parallel::set_threshold(int64_t p_threshold) {
+	threshold.store(p_threshold < 0 ? 0 : p_threshold, std::memory_order_relaxed);
+}
+
+int64_t Parallel::get_threshold() {
+	return threshold.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+
+#include <cstdint>
+
+using namespace godot;
+
+// Splits batch work over the WorkerThreadPool. Every element is processed
+// by exactly one task and no task depends on another, so the results are
+// the same as a serial loop regardless of the thread count.
+namespace Parallel {
+// Below this many elements the work runs on the calling thread. 0 disables
+// parallel execution entirely.
+void set_threshold(int64_t p_threshold);
+int64_t get_threshold();
+
+// Smallest range handed to a single task
+constexpr int64_t MIN_CHUNK_SIZE = 4096;
+
+namespace internal {
+template <typename F>
+struct Task {
+	const F *function;
+	int64_t count;
+	int64_t chunk_size;
+};
+
+template <typename F>
+void run_chunk(void *p_userdata, uint32_t p_index) {
+	const Task<F> *task = static_cast<const Task<F> *>(p_userdata);
+	int64_t begin = (int64_t)p_index * task->chunk_size;
+	int64_t end = begin + task->chunk_size;
+	if (end > task->count) {
+		end = task->count;
+	}
+	(*task->function)(begin, end);
+}
+} // namespace internal
+
+// Calls p_function(begin, end) over disjoint ranges covering [0, p_count).
+// Blocks until every range is done.
+template <typename F>
+void for_range(int64_t p_count, const F &p_function) {
+	int64_t threshold = get_threshold();
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (threshold <= 0 || p_count < threshold || pool == nullptr) {
+		p_function(0, p_count);
+		return;
+	}
+
+	// A few chunks per core to even out uneven work, never tiny ones
+	int64_t max_chunks = (int64_t)OS::get_singleton()->get_processor_count() * 4;
+	int64_t chunks = (p_count + MIN_CHUNK_SIZE - 1) / MIN_CHUNK_SIZE;
+	if (chunks > max_chunks) {
+		chunks = max_chunks;
+	}
+	if (chunks <= 1) {
+		p_function(0, p_count);
+		return;
+	}
+
+	internal::Task<F> task = { &p_function, p_count, (p_count + chunks - 1) / chunks };
+	chunks = (p_count + task.chunk_size - 1) / task.chunk_size;
+	int64_t group = pool->add_native_group_task(&internal::run_chunk<F>, &task, (int)chunks, -1, true, "BigNumber batch");
+	pool->wait_for_group_task_completion(group);
+}
+} // namespace Parallel
@@ -0,0 +1,94 @@
+#include "performance_monitors.hpp"
+
+#ifdef BIG_NUMBER_INSTRUMENTATION
+
+#include "core/instrumentation.hpp"
+
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+
+using namespace godot;
+
+namespace {
+enum Monitor {
+	MONITOR_OBJECTS_CREATED,
+	MONITOR_NORMALIZE_CALLS,
+	MONITOR_CALLS,
+	MONITOR_GROUP_CALLS,
+	MONITOR_GROUP_TIME = MONITOR_GROUP_CALLS + Instrumentation::GROUP_MAX,
+	MONITOR_GROUP_TIME_PER_CALL = MONITOR_GROUP_TIME + Instrumentation::GROUP_MAX,
+	MONITOR_MAX = MONITOR_GROUP_TIME_PER_CALL + Instrumentation::GROUP_MAX,
+};
+
+const char *GROUP_NAMES[] = { "arithmetic", "comparison", "format", "parse", "array" };
+static_assert(sizeof(GROUP_NAMES) / sizeof(GROUP_NAMES[0]) == Instrumentation::GROUP_MAX, "One name per group");
+
+String get_monitor_id(int p_monitor) {
+	switch (p_monitor) {
+		case MONITOR_OBJECTS_CREATED:
+			return "BigNumber/objects_created";
+		case MONITOR_NORMALIZE_CALLS:
+			return "BigNumber/normalize_calls";
+		case MONITOR_CALLS:
+			return "BigNumber/calls";
+	}
+	if (p_monitor < MONITOR_GROUP_TIME) {
+		return String("BigNumber/") + GROUP_NAMES[p_monitor - MONITOR_GROUP_CALLS] + "_calls";
+	}
+	if (p_monitor < MONITOR_GROUP_TIME_PER_CALL) {
+		return String("BigNumber/") + GROUP_NAMES[p_monitor - MONITOR_GROUP_TIME] + "_time_msec";
+	}
+	return String("BigNumber/") + GROUP_NAMES[p_monitor - MONITOR_GROUP_TIME_PER_CALL] + "_usec_per_call";
+}
+
+double get_monitor_value(int64_t p_monitor) {
+	Instrumentation::Totals totals = Instrumentation::get_totals();
+	switch (p_monitor) {
+		case MONITOR_OBJECTS_CREATED:
+			return (double)totals.counters[Instrumentation::COUNTER_OBJECTS_CREATED];
+		case MONITOR_NORMALIZE_CALLS:
+			return (double)totals.counters[Instrumentation::COUNTER_NORMALIZE];
+		case MONITOR_CALLS: {
+			int64_t calls = 0;
+			for (int i = 0; i < Instrumentation::GROUP_MAX; i++) {
+				calls += totals.calls[i];
+			}
+			return (double)calls;
+		}
+	}
+	if (p_monitor < MONITOR_GROUP_TIME) {
+		return (double)totals.calls[p_monitor - MONITOR_GROUP_CALLS];
+	}
+	if (p_monitor < MONITOR_GROUP_TIME_PER_CALL) {
+		return totals.get_estimated_milliseconds((Instrumentation::Group)(p_monitor - MONITOR_GROUP_TIME));
+	}
+	return totals.get_microseconds_per_call((Instrumentation::Group)(p_monitor - MONITOR_GROUP_TIME_PER_CALL));
+}
+} // namespace
+
+void PerformanceMonitors::register_monitors() {
+	Performance *performance = Performance::get_singleton();
+	ERR_FAIL_NULL_MSG(performance, "BigNumber Error: Performance is not available, monitors are not registered.");
+	for (int i = 0; i < MONITOR_MAX; i++) {
+		Array arguments;
+		arguments.push_back(i);
+		performance->add_custom_monitor(get_monitor_id(i), callable_mp_static(&get_monitor_value), arguments);
+	}
+}
+
+void PerformanceMonitors::unregister_monitors() {
+	Performance *performance = Performance::get_singleton();
+	if (performance == nullptr) {
+		return;
+	}
+	for (int i = 0; i < MONITOR_MAX; i++) {
+		String id = get_monitor_id(i);
+		if (performance->has_custom_monitor(id)) {
+			performance->remove_custom_monitor(id);
+		}
+	}
+}
+
+#endif // BIG_NUMBER_INSTRUMENTATION
@@ -0,0 +1,10 @@
+#pragma once
+
+// Registers the counters of core/instrumentation.hpp as custom monitors of
+// the Performance singleton, under "BigNumber/". They show in the debugger's
+// Monitors tab and can be read with Performance.get_custom_monitor().
+// Only built with BIG_NUMBER_INSTRUMENTATION.
+namespace PerformanceMonitors {
+void register_monitors();
+void unregister_monitors();
+} // namespace PerformanceMonitors
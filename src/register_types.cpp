@@ -1,5 +1,12 @@
 // Include your classes, that you want to expose to Godot
 #include "big_number.hpp"
+#include "big_number_accumulator.hpp"
+#include "big_number_array.hpp"
+#include "big_number_formula.hpp"
+#include "big_number_label.hpp"
+#include "big_number_ledger.hpp"
+#include "big_number_log.hpp"
+#include "performance_monitors.hpp"
 
 #include <gdextension_interface.h>
 #include <godot_cpp/core/class_db.hpp>
@@ -16,12 +23,26 @@ void initialize_gdextension_types(ModuleInitializationLevel p_level)
 
 	// Register your classes here, so they are available in the Godot editor and engine
 	GDREGISTER_CLASS(BigNumber)
+	GDREGISTER_CLASS(BigNumberAccumulator)
+	GDREGISTER_CLASS(BigNumberArray)
+	GDREGISTER_CLASS(BigNumberFormula)
+	GDREGISTER_CLASS(BigNumberLabel)
+	GDREGISTER_CLASS(BigNumberLedger)
+	GDREGISTER_CLASS(BigNumberLog)
+
+#ifdef BIG_NUMBER_INSTRUMENTATION
+	PerformanceMonitors::register_monitors();
+#endif
 }
 
 void uninitialize_gdextension_types(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+
+#ifdef BIG_NUMBER_INSTRUMENTATION
+	PerformanceMonitors::unregister_monitors();
+#endif
 }
 
 extern "C"
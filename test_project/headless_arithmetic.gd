@@ -0,0 +1,49 @@
+extends SceneTree
+## Headless test for the fused BigNumber arithmetic.
+##
+## Checks [method BigNumber.fma_equals], [method BigNumber.scale_add_equals]
+## and [method BigNumber.mul_add_into] with factors far outside the mantissa
+## range, which must be normalized before the product is added.[br][br]
+## Run from the repository root:[br]
+## [code]godot --headless --path test_project --script res://headless_arithmetic.gd[/code][br][br]
+## Exits with code 1 if any result differs.
+
+
+var failures: int = 0
+
+
+func _initialize() -> void:
+	# A large scale on a tiny number, and a tiny scale on a large number
+	_expect(_make(1.0, 0).scale_add_equals(_make(1.0, -300), 1e300), 2.0, 0, "scale_add_equals with a large scale")
+	_expect(_make(1.0, 0).scale_add_equals(_make(1.0, 300), 1e-300), 2.0, 0, "scale_add_equals with a tiny scale")
+	_expect(_make(1.0, 0).scale_add_equals(1.0, 1e300), 1.0, 300, "scale_add_equals to 1e300")
+	_expect(_make(5.0, 0).scale_add_equals(2.0, -1.5), 2.0, 0, "scale_add_equals with a negative scale")
+
+	# Two large float factors must not overflow the product
+	_expect(_make(1.0, 0).fma_equals(1e200, 1e200), 1.0, 400, "fma_equals of two large floats")
+	_expect(_make(1.0, 400).fma_equals(1e200, 1e200), 2.0, 400, "fma_equals onto 1e400")
+	_expect(_make(3.0, 0).fma_equals(1e-200, 1e200), 4.0, 0, "fma_equals of a tiny and a large float")
+
+	var out: BigNumber = BigNumber.new()
+	_expect(BigNumber.mul_add_into(out, 1e200, 1e200, 1.0), 1.0, 400, "mul_add_into of two large floats")
+	_expect(BigNumber.mul_add_into(out, _make(2.0, 150), _make(3.0, -140), 4.0), 6.0, 10, "mul_add_into")
+
+	if failures > 0:
+		printerr("FAILED: %d mismatches" % failures)
+		quit(1)
+	else:
+		print("OK")
+		quit(0)
+
+
+func _make(mantissa: float, exponent: int) -> BigNumber:
+	var number: BigNumber = BigNumber.new()
+	number.mantissa = mantissa
+	number.exponent = exponent
+	return number
+
+
+func _expect(result: BigNumber, mantissa: float, exponent: int, what: String) -> void:
+	if result.exponent != exponent or not is_equal_approx(result.mantissa, mantissa):
+		failures += 1
+		printerr("%s gave %se%d instead of %se%d" % [what, result.mantissa, result.exponent, mantissa, exponent])
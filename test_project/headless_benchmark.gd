@@ -0,0 +1,1185 @@
+extends SceneTree
+## Headless benchmark suite for the BigNumber GDExtension.
+##
+## Times every bound method of [BigNumber], [BigNumberArray] and [BigNumberLabel],
+## and the main calls of [BigNumberFormula], [BigNumberLedger],
+## [BigNumberAccumulator] and [BigNumberLog], with a warmup pass followed by
+## repeated trials. Reports the median, p95 and p99 time per call together
+## with the [BigNumber] allocations per call.[br][br]
+## Run from the repository root:[br]
+## [code]godot --headless --path test_project --script res://headless_benchmark.gd -- --output=run.json[/code][br][br]
+## Options, after [code]--[/code]:[br]
+## [code]--output=<file>[/code] writes the JSON report to a file instead of stdout.[br]
+## [code]--trials=<n>[/code] number of timed trials per case.[br]
+## [code]--iterations=<n>[/code] calls per trial, divided by the weight of heavy cases.[br]
+## [code]--warmup=<n>[/code] untimed calls before the trials.[br]
+## [code]--filter=<text>[/code] only runs cases whose name contains the text.[br][br]
+## Two reports can be compared with [code]python tools/compare_benchmarks.py old.json new.json[/code].
+
+
+## Version of the JSON report layout.
+const REPORT_VERSION: int = 1
+## Number of elements in the benchmarked [BigNumberArray] instances.
+const ARRAY_SIZE: int = 256
+
+## Timed trials per case.
+var trials: int = 30
+## Calls per trial.
+var iterations: int = 2000
+## Untimed calls before the trials.
+var warmup: int = 500
+## Only cases whose name contains this are run.
+var filter: String = ""
+## Report file, stdout when empty.
+var output_path: String = ""
+
+## Registered cases, in run order.
+var cases: Array[Dictionary] = []
+
+# Fixtures shared by the cases
+var a: BigNumber
+var b: BigNumber
+var c: BigNumber
+var small: BigNumber
+var b_small: BigNumber
+var two: BigNumber
+var out: BigNumber
+var options: Dictionary
+var floats: PackedFloat64Array
+var ints: PackedInt64Array
+var array_a: BigNumberArray
+var array_b: BigNumberArray
+var array_c: BigNumberArray
+var label: BigNumberLabel
+var strings: PackedStringArray
+var bytes: PackedByteArray
+var encoded: PackedByteArray
+var values: Array
+var growths: PackedFloat64Array
+var owned: PackedInt64Array
+var counts: PackedInt64Array
+var sort_keys: PackedInt64Array
+var array_bytes: PackedByteArray
+var increments: BigNumberArray
+var formula: BigNumberFormula
+var formula_values: Array
+var formula_batch_values: Array
+var ledger: BigNumberLedger
+var accumulator: BigNumberAccumulator
+var log_a: BigNumberLog
+var log_b: BigNumberLog
+
+
+func _initialize() -> void:
+	_parse_arguments()
+	_setup_fixtures()
+	_register_cases()
+
+	var results: Dictionary = {}
+	for case: Dictionary in cases:
+		var case_name: String = case.name
+		if not filter.is_empty() and not case_name.contains(filter):
+			continue
+		_reset_fixtures()
+		results[case_name] = _run_case(case)
+		printerr("%-40s %10.1f ns" % [case_name, results[case_name].median_ns])
+
+	var report: Dictionary = {
+		"report_version": REPORT_VERSION,
+		"engine": Engine.get_version_info().string,
+		"os": OS.get_name(),
+		"processor": OS.get_processor_name(),
+		"build": "debug" if OS.is_debug_build() else "release",
+		"date": Time.get_datetime_string_from_system(true),
+		"trials": trials,
+		"iterations": iterations,
+		"warmup": warmup,
+		"results": results,
+	}
+	var json: String = JSON.stringify(report, "\t")
+	if output_path.is_empty():
+		print(json)
+	else:
+		var file: FileAccess = FileAccess.open(output_path, FileAccess.WRITE)
+		if file == null:
+			printerr("Could not write %s: %s" % [output_path, error_string(FileAccess.get_open_error())])
+		else:
+			file.store_string(json)
+			file.close()
+			printerr("Report written to %s" % output_path)
+
+	BigNumber.set_format_cache_capacity(0)
+	label.free()
+	quit()
+
+
+## Reads the options passed after [code]--[/code].
+func _parse_arguments() -> void:
+	for argument: String in OS.get_cmdline_user_args():
+		var key: String = argument.get_slice("=", 0)
+		var value: String = argument.get_slice("=", 1)
+		match key:
+			"--output":
+				output_path = value
+			"--trials":
+				trials = maxi(1, value.to_int())
+			"--iterations":
+				iterations = maxi(1, value.to_int())
+			"--warmup":
+				warmup = maxi(0, value.to_int())
+			"--filter":
+				filter = value
+			_:
+				printerr("Unknown option %s" % argument)
+
+
+func _setup_fixtures() -> void:
+	a = _make(1.23456, 50)
+	b = _make(5.0, 40)
+	small = _make(1.2345678, 4)
+	b_small = _make(7.5, 0)
+	two = _make(2.0, 0)
+	out = BigNumber.new()
+	options = BigNumber.get_options().duplicate()
+
+	for i: int in ARRAY_SIZE:
+		floats.append(1.5 * (i + 1))
+		ints.append(i * 1000 + 1)
+	array_a = BigNumberArray.new()
+	array_a.set_from_floats(floats)
+	array_b = array_a.duplicate()
+	array_c = BigNumberArray.new()
+
+	label = BigNumberLabel.new()
+
+	for i: int in ARRAY_SIZE:
+		strings.append("%de%d" % [i + 1, i % 60])
+		values.append(_make(1.5, i % 60))
+		growths.append(1.07 + 0.001 * (i % 10))
+		owned.append(i)
+		counts.append(10)
+	bytes = a.to_bytes()
+	sort_keys = array_a.to_sort_keys()
+	array_bytes = array_a.to_bytes()
+	increments = array_a.duplicate()
+	encoded = BigNumber.encode_array(values)
+
+	formula = BigNumberFormula.new()
+	formula.compile("base * growth ^ level * (1 - discount)", ["base", "growth", "level", "discount"])
+	formula_values = [a, 1.07, 25, 0.1]
+	formula_batch_values = [a, 1.07, ints, 0.1]
+
+	ledger = BigNumberLedger.new()
+	ledger.set_tier_count(3)
+	ledger.set_amount(0, 100)
+	ledger.set_amount(1, 5)
+	ledger.set_rate(1, 2)
+	ledger.set_amount(2, 1)
+	ledger.set_rate(2, 0.1)
+
+	accumulator = BigNumberAccumulator.new()
+	log_b = BigNumberLog.from_value(b)
+
+
+## Restores the fixtures that cases modify in-place.
+func _reset_fixtures() -> void:
+	c = _make(1.23456, 50)
+	array_c.set_from_floats(floats)
+	label.set_number(a)
+	log_a = BigNumberLog.from_value(a)
+
+
+func _make(mantissa: float, exponent: int) -> BigNumber:
+	var number: BigNumber = BigNumber.new()
+	number.mantissa = mantissa
+	number.exponent = exponent
+	return number
+
+
+## Registers a case. [param body] receives the number of calls to make.
+## Heavy cases get a [param weight] above 1 to run fewer calls per trial.
+func _add_case(case_name: String, weight: int, body: Callable) -> void:
+	cases.append({"name": case_name, "weight": weight, "body": body})
+
+
+## Times a case and returns its statistics, in nanoseconds per call.
+func _run_case(case: Dictionary) -> Dictionary:
+	var body: Callable = case.body
+	var calls: int = maxi(1, iterations / int(case.weight))
+
+	body.call(maxi(1, warmup / int(case.weight)))
+
+	var samples: PackedFloat64Array = []
+	var total: float = 0.0
+	BigNumber.reset_allocation_count()
+	for trial: int in trials:
+		var start: int = Time.get_ticks_usec()
+		body.call(calls)
+		var elapsed: float = (Time.get_ticks_usec() - start) * 1000.0 / calls
+		samples.append(elapsed)
+		total += elapsed
+	var allocations: int = BigNumber.get_allocation_count()
+	samples.sort()
+
+	return {
+		"calls_per_trial": calls,
+		"min_ns": samples[0],
+		"median_ns": _percentile(samples, 0.5),
+		"p95_ns": _percentile(samples, 0.95),
+		"p99_ns": _percentile(samples, 0.99),
+		"max_ns": samples[samples.size() - 1],
+		"mean_ns": total / samples.size(),
+		"allocations_per_call": float(allocations) / (calls * trials),
+	}
+
+
+## Percentile of sorted samples, interpolated between the two nearest ranks.
+## With the nearest rank alone, p99 of fewer than 100 trials is always the max.
+func _percentile(sorted: PackedFloat64Array, fraction: float) -> float:
+	var position: float = fraction * (sorted.size() - 1)
+	var lower: int = floori(position)
+	var upper: int = mini(lower + 1, sorted.size() - 1)
+	return lerpf(sorted[lower], sorted[upper], position - lower)
+
+
+## Every benchmarked call. [code]reset_allocation_count[/code] is left out, the
+## runner uses it to measure allocations.
+func _register_cases() -> void:
+	_add_case("empty_loop", 1, func(n: int) -> void:
+		for i: int in n:
+			pass
+	)
+	_add_case("new", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.new()
+	)
+	_add_case("plus", 1, func(n: int) -> void:
+		for i: int in n:
+			a.plus(b)
+	)
+	_add_case("plus_variant_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.plus(7)
+	)
+	_add_case("plus_variant_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.plus(2.5)
+	)
+	_add_case("plus_variant_string", 1, func(n: int) -> void:
+		for i: int in n:
+			a.plus("5e40")
+	)
+	_add_case("plus_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.plus_big(b)
+	)
+	_add_case("plus_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.plus_int(7)
+	)
+	_add_case("plus_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.plus_float(2.5)
+	)
+	_add_case("plus_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.plus_equals(b)
+	)
+	_add_case("plus_equals_big", 1, func(n: int) -> void:
+		for i: int in n:
+			c.plus_equals_big(b)
+	)
+	_add_case("plus_equals_int", 1, func(n: int) -> void:
+		for i: int in n:
+			c.plus_equals_int(7)
+	)
+	_add_case("plus_equals_float", 1, func(n: int) -> void:
+		for i: int in n:
+			c.plus_equals_float(2.5)
+	)
+	_add_case("minus", 1, func(n: int) -> void:
+		for i: int in n:
+			a.minus(b)
+	)
+	_add_case("minus_variant_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.minus(7)
+	)
+	_add_case("minus_variant_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.minus(2.5)
+	)
+	_add_case("minus_variant_string", 1, func(n: int) -> void:
+		for i: int in n:
+			a.minus("5e40")
+	)
+	_add_case("minus_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.minus_big(b)
+	)
+	_add_case("minus_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.minus_int(7)
+	)
+	_add_case("minus_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.minus_float(2.5)
+	)
+	_add_case("minus_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.minus_equals(b)
+	)
+	_add_case("minus_equals_big", 1, func(n: int) -> void:
+		for i: int in n:
+			c.minus_equals_big(b)
+	)
+	_add_case("minus_equals_int", 1, func(n: int) -> void:
+		for i: int in n:
+			c.minus_equals_int(7)
+	)
+	_add_case("minus_equals_float", 1, func(n: int) -> void:
+		for i: int in n:
+			c.minus_equals_float(2.5)
+	)
+	_add_case("multiply", 1, func(n: int) -> void:
+		for i: int in n:
+			a.multiply(b)
+	)
+	_add_case("multiply_variant_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.multiply(7)
+	)
+	_add_case("multiply_variant_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.multiply(2.5)
+	)
+	_add_case("multiply_variant_string", 1, func(n: int) -> void:
+		for i: int in n:
+			a.multiply("5e40")
+	)
+	_add_case("multiply_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.multiply_big(b)
+	)
+	_add_case("multiply_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.multiply_int(7)
+	)
+	_add_case("multiply_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.multiply_float(2.5)
+	)
+	_add_case("multiply_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.multiply_equals(b)
+	)
+	_add_case("multiply_equals_big", 1, func(n: int) -> void:
+		for i: int in n:
+			c.multiply_equals_big(b)
+	)
+	_add_case("multiply_equals_int", 1, func(n: int) -> void:
+		for i: int in n:
+			c.multiply_equals_int(7)
+	)
+	_add_case("multiply_equals_float", 1, func(n: int) -> void:
+		for i: int in n:
+			c.multiply_equals_float(2.5)
+	)
+	_add_case("divide", 1, func(n: int) -> void:
+		for i: int in n:
+			a.divide(b)
+	)
+	_add_case("divide_variant_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.divide(7)
+	)
+	_add_case("divide_variant_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.divide(2.5)
+	)
+	_add_case("divide_variant_string", 1, func(n: int) -> void:
+		for i: int in n:
+			a.divide("5e40")
+	)
+	_add_case("divide_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.divide_big(b)
+	)
+	_add_case("divide_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.divide_int(7)
+	)
+	_add_case("divide_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.divide_float(2.5)
+	)
+	_add_case("divide_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.divide_equals(b)
+	)
+	_add_case("divide_equals_big", 1, func(n: int) -> void:
+		for i: int in n:
+			c.divide_equals_big(b)
+	)
+	_add_case("divide_equals_int", 1, func(n: int) -> void:
+		for i: int in n:
+			c.divide_equals_int(7)
+	)
+	_add_case("divide_equals_float", 1, func(n: int) -> void:
+		for i: int in n:
+			c.divide_equals_float(2.5)
+	)
+	_add_case("is_less_than", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_less_than(b)
+	)
+	_add_case("is_less_than_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_less_than_big(b)
+	)
+	_add_case("is_less_than_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_less_than_int(7)
+	)
+	_add_case("is_less_than_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_less_than_float(2.5)
+	)
+	_add_case("is_equal_to", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_equal_to(b)
+	)
+	_add_case("is_equal_to_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_equal_to_big(b)
+	)
+	_add_case("is_equal_to_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_equal_to_int(7)
+	)
+	_add_case("is_equal_to_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_equal_to_float(2.5)
+	)
+	_add_case("is_greater_than", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_greater_than(b)
+	)
+	_add_case("is_greater_than_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_greater_than_big(b)
+	)
+	_add_case("is_greater_than_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_greater_than_int(7)
+	)
+	_add_case("is_greater_than_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_greater_than_float(2.5)
+	)
+	_add_case("is_less_than_or_equal_to", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_less_than_or_equal_to(b)
+	)
+	_add_case("is_less_than_or_equal_to_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_less_than_or_equal_to_big(b)
+	)
+	_add_case("is_less_than_or_equal_to_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_less_than_or_equal_to_int(7)
+	)
+	_add_case("is_less_than_or_equal_to_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_less_than_or_equal_to_float(2.5)
+	)
+	_add_case("is_greater_than_or_equal_to", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_greater_than_or_equal_to(b)
+	)
+	_add_case("is_greater_than_or_equal_to_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_greater_than_or_equal_to_big(b)
+	)
+	_add_case("is_greater_than_or_equal_to_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_greater_than_or_equal_to_int(7)
+	)
+	_add_case("is_greater_than_or_equal_to_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.is_greater_than_or_equal_to_float(2.5)
+	)
+	_add_case("mod", 1, func(n: int) -> void:
+		for i: int in n:
+			small.mod(b_small)
+	)
+	_add_case("power_int", 1, func(n: int) -> void:
+		for i: int in n:
+			a.power(2)
+	)
+	_add_case("power_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.power(1.5)
+	)
+	_add_case("power_big", 1, func(n: int) -> void:
+		for i: int in n:
+			a.power(two)
+	)
+	_add_case("power_equals_int", 1, func(n: int) -> void:
+		for i: int in n:
+			c.power_equals(1)
+	)
+	_add_case("power_equals_float", 1, func(n: int) -> void:
+		for i: int in n:
+			c.power_equals(1.0001)
+	)
+	_add_case("square_root", 1, func(n: int) -> void:
+		for i: int in n:
+			a.square_root()
+	)
+	_add_case("absolute", 1, func(n: int) -> void:
+		for i: int in n:
+			a.absolute()
+	)
+	_add_case("log10", 1, func(n: int) -> void:
+		for i: int in n:
+			a.log10()
+	)
+	_add_case("ln", 1, func(n: int) -> void:
+		for i: int in n:
+			a.ln()
+	)
+	_add_case("floor_value", 1, func(n: int) -> void:
+		for i: int in n:
+			small.floor_value()
+	)
+	_add_case("to_float", 1, func(n: int) -> void:
+		for i: int in n:
+			a.to_float()
+	)
+	_add_case("to_plain_scientific", 1, func(n: int) -> void:
+		for i: int in n:
+			a.to_plain_scientific()
+	)
+	_add_case("to_string", 1, func(n: int) -> void:
+		for i: int in n:
+			str(a)
+	)
+	_add_case("get_mantissa", 1, func(n: int) -> void:
+		for i: int in n:
+			a.get_mantissa()
+	)
+	_add_case("set_mantissa", 1, func(n: int) -> void:
+		for i: int in n:
+			c.set_mantissa(2.5)
+	)
+	_add_case("get_exponent", 1, func(n: int) -> void:
+		for i: int in n:
+			a.get_exponent()
+	)
+	_add_case("set_exponent", 1, func(n: int) -> void:
+		for i: int in n:
+			c.set_exponent(60)
+	)
+	_add_case("normalize", 1, func(n: int) -> void:
+		for i: int in n:
+			c.normalize()
+	)
+	_add_case("add_into", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.add_into(out, a, b)
+	)
+	_add_case("subtract_into", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.subtract_into(out, a, b)
+	)
+	_add_case("multiply_into", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.multiply_into(out, a, b)
+	)
+	_add_case("divide_into", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.divide_into(out, a, b)
+	)
+	_add_case("mod_into", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.mod_into(out, small, b_small)
+	)
+	_add_case("pow_into", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.pow_into(out, a, 2)
+	)
+	_add_case("sqrt_into", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.sqrt_into(out, a)
+	)
+	_add_case("abs_into", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.abs_into(out, a)
+	)
+	_add_case("get_allocation_count", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.get_allocation_count()
+	)
+	_add_case("get_options", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.get_options()
+	)
+	_add_case("set_option", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.set_option(&"big_decimals", 2)
+	)
+	_add_case("set_options", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.set_options(options)
+	)
+	_add_case("get_options_version", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.get_options_version()
+	)
+	_add_case("to_scientific", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			a.to_scientific()
+	)
+	_add_case("to_prefix", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			a.to_prefix()
+	)
+	_add_case("to_aa", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			a.to_aa()
+	)
+	_add_case("to_metric_symbol", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			a.to_metric_symbol()
+	)
+	_add_case("to_metric_name", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			a.to_metric_name()
+	)
+	_add_case("to_short_scale", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			a.to_short_scale()
+	)
+	_add_case("to_scientific_small", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			small.to_scientific()
+	)
+	_add_case("to_prefix_small", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			small.to_prefix()
+	)
+	_add_case("format", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			a.format(BigNumber.NOTATION_AA, BigNumber.FORMAT_USE_THOUSAND_SYMBOL)
+	)
+	_add_case("to_scientific_cached", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(256)
+		for i: int in n:
+			a.to_scientific()
+	)
+	_add_case("to_prefix_cached", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(256)
+		for i: int in n:
+			a.to_prefix()
+	)
+	_add_case("to_aa_cached", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(256)
+		for i: int in n:
+			a.to_aa()
+	)
+	_add_case("to_metric_symbol_cached", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(256)
+		for i: int in n:
+			a.to_metric_symbol()
+	)
+	_add_case("to_metric_name_cached", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(256)
+		for i: int in n:
+			a.to_metric_name()
+	)
+	_add_case("to_short_scale_cached", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(256)
+		for i: int in n:
+			a.to_short_scale()
+	)
+	_add_case("to_scientific_small_cached", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(256)
+		for i: int in n:
+			small.to_scientific()
+	)
+	_add_case("to_prefix_small_cached", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(256)
+		for i: int in n:
+			small.to_prefix()
+	)
+	_add_case("format_cached", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(256)
+		for i: int in n:
+			a.format(BigNumber.NOTATION_AA, BigNumber.FORMAT_USE_THOUSAND_SYMBOL)
+	)
+	_add_case("get_format_cache_capacity", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.get_format_cache_capacity()
+	)
+	_add_case("get_format_cache_hits", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.get_format_cache_hits()
+	)
+	_add_case("get_format_cache_misses", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.get_format_cache_misses()
+	)
+	_add_case("clear_format_cache", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.clear_format_cache()
+	)
+	_add_case("set_format_cache_capacity", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.set_format_cache_capacity(0)
+	)
+	_add_case("array_resize", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.resize(ARRAY_SIZE)
+	)
+	_add_case("array_size", 1, func(n: int) -> void:
+		for i: int in n:
+			array_a.size()
+	)
+	_add_case("array_is_empty", 1, func(n: int) -> void:
+		for i: int in n:
+			array_a.is_empty()
+	)
+	_add_case("array_clear", 1, func(n: int) -> void:
+		for i: int in n:
+			array_c.clear()
+	)
+	_add_case("array_set_value", 1, func(n: int) -> void:
+		array_c.resize(ARRAY_SIZE)
+		for i: int in n:
+			array_c.set_value(0, a)
+	)
+	_add_case("array_set_value_int", 1, func(n: int) -> void:
+		array_c.resize(ARRAY_SIZE)
+		for i: int in n:
+			array_c.set_value(0, 7)
+	)
+	_add_case("array_set_value_float", 1, func(n: int) -> void:
+		array_c.resize(ARRAY_SIZE)
+		for i: int in n:
+			array_c.set_value(0, 2.5)
+	)
+	_add_case("array_set_value_string", 1, func(n: int) -> void:
+		array_c.resize(ARRAY_SIZE)
+		for i: int in n:
+			array_c.set_value(0, "5e40")
+	)
+	_add_case("array_get_value", 1, func(n: int) -> void:
+		for i: int in n:
+			array_a.get_value(0)
+	)
+	_add_case("array_get_mantissas", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.get_mantissas()
+	)
+	_add_case("array_set_mantissas", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.set_mantissas(floats)
+	)
+	_add_case("array_get_exponents", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.get_exponents()
+	)
+	_add_case("array_set_exponents", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.set_exponents(ints)
+	)
+	_add_case("array_set_from_parts", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.set_from_parts(floats, ints)
+	)
+	_add_case("array_set_from_floats", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.set_from_floats(floats)
+	)
+	_add_case("array_set_from_ints", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.set_from_ints(ints)
+	)
+	_add_case("array_to_floats", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.to_floats()
+	)
+	_add_case("array_normalize", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.normalize()
+	)
+	_add_case("array_plus_equals", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.plus_equals(b)
+	)
+	_add_case("array_plus_equals_array", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.plus_equals(array_b)
+	)
+	_add_case("array_minus_equals", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.minus_equals(b)
+	)
+	_add_case("array_minus_equals_array", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.minus_equals(array_b)
+	)
+	_add_case("array_multiply_equals", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.multiply_equals(2.5)
+	)
+	_add_case("array_multiply_equals_array", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.multiply_equals(array_b)
+	)
+	_add_case("array_divide_equals", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.divide_equals(2.5)
+	)
+	_add_case("array_divide_equals_array", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.divide_equals(array_b)
+	)
+	_add_case("array_power_equals", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.power_equals(1)
+	)
+	_add_case("array_power_equals_array", 20, func(n: int) -> void:
+		array_c.set_from_floats(floats)
+		for i: int in n:
+			array_c.power_equals(array_b)
+	)
+	_add_case("array_compare", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.compare(b)
+	)
+	_add_case("array_duplicate", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.duplicate()
+	)
+	_add_case("label_set_number", 1, func(n: int) -> void:
+		for i: int in n:
+			label.set_number(a)
+	)
+	_add_case("label_refresh", 1, func(n: int) -> void:
+		for i: int in n:
+			label.refresh()
+	)
+	_add_case("label_process_unchanged", 1, func(n: int) -> void:
+		label.set_refresh_rate(0.0)
+		for i: int in n:
+			label.notification(Node.NOTIFICATION_INTERNAL_PROCESS)
+	)
+	_add_case("label_process_changed", 1, func(n: int) -> void:
+		label.set_number(c)
+		for i: int in n:
+			c.multiply_equals_float(1.01)
+			label.notification(Node.NOTIFICATION_INTERNAL_PROCESS)
+	)
+	_add_case("label_set_notation", 1, func(n: int) -> void:
+		for i: int in n:
+			label.set_notation(BigNumber.NOTATION_AA)
+	)
+	_add_case("label_set_format_flags", 1, func(n: int) -> void:
+		for i: int in n:
+			label.set_format_flags(BigNumber.FORMAT_USE_THOUSAND_SYMBOL)
+	)
+	_add_case("label_get_number", 1, func(n: int) -> void:
+		for i: int in n:
+			label.get_number()
+	)
+	_add_case("label_get_notation", 1, func(n: int) -> void:
+		for i: int in n:
+			label.get_notation()
+	)
+	_add_case("label_get_format_flags", 1, func(n: int) -> void:
+		for i: int in n:
+			label.get_format_flags()
+	)
+	_add_case("label_get_refresh_rate", 1, func(n: int) -> void:
+		for i: int in n:
+			label.get_refresh_rate()
+	)
+	_add_case("label_set_refresh_rate", 1, func(n: int) -> void:
+		for i: int in n:
+			label.set_refresh_rate(0.0)
+	)
+	_register_later_cases()
+
+
+## Cases of the methods and classes added after the first suite.
+func _register_later_cases() -> void:
+	_add_case("parse", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.parse("1.23e50")
+	)
+	_add_case("parse_aa", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.parse("12.35ab")
+	)
+	_add_case("to_long_name", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			a.to_long_name()
+	)
+	_add_case("to_bytes", 1, func(n: int) -> void:
+		for i: int in n:
+			a.to_bytes()
+	)
+	_add_case("from_bytes", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.from_bytes(bytes)
+	)
+	_add_case("encode_array", 20, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.encode_array(values)
+	)
+	_add_case("decode_array", 20, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.decode_array(encoded)
+	)
+	_add_case("to_sort_key", 1, func(n: int) -> void:
+		for i: int in n:
+			a.to_sort_key()
+	)
+	_add_case("from_sort_key", 1, func(n: int) -> void:
+		var key: int = a.to_sort_key()
+		for i: int in n:
+			BigNumber.from_sort_key(key)
+	)
+	_add_case("fma_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.fma_equals(b_small, small)
+	)
+	_add_case("mul_add", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.mul_add(a, b_small, small)
+	)
+	_add_case("mul_add_into", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.mul_add_into(out, a, b_small, small)
+	)
+	_add_case("scale_add_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.scale_add_equals(b, 0.5)
+	)
+	_add_case("min_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.min_equals(a)
+	)
+	_add_case("max_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.max_equals(a)
+	)
+	_add_case("clamp_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.clamp_equals(b, a)
+	)
+	_add_case("lerp_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			c.lerp_equals(a, 0.5)
+	)
+	_add_case("lerp_equals_logarithmic", 1, func(n: int) -> void:
+		for i: int in n:
+			c.lerp_equals(a, 0.5, true)
+	)
+	_add_case("sum_of", 20, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.sum_of(values)
+	)
+	_add_case("cost_of_n", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.cost_of_n(a, 1.07, 100, 10)
+	)
+	_add_case("max_affordable", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.max_affordable(b, 1.07, 100, a)
+	)
+	_add_case("cost_of_n_linear", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.cost_of_n_linear(b, b_small, 100, 10)
+	)
+	_add_case("max_affordable_linear", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumber.max_affordable_linear(b, b_small, 100, a)
+	)
+	_add_case("array_set_from_strings", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.set_from_strings(strings)
+	)
+	_add_case("array_set_from_values", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.set_from_values(values)
+	)
+	_add_case("array_format", 20, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			array_a.format(BigNumber.NOTATION_AA)
+	)
+	_add_case("array_to_bytes", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.to_bytes()
+	)
+	_add_case("array_from_bytes", 20, func(n: int) -> void:
+		for i: int in n:
+			BigNumberArray.from_bytes(array_bytes)
+	)
+	_add_case("array_to_sort_keys", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.to_sort_keys()
+	)
+	_add_case("array_set_from_sort_keys", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.set_from_sort_keys(sort_keys)
+	)
+	_add_case("array_get_parallel_threshold", 1, func(n: int) -> void:
+		for i: int in n:
+			BigNumberArray.get_parallel_threshold()
+	)
+	_add_case("array_set_parallel_threshold", 1, func(n: int) -> void:
+		var threshold: int = BigNumberArray.get_parallel_threshold()
+		for i: int in n:
+			BigNumberArray.set_parallel_threshold(threshold)
+	)
+	_add_case("array_sum", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.sum()
+	)
+	_add_case("array_product", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.product()
+	)
+	_add_case("array_mean", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.mean()
+	)
+	_add_case("array_log_sum_exp", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.log_sum_exp()
+	)
+	_add_case("array_min", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.min()
+	)
+	_add_case("array_max", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.max()
+	)
+	_add_case("array_argmin", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.argmin()
+	)
+	_add_case("array_argmax", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.argmax()
+	)
+	_add_case("array_argsort", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.argsort()
+	)
+	_add_case("array_sort", 20, func(n: int) -> void:
+		for i: int in n:
+			array_c.sort(i % 2 == 0)
+	)
+	_add_case("array_sort_values", 20, func(n: int) -> void:
+		var unsorted: Array = values.duplicate()
+		for i: int in n:
+			BigNumberArray.sort_values(unsorted, i % 2 == 0)
+	)
+	_add_case("array_top_k", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.top_k(10)
+	)
+	_add_case("array_cost_of_n", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.cost_of_n(growths, owned, counts)
+	)
+	_add_case("array_max_affordable", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.max_affordable(growths, owned, a)
+	)
+	_add_case("array_cost_of_n_linear", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.cost_of_n_linear(increments, owned, counts)
+	)
+	_add_case("array_max_affordable_linear", 20, func(n: int) -> void:
+		for i: int in n:
+			array_a.max_affordable_linear(increments, owned, a)
+	)
+	_add_case("formula_evaluate", 1, func(n: int) -> void:
+		for i: int in n:
+			formula.evaluate(formula_values)
+	)
+	_add_case("formula_evaluate_into", 1, func(n: int) -> void:
+		for i: int in n:
+			formula.evaluate_into(out, formula_values)
+	)
+	_add_case("formula_evaluate_batch", 20, func(n: int) -> void:
+		for i: int in n:
+			formula.evaluate_batch(formula_batch_values)
+	)
+	_add_case("ledger_predict", 1, func(n: int) -> void:
+		for i: int in n:
+			ledger.predict(0, 3600.0)
+	)
+	_add_case("ledger_advance", 1, func(n: int) -> void:
+		for i: int in n:
+			ledger.advance(1.0)
+	)
+	_add_case("accumulator_add", 1, func(n: int) -> void:
+		accumulator.clear()
+		for i: int in n:
+			accumulator.add(b_small)
+	)
+	_add_case("accumulator_add_float", 1, func(n: int) -> void:
+		accumulator.clear()
+		for i: int in n:
+			accumulator.add_float(0.25)
+	)
+	_add_case("accumulator_flush_into", 1, func(n: int) -> void:
+		for i: int in n:
+			accumulator.add_float(0.25)
+			accumulator.flush_into(c)
+	)
+	_add_case("log_multiply_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			log_a.multiply_equals(log_b)
+	)
+	_add_case("log_plus_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			log_a.plus_equals(log_b)
+	)
+	_add_case("log_power_equals", 1, func(n: int) -> void:
+		for i: int in n:
+			log_a.power_equals(1.0001)
+	)
+	_add_case("log_to_aa", 1, func(n: int) -> void:
+		BigNumber.set_format_cache_capacity(0)
+		for i: int in n:
+			log_a.to_aa()
+	)
@@ -0,0 +1,64 @@
+extends SceneTree
+## Headless test for the BigNumber bulk-buy methods.
+##
+## Checks [method BigNumber.cost_of_n] against the series summed level by
+## level, and that [method BigNumber.max_affordable] returns the largest
+## count whose finite cost fits the budget, including growth rates within
+## 1e-8 of 1 where the closed-form series divides by a tiny step.[br][br]
+## Run from the repository root:[br]
+## [code]godot --headless --path test_project --script res://headless_bulk_buy.gd[/code][br][br]
+## Exits with code 1 if any result differs.
+
+
+var failures: int = 0
+
+
+func _initialize() -> void:
+	_check_sum(10.0, 1.15, 0, 10)
+	_check_sum(3.5, 1.07, 25, 40)
+	_check_sum(100.0, 0.9, 3, 20)
+
+	_check_max(_make(1.0, 1), 1.15, 0, _make(1.0, 6))
+	_check_max(_make(2.5, 3), 1.07, 120, _make(4.2, 40))
+	# growth - 1 is about 1.8e-9, the series passes the double range
+	_check_max(_make(6.35395, 24), 1.0000000017959769, 44, _make(1.56426, 333))
+	_check_max(_make(1.0, 0), 1.000000001, 0, _make(1.0, 320))
+
+	if failures > 0:
+		printerr("FAILED: %d mismatches" % failures)
+		quit(1)
+	else:
+		print("OK")
+		quit(0)
+
+
+func _make(mantissa: float, exponent: int) -> BigNumber:
+	var number: BigNumber = BigNumber.new()
+	number.mantissa = mantissa
+	number.exponent = exponent
+	return number
+
+
+func _check_sum(base: float, growth: float, owned: int, count: int) -> void:
+	var expected: float = 0.0
+	for level: int in range(owned, owned + count):
+		expected += base * pow(growth, level)
+	var cost: float = BigNumber.cost_of_n(base, growth, owned, count).to_float()
+	if not is_equal_approx(cost, expected):
+		_fail("cost_of_n(%s, %s, %d, %d) gave %s instead of %s" % [base, growth, owned, count, cost, expected])
+
+
+func _check_max(base: BigNumber, growth: float, owned: int, budget: BigNumber) -> void:
+	var what: String = "max_affordable(%s, %s, %d, %s)" % [base, growth, owned, budget]
+	var count: int = BigNumber.max_affordable(base, growth, owned, budget)
+	var cost: BigNumber = BigNumber.cost_of_n(base, growth, owned, count)
+	var next_cost: BigNumber = BigNumber.cost_of_n(base, growth, owned, count + 1)
+	if not is_finite(cost.mantissa) or not is_finite(next_cost.mantissa):
+		_fail("%s gave %d with a cost of %s" % [what, count, cost.mantissa])
+	elif budget.is_less_than(cost) or not budget.is_less_than(next_cost):
+		_fail("%s gave %d, not the largest count that fits" % [what, count])
+
+
+func _fail(message: String) -> void:
+	failures += 1
+	printerr(message)
@@ -0,0 +1,115 @@
+extends SceneTree
+## Headless round-trip test for the binary encoding of BigNumber values.
+##
+## Checks that [method BigNumber.to_bytes], [method BigNumber.encode_array]
+## and [method BigNumberArray.to_bytes] restore the exact mantissa and
+## exponent through every matching decoder, and that truncated data, a wrong
+## version or kind, and trailing bytes are all rejected.[br][br]
+## Run from the repository root:[br]
+## [code]godot --headless --path test_project --script res://headless_codec.gd[/code][br][br]
+## Exits with code 1 if any result differs.
+
+
+## Mantissas and exponents encoded, covering the one and multi-byte exponents.
+const MANTISSAS: Array[float] = [1.0, 0.0, 2.5, 9.999999999999998, 1.2345678901234567, 3.0, 7.7, 5.0]
+const EXPONENTS: Array[int] = [0, 0, 63, -64, 64, -1000000, 9007199254740993, -9223372036854775807]
+
+var failures: int = 0
+
+
+func _initialize() -> void:
+	var numbers: Array = []
+	for i: int in MANTISSAS.size():
+		numbers.append(_make(MANTISSAS[i], EXPONENTS[i]))
+
+	for number: BigNumber in numbers:
+		var bytes: PackedByteArray = number.to_bytes()
+		_expect_same(BigNumber.from_bytes(bytes), number, "to_bytes")
+		_expect_rejected_value(bytes)
+
+	var encoded: PackedByteArray = BigNumber.encode_array(numbers)
+	var decoded: Array = BigNumber.decode_array(encoded)
+	if decoded.size() != numbers.size():
+		_fail("decode_array gave %d values instead of %d" % [decoded.size(), numbers.size()])
+	else:
+		for i: int in numbers.size():
+			_expect_same(decoded[i], numbers[i], "encode_array")
+	_expect_array(BigNumberArray.from_bytes(encoded), numbers, "encode_array into BigNumberArray")
+	_expect_rejected_array(encoded)
+
+	# Negative and unnormalized mantissas are stored bit for bit
+	var array: BigNumberArray = BigNumberArray.new()
+	array.set_from_parts(PackedFloat64Array([-4.5, 12.0, -0.0, 0.001]), PackedInt64Array([3, -3, 0, 500]))
+	var array_bytes: PackedByteArray = array.to_bytes()
+	var restored: BigNumberArray = BigNumberArray.from_bytes(array_bytes)
+	if restored == null or restored.get_mantissas() != array.get_mantissas() or restored.get_exponents() != array.get_exponents():
+		_fail("BigNumberArray.to_bytes did not round-trip")
+	elif var_to_bytes(restored.get_mantissas()) != var_to_bytes(array.get_mantissas()):
+		_fail("BigNumberArray.to_bytes changed the mantissa bits")
+	_expect_rejected_array(array_bytes)
+
+	# Empty arrays round-trip too
+	if BigNumber.decode_array(BigNumber.encode_array([])).size() != 0:
+		_fail("the empty array did not round-trip")
+
+	if failures > 0:
+		printerr("FAILED: %d mismatches" % failures)
+		quit(1)
+	else:
+		print("OK")
+		quit(0)
+
+
+func _make(mantissa: float, exponent: int) -> BigNumber:
+	var number: BigNumber = BigNumber.new()
+	number.mantissa = mantissa
+	number.exponent = exponent
+	return number
+
+
+## Every shorter prefix, a byte more, and a changed version or kind.
+func _corrupted(bytes: PackedByteArray) -> Array[PackedByteArray]:
+	var res: Array[PackedByteArray] = []
+	for length: int in bytes.size():
+		res.append(bytes.slice(0, length))
+	var longer: PackedByteArray = bytes.duplicate()
+	longer.append(0)
+	res.append(longer)
+	for index: int in 2:
+		var changed: PackedByteArray = bytes.duplicate()
+		changed[index] = 99
+		res.append(changed)
+	return res
+
+
+func _expect_rejected_value(bytes: PackedByteArray) -> void:
+	for corrupted: PackedByteArray in _corrupted(bytes):
+		if BigNumber.from_bytes(corrupted) != null:
+			_fail("from_bytes accepted %s" % corrupted)
+	if not BigNumber.decode_array(bytes).is_empty() or BigNumberArray.from_bytes(bytes) != null:
+		_fail("a single value was decoded as an array")
+
+
+func _expect_rejected_array(bytes: PackedByteArray) -> void:
+	for corrupted: PackedByteArray in _corrupted(bytes):
+		if not BigNumber.decode_array(corrupted).is_empty():
+			_fail("decode_array accepted %s" % corrupted)
+		if BigNumberArray.from_bytes(corrupted) != null:
+			_fail("BigNumberArray.from_bytes accepted %s" % corrupted)
+	if BigNumber.from_bytes(bytes) != null:
+		_fail("an array was decoded as a single value")
+
+
+func _expect_same(result: BigNumber, expected: BigNumber, what: String) -> void:
+	if result == null:
+		_fail("%s gave null for %se%d" % [what, expected.mantissa, expected.exponent])
+	elif result.mantissa != expected.mantissa or result.exponent != expected.exponent:
+		_fail("%s gave %se%d instead of %se%d" % [what, result.mantissa, result.exponent, expected.mantissa, expected.exponent])
+
+
+func _expect_array(result: BigNumberArray, expected: Array, what: String) -> void:
+	if result == null or result.size() != expected.size():
+		_fail("%s gave %s" % [what, result])
+		return
+	for i: int in expected.size():
+		_expect_same(result.get_value(i), expected[i], what)
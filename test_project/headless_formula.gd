@@ -0,0 +1,142 @@
+extends SceneTree
+## Headless behaviour test for [BigNumberFormula].
+##
+## Checks operator precedence, the right-associative [code]^[/code], unary
+## minus, the int and float paths of [method BigNumber.power_equals], the
+## functions, parse errors, and that [method BigNumberFormula.evaluate_batch]
+## gives the same result as [method BigNumberFormula.evaluate] for every
+## element.[br][br]
+## Run from the repository root:[br]
+## [code]godot --headless --path test_project --script res://headless_formula.gd[/code][br][br]
+## Exits with code 1 if any result differs.
+
+
+## Elements of the batch checked against evaluate().
+const BATCH_SIZE: int = 300
+
+var failures: int = 0
+
+
+func _initialize() -> void:
+	# Precedence and associativity
+	_expect("2 + 3 * 4", [], 14.0)
+	_expect("(2 + 3) * 4", [], 20.0)
+	_expect("2 * 3 ^ 2", [], 18.0)
+	_expect("2 ^ 3 ^ 2", [], 512.0)
+	_expect("(2 ^ 3) ^ 2", [], 64.0)
+	_expect("20 - 6 - 4", [], 10.0)
+	_expect("64 / 4 / 2", [], 8.0)
+	_expect("10 - 2 ^ 2", [], 6.0)
+
+	# Unary minus, also on the right of ^
+	_expect("-3 + 5", [], 2.0)
+	_expect("2 - -3", [], 5.0)
+	_expect("2 ^ -2", [], 0.25)
+	_expect("x ^ -2", [4], 0.0625)
+	_expect("--x", [7.5], 7.5)
+
+	# An int exponent takes power_int(), a float or BigNumber one power_float()
+	var base: BigNumber = _make(1.07, 0)
+	_expect_same("x ^ y", [base, 50], _make(1.07, 0).power_equals(50), "int exponent")
+	_expect_same("x ^ y", [base, 50.0], _make(1.07, 0).power_equals(50.0), "float exponent")
+	_expect_same("x ^ y", [base, _make(5.0, 1)], _make(1.07, 0).power_equals(_make(5.0, 1)), "BigNumber exponent")
+	_expect_same("x ^ 50", [base], _make(1.07, 0).power_equals(50), "int literal exponent")
+	_expect_same("x ^ 50.0", [base], _make(1.07, 0).power_equals(50.0), "float literal exponent")
+
+	# Functions
+	_expect("min(3, 7)", [], 3.0)
+	_expect("max(3, 7)", [], 7.0)
+	_expect("min(x, y) * max(x, y)", [2.5, 4], 10.0)
+	_expect("floor(12.75)", [], 12.0)
+	_expect("floor(x / 4)", [_make(1.0, 1)], 2.0)
+	_expect("sqrt(x)", [81], 9.0)
+	_expect("abs(x)", [-6], 6.0)
+	_expect_same("max(2.5e400, 1e401)", [], _make(1.0, 401), "max of big literals")
+	_expect_same("min(2.5e400, 1e401)", [], _make(2.5, 400), "min of big literals")
+
+	for expression: String in ["", "2 +", "(1", "1)", "1 2", "1e", "foo(1)", "min(1)", "max(1, 2", "2 * * 3", "."]:
+		_expect_error(expression)
+	var named: BigNumberFormula = BigNumberFormula.new()
+	if named.compile("a + b", ["a"]) != ERR_PARSE_ERROR:
+		_fail("\"a + b\" compiled with only \"a\" declared")
+
+	_check_batch()
+
+	if failures > 0:
+		printerr("FAILED: %d mismatches" % failures)
+		quit(1)
+	else:
+		print("OK")
+		quit(0)
+
+
+func _make(mantissa: float, exponent: int) -> BigNumber:
+	var number: BigNumber = BigNumber.new()
+	number.mantissa = mantissa
+	number.exponent = exponent
+	return number
+
+
+func _compile(expression: String) -> BigNumberFormula:
+	var formula: BigNumberFormula = BigNumberFormula.new()
+	if formula.compile(expression) != OK:
+		_fail("\"%s\" did not compile: %s" % [expression, formula.get_error_text()])
+		return null
+	return formula
+
+
+func _expect(expression: String, values: Array, expected: float) -> void:
+	var formula: BigNumberFormula = _compile(expression)
+	if formula == null:
+		return
+	var result: float = formula.evaluate(values).to_float()
+	if not is_equal_approx(result, expected):
+		_fail("\"%s\" with %s gave %s instead of %s" % [expression, values, result, expected])
+
+
+## The formula must give exactly the mantissa and exponent of the matching
+## BigNumber methods.
+func _expect_same(expression: String, values: Array, expected: BigNumber, what: String) -> void:
+	var formula: BigNumberFormula = _compile(expression)
+	if formula == null:
+		return
+	var result: BigNumber = formula.evaluate(values)
+	if result.mantissa != expected.mantissa or result.exponent != expected.exponent:
+		_fail("%s: \"%s\" gave %se%d instead of %se%d" % [what, expression, result.mantissa, result.exponent, expected.mantissa, expected.exponent])
+
+
+func _expect_error(expression: String) -> void:
+	var formula: BigNumberFormula = BigNumberFormula.new()
+	if formula.compile(expression) != ERR_PARSE_ERROR:
+		_fail("\"%s\" compiled" % expression)
+	elif formula.is_compiled() or formula.get_error_text().is_empty():
+		_fail("\"%s\" failed without an error text" % expression)
+
+
+func _check_batch() -> void:
+	var formula: BigNumberFormula = _compile("base * growth ^ level * (1 - discount) + max(level, 10) / 3")
+	if formula == null:
+		return
+
+	var base: BigNumber = _make(1.5, 1)
+	var growths: PackedFloat64Array
+	var levels: PackedInt64Array
+	for i: int in BATCH_SIZE:
+		growths.append(1.01 + 0.001 * i)
+		levels.append(i * 7)
+
+	var batch: BigNumberArray = formula.evaluate_batch([base, growths, levels, 0.1])
+	if batch == null or batch.size() != BATCH_SIZE:
+		_fail("evaluate_batch gave %s" % batch)
+		return
+	for i: int in BATCH_SIZE:
+		var expected: BigNumber = formula.evaluate([base, growths[i], levels[i], 0.1])
+		var result: BigNumber = batch.get_value(i)
+		if result.mantissa != expected.mantissa or result.exponent != expected.exponent:
+			_fail("evaluate_batch element %d gave %se%d instead of %se%d" % [i, result.mantissa, result.exponent, expected.mantissa, expected.exponent])
+			return
+
+
+func _fail(message: String) -> void:
+	failures += 1
+	printerr(message)
@@ -0,0 +1,101 @@
+extends SceneTree
+## Headless round-trip test for [BigNumberLedger].
+##
+## Checks [method BigNumberLedger.advance_ticks] against ticking the chain
+## one step at a time with plain floats, that two [method BigNumberLedger.advance]
+## calls add up to one over the whole span, that [method BigNumberLedger.predict]
+## matches [method BigNumberLedger.advance], and that invalid times leave the
+## ledger unchanged.[br][br]
+## Run from the repository root:[br]
+## [code]godot --headless --path test_project --script res://headless_ledger.gd[/code][br][br]
+## Exits with code 1 if any result differs.
+
+
+const AMOUNTS: Array[float] = [100.0, 5.0, 1.0, 0.5]
+const RATES: Array[float] = [1.0, 2.0, 0.1, 0.25]
+
+var failures: int = 0
+
+
+func _initialize() -> void:
+	for ticks: int in [0, 1, 7, 50, 400]:
+		_check_ticks(ticks, 0.5)
+	_check_ticks(30, 1.0 / 60.0)
+
+	for seconds: float in [0.0, 1.0, 12.5, 3600.0]:
+		_check_split(seconds)
+
+	var ledger: BigNumberLedger = _make_ledger()
+	for seconds: float in [-1.0, NAN, INF]:
+		ledger.advance(seconds)
+		ledger.advance_ticks(5, seconds)
+		if ledger.predict(0, seconds) != null:
+			_fail("predict accepted %s seconds" % seconds)
+	ledger.advance_ticks(-5, 1.0)
+	for tier: int in AMOUNTS.size():
+		_expect(ledger.get_amount(tier), AMOUNTS[tier], "tier %d after invalid times" % tier)
+
+	if failures > 0:
+		printerr("FAILED: %d mismatches" % failures)
+		quit(1)
+	else:
+		print("OK")
+		quit(0)
+
+
+func _make_ledger() -> BigNumberLedger:
+	var ledger: BigNumberLedger = BigNumberLedger.new()
+	ledger.tier_count = AMOUNTS.size()
+	for tier: int in AMOUNTS.size():
+		ledger.set_amount(tier, AMOUNTS[tier])
+		ledger.set_rate(tier, RATES[tier])
+	return ledger
+
+
+func _check_ticks(ticks: int, tick_seconds: float) -> void:
+	# Every tier adds amount * rate * tick_seconds to the one below, from
+	# the amounts at the start of the step
+	var stepped: Array[float] = AMOUNTS.duplicate()
+	for step: int in ticks:
+		var start: Array[float] = stepped.duplicate()
+		for tier: int in range(1, start.size()):
+			stepped[tier - 1] += start[tier] * RATES[tier] * tick_seconds
+
+	var ledger: BigNumberLedger = _make_ledger()
+	ledger.advance_ticks(ticks, tick_seconds)
+	var one_by_one: BigNumberLedger = _make_ledger()
+	for step: int in ticks:
+		one_by_one.advance_ticks(1, tick_seconds)
+
+	for tier: int in stepped.size():
+		var what: String = "tier %d after %d ticks of %s" % [tier, ticks, tick_seconds]
+		_expect(ledger.get_amount(tier), stepped[tier], what)
+		_expect(one_by_one.get_amount(tier), stepped[tier], what + " one at a time")
+		_expect(_make_ledger().predict_ticks(tier, ticks, tick_seconds), stepped[tier], what + ", predicted")
+
+
+func _check_split(seconds: float) -> void:
+	var whole: BigNumberLedger = _make_ledger()
+	var predicted: Array[BigNumber] = []
+	for tier: int in AMOUNTS.size():
+		predicted.append(whole.predict(tier, seconds))
+	whole.advance(seconds)
+
+	var split: BigNumberLedger = _make_ledger()
+	split.advance(seconds * 0.25)
+	split.advance(seconds * 0.75)
+
+	for tier: int in AMOUNTS.size():
+		var expected: float = whole.get_amount(tier).to_float()
+		_expect(split.get_amount(tier), expected, "tier %d after %s seconds in two steps" % [tier, seconds])
+		_expect(predicted[tier], expected, "tier %d predicted for %s seconds" % [tier, seconds])
+
+
+func _expect(result: BigNumber, expected: float, what: String) -> void:
+	if result == null or not is_equal_approx(result.to_float(), expected):
+		_fail("%s gave %s instead of %s" % [what, result.to_float() if result != null else null, expected])
+
+
+func _fail(message: String) -> void:
+	failures += 1
+	printerr(message)
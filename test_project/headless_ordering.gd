@@ -0,0 +1,103 @@
+extends SceneTree
+## Headless ordering test for the BigNumberArray sorting and reductions.
+##
+## Sorts values that mix zeros with values below 0.1, where
+## [method BigNumber.is_less_than] is not a valid sort ordering, and checks
+## [method BigNumberArray.sort], [method BigNumberArray.argsort],
+## [method BigNumberArray.top_k], [method BigNumberArray.argmin],
+## [method BigNumberArray.argmax], [method BigNumberArray.sort_values] and
+## [method BigNumberArray.to_sort_keys] against the order of the plain floats.[br][br]
+## Run from the repository root:[br]
+## [code]godot --headless --path test_project --script res://headless_ordering.gd[/code][br][br]
+## Exits with code 1 if any result differs.
+
+
+## Random arrays checked after the fixed cases.
+const RANDOM_ARRAYS: int = 200
+## Elements per random array.
+const RANDOM_SIZE: int = 64
+
+var failures: int = 0
+
+
+func _initialize() -> void:
+	_check(PackedFloat64Array([0.5, 0.0, 0.02, 0.0, 0.7, 1.0]))
+	_check(PackedFloat64Array([0.0, 0.001, 0.0, 0.09, 0.0]))
+	_check(PackedFloat64Array([0.05, 0.0, 5.0, 0.0, 0.5, 500.0, 0.0005]))
+
+	var rng: RandomNumberGenerator = RandomNumberGenerator.new()
+	rng.seed = 12345
+	for i: int in RANDOM_ARRAYS:
+		var values: PackedFloat64Array
+		for j: int in RANDOM_SIZE:
+			# A third zeros, the rest spread from 1e-6 to 1e6
+			values.append(0.0 if rng.randi() % 3 == 0 else snappedf(rng.randf_range(1.0, 10.0), 0.01) * pow(10.0, rng.randi_range(-6, 6)))
+		_check(values)
+
+	if failures > 0:
+		printerr("FAILED: %d mismatches" % failures)
+		quit(1)
+	else:
+		print("OK")
+		quit(0)
+
+
+func _check(values: PackedFloat64Array) -> void:
+	var expected: PackedFloat64Array = values.duplicate()
+	expected.sort()
+
+	var array: BigNumberArray = BigNumberArray.new()
+	array.set_from_floats(values)
+
+	var order: PackedInt64Array = array.argsort()
+	var by_index: PackedFloat64Array
+	for index: int in order:
+		by_index.append(values[index])
+	_expect(by_index, expected, "argsort", values)
+	# Stable: equal values keep their relative order
+	for i: int in range(1, order.size()):
+		if values[order[i - 1]] == values[order[i]] and order[i - 1] > order[i]:
+			_fail("argsort is not stable", values)
+
+	var largest: PackedInt64Array = array.top_k(3)
+	for i: int in largest.size():
+		_expect_value(values[largest[i]], expected[expected.size() - 1 - i], "top_k", values)
+
+	_expect_value(values[array.argmin()], expected[0], "argmin", values)
+	_expect_value(values[array.argmax()], expected[expected.size() - 1], "argmax", values)
+
+	var keys: PackedInt64Array = array.to_sort_keys()
+	for i: int in range(1, order.size()):
+		if keys[order[i - 1]] > keys[order[i]]:
+			_fail("sort keys disagree with argsort", values)
+
+	var numbers: Array = []
+	for i: int in values.size():
+		numbers.append(array.get_value(i))
+	BigNumberArray.sort_values(numbers)
+	var sorted_numbers: PackedFloat64Array
+	for number: BigNumber in numbers:
+		sorted_numbers.append(number.to_float())
+	_expect(sorted_numbers, expected, "sort_values", values)
+
+	array.sort(true)
+	expected.reverse()
+	_expect(array.to_floats(), expected, "sort descending", values)
+
+
+func _expect(result: PackedFloat64Array, expected: PackedFloat64Array, what: String, values: PackedFloat64Array) -> void:
+	for i: int in expected.size():
+		if not is_equal_approx(result[i], expected[i]):
+			_fail("%s gave %s" % [what, result], values)
+			return
+
+
+func _expect_value(result: float, expected: float, what: String, values: PackedFloat64Array) -> void:
+	if not is_equal_approx(result, expected):
+		_fail("%s gave %s instead of %s" % [what, result, expected], values)
+
+
+func _fail(message: String, values: PackedFloat64Array) -> void:
+	failures += 1
+	if failures <= 5:
+		printerr("%s for %s" % [message, values])
@@ -0,0 +1,97 @@
+extends SceneTree
+## Headless round-trip test for [method BigNumber.parse].
+##
+## Formats values with every formatter that [method BigNumber.parse] reads,
+## under the default options and under a European decimal separator, and
+## checks that each string parses back to a value that formats to the same
+## string and stays within the digits the formatter shows. Also checks that
+## [method BigNumber.to_plain_scientific] reads back through the [String]
+## arguments of the arithmetic methods.[br][br]
+## Run from the repository root:[br]
+## [code]godot --headless --path test_project --script res://headless_parse.gd[/code][br][br]
+## Exits with code 1 if any result differs.
+
+
+## Random values checked after the fixed ones.
+const RANDOM_VALUES: int = 300
+## Largest relative difference between a value and its parsed output. The
+## shortest formats keep three significant digits.
+const TOLERANCE: float = 0.01
+
+var failures: int = 0
+
+
+func _initialize() -> void:
+	var numbers: Array[BigNumber] = [_make(1.0, 0), _make(9.99, 2), _make(1.0, 3), _make(1.5, 6), _make(2.5, 33), _make(7.25, 303), _make(1.0, 1000)]
+	var rng: RandomNumberGenerator = RandomNumberGenerator.new()
+	rng.seed = 12345
+	for i: int in RANDOM_VALUES:
+		numbers.append(_make(snappedf(rng.randf_range(1.0, 10.0), 0.0001), rng.randi_range(0, 400)))
+
+	var defaults: Dictionary = BigNumber.get_options().duplicate()
+	for number: BigNumber in numbers:
+		_check(number)
+
+	var european: Dictionary = defaults.duplicate()
+	european.decimal_separator = ","
+	european.thousand_separator = "."
+	european.suffix_separator = " "
+	BigNumber.set_options(european)
+	for number: BigNumber in numbers:
+		_check(number)
+	BigNumber.set_options(defaults)
+
+	if failures > 0:
+		printerr("FAILED: %d mismatches" % failures)
+		quit(1)
+	else:
+		print("OK")
+		quit(0)
+
+
+func _make(mantissa: float, exponent: int) -> BigNumber:
+	var number: BigNumber = BigNumber.new()
+	number.mantissa = mantissa
+	number.exponent = exponent
+	return number
+
+
+func _check(number: BigNumber) -> void:
+	for notation: int in 6:
+		var text: String = _format(number, notation)
+		var parsed: BigNumber = BigNumber.parse(text)
+		if parsed == null:
+			_fail("\"%s\" did not parse" % text)
+			continue
+		if _format(parsed, notation) != text:
+			_fail("\"%s\" parsed to %s, which formats to \"%s\"" % [text, parsed.to_plain_scientific(), _format(parsed, notation)])
+		elif absf(parsed.divide(number).to_float() - 1.0) > TOLERANCE:
+			_fail("\"%s\" parsed to %s instead of about %s" % [text, parsed.to_plain_scientific(), number.to_plain_scientific()])
+
+	# The String arguments of the arithmetic methods read the plain output
+	var plain: String = number.to_plain_scientific()
+	var read: BigNumber = _make(1.0, 0).multiply_equals(plain)
+	if read.exponent != number.exponent or not is_equal_approx(read.mantissa, number.mantissa):
+		_fail("\"%s\" read back as %se%d" % [plain, read.mantissa, read.exponent])
+
+
+func _format(number: BigNumber, notation: int) -> String:
+	match notation:
+		0:
+			return number.to_scientific()
+		1:
+			return number.to_aa(false, true, true)
+		2:
+			return number.to_aa()
+		3:
+			return number.to_metric_symbol()
+		4:
+			return number.to_metric_name()
+		_:
+			return number.to_short_scale()
+
+
+func _fail(message: String) -> void:
+	failures += 1
+	if failures <= 20:
+		printerr(message)
@@ -0,0 +1,223 @@
+extends SceneTree
+## Headless thread-safety stress test for the BigNumber GDExtension.
+##
+## Formats, parses and computes the same values from many [WorkerThreadPool]
+## tasks at once, while the main thread keeps switching the formatting options
+## and the format cache capacity. The options switch through
+## [method BigNumber.set_options] and through in-place edits of the
+## [method BigNumber.get_options] dictionary. Every result is checked against
+## strings computed up front on a single thread: every formatted string must
+## match the expected string of one of the two option sets exactly.[br][br]
+## Run from the repository root:[br]
+## [code]godot --headless --path test_project --script res://headless_stress.gd[/code][br][br]
+## Options, after [code]--[/code]:[br]
+## [code]--tasks=<n>[/code] number of worker tasks.[br]
+## [code]--rounds=<n>[/code] passes over every value per task.[br][br]
+## Exits with code 1 if any result differs.
+
+
+## Value count, spread over every notation range.
+const VALUE_COUNT: int = 96
+## Position of [method BigNumber.to_short_scale] in [method _format_one].
+const SHORT_SCALE_INDEX: int = 8
+## Size of the array that takes the parallel path of
+## [method BigNumberArray.format], above the default parallel threshold.
+const LARGE_ARRAY_SIZE: int = 40000
+## Rounds between two formats of the large array, per task.
+const LARGE_ARRAY_INTERVAL: int = 50
+
+## Worker tasks running at once.
+var tasks: int = 16
+## Passes over every value per task.
+var rounds: int = 200
+
+## Options the main thread switches between.
+var options_a: Dictionary
+var options_b: Dictionary
+
+# Inputs and their expected results, read-only while the tasks run
+var mantissas: PackedFloat64Array
+var exponents: PackedInt64Array
+var large_array: BigNumberArray
+var expected_a: Array[PackedStringArray] = []
+var expected_b: Array[PackedStringArray] = []
+var expected_products: PackedStringArray
+var parse_texts: PackedStringArray
+var expected_parsed: PackedStringArray
+
+var failures_mutex: Mutex = Mutex.new()
+var failures: int = 0
+var first_failure: String = ""
+
+
+func _initialize() -> void:
+	_parse_arguments()
+	_setup_values()
+
+	options_a = BigNumber.get_options().duplicate()
+	options_b = options_a.duplicate()
+	options_b.suffix_separator = " "
+	options_b.decimal_separator = ","
+	options_b.thousand_separator = "."
+	options_b.scientific_decimals = 3
+	options_b.small_decimals = 1
+	options_b.big_decimals = 3
+
+	BigNumber.set_options(options_b)
+	expected_b = _format_all()
+	BigNumber.set_options(options_a)
+	expected_a = _format_all()
+
+	var start: int = Time.get_ticks_msec()
+	var group: int = WorkerThreadPool.add_group_task(_run_task, tasks, tasks, true)
+	var switches: int = 0
+	while not WorkerThreadPool.is_group_task_completed(group):
+		var target: Dictionary = options_b if switches % 2 == 0 else options_a
+		if switches % 4 < 2:
+			BigNumber.set_options(target)
+		else:
+			BigNumber.get_options().merge(target, true)
+		BigNumber.set_format_cache_capacity(0 if switches % 3 == 0 else 64)
+		switches += 1
+		OS.delay_usec(100)
+	WorkerThreadPool.wait_for_group_task_completion(group)
+
+	# An in-place edit applies to the next formatting call
+	BigNumber.get_options().merge(options_b, true)
+	if _format_one(_make(0)) != expected_b[0]:
+		_fail("in-place option edits were ignored")
+	BigNumber.set_options(options_a)
+	BigNumber.set_format_cache_capacity(0)
+
+	print("%d tasks x %d rounds x %d values, %d option switches, %d ms" % [
+			tasks, rounds, VALUE_COUNT, switches, Time.get_ticks_msec() - start])
+	if failures > 0:
+		printerr("FAILED: %d mismatches, first: %s" % [failures, first_failure])
+		quit(1)
+	else:
+		print("OK")
+		quit(0)
+
+
+## Reads the options passed after [code]--[/code].
+func _parse_arguments() -> void:
+	for argument: String in OS.get_cmdline_user_args():
+		var key: String = argument.get_slice("=", 0)
+		var value: String = argument.get_slice("=", 1)
+		match key:
+			"--tasks":
+				tasks = maxi(1, value.to_int())
+			"--rounds":
+				rounds = maxi(1, value.to_int())
+			_:
+				printerr("Unknown option %s" % argument)
+
+
+func _setup_values() -> void:
+	var rng: RandomNumberGenerator = RandomNumberGenerator.new()
+	rng.seed = 12345
+	for i: int in VALUE_COUNT:
+		mantissas.append(snappedf(rng.randf_range(1.0, 10.0), 0.0001))
+		# Small values, every suffix table and past the end of the tables
+		exponents.append(i % 8 if i < 16 else rng.randi_range(0, 80))
+
+	for i: int in VALUE_COUNT:
+		var product: BigNumber = _make(i)
+		product.multiply_equals(_make((i + 1) % VALUE_COUNT))
+		product.plus_equals(_make((i + 2) % VALUE_COUNT))
+		expected_products.append(product.to_plain_scientific())
+
+		# No separators, so both option sets read it the same way
+		parse_texts.append("%de%d" % [roundi(mantissas[i] * 10000.0), exponents[i]])
+		expected_parsed.append(BigNumber.parse(parse_texts[i]).to_plain_scientific())
+
+	# Every value repeated, element i is value i % VALUE_COUNT
+	var large_mantissas: PackedFloat64Array
+	var large_exponents: PackedInt64Array
+	for i: int in LARGE_ARRAY_SIZE:
+		large_mantissas.append(mantissas[i % VALUE_COUNT])
+		large_exponents.append(exponents[i % VALUE_COUNT])
+	large_array = BigNumberArray.new()
+	large_array.set_from_parts(large_mantissas, large_exponents)
+	if LARGE_ARRAY_SIZE < BigNumberArray.get_parallel_threshold():
+		printerr("The large array is below the parallel threshold")
+
+
+func _make(index: int) -> BigNumber:
+	var number: BigNumber = BigNumber.new()
+	number.mantissa = mantissas[index]
+	number.exponent = exponents[index]
+	return number
+
+
+## Every formatter output of one value, in a fixed order.
+func _format_one(number: BigNumber) -> PackedStringArray:
+	return PackedStringArray([
+		number.to_scientific(),
+		number.to_scientific(true, true),
+		number.to_prefix(),
+		number.to_prefix(false, false, false, true),
+		number.to_aa(),
+		number.to_aa(true, false, true),
+		number.to_metric_symbol(),
+		number.to_metric_name(),
+		number.to_short_scale(),
+		number.format(BigNumber.NOTATION_AA, BigNumber.FORMAT_USE_THOUSAND_SYMBOL),
+		BigNumberLog.from_value(number).to_aa(),
+	])
+
+
+func _format_all() -> Array[PackedStringArray]:
+	var res: Array[PackedStringArray] = []
+	for i: int in VALUE_COUNT:
+		res.append(_format_one(_make(i)))
+	return res
+
+
+func _run_task(task: int) -> void:
+	var array: BigNumberArray = BigNumberArray.new()
+	array.set_from_parts(mantissas, exponents)
+
+	for pass_index: int in rounds:
+		for j: int in VALUE_COUNT:
+			# Each task walks the values from a different start
+			var i: int = (j + task * 7) % VALUE_COUNT
+			var number: BigNumber = _make(i)
+			# The options can switch between two calls, so each string is
+			# checked on its own
+			var strings: PackedStringArray = _format_one(number)
+			for k: int in strings.size():
+				if strings[k] != expected_a[i][k] and strings[k] != expected_b[i][k]:
+					_fail("value %d formatted as \"%s\"" % [i, strings[k]])
+
+			var product: BigNumber = _make(i)
+			product.multiply_equals(_make((i + 1) % VALUE_COUNT))
+			product.plus_equals(_make((i + 2) % VALUE_COUNT))
+			if product.to_plain_scientific() != expected_products[i]:
+				_fail("value %d computed as %s" % [i, product.to_plain_scientific()])
+
+			var parsed: BigNumber = BigNumber.parse(parse_texts[i])
+			if parsed == null or parsed.to_plain_scientific() != expected_parsed[i]:
+				_fail("\"%s\" parsed wrong" % parse_texts[i])
+
+		var formatted: PackedStringArray = array.format(BigNumber.NOTATION_SHORT_SCALE)
+		for i: int in VALUE_COUNT:
+			if formatted[i] != expected_a[i][SHORT_SCALE_INDEX] and formatted[i] != expected_b[i][SHORT_SCALE_INDEX]:
+				_fail("array element %d formatted as %s" % [i, formatted[i]])
+
+		# Parallel path, from inside a pool task while the options change
+		if pass_index % LARGE_ARRAY_INTERVAL == task % LARGE_ARRAY_INTERVAL:
+			var large: PackedStringArray = large_array.format(BigNumber.NOTATION_SHORT_SCALE)
+			for i: int in LARGE_ARRAY_SIZE:
+				var value: int = i % VALUE_COUNT
+				if large[i] != expected_a[value][SHORT_SCALE_INDEX] and large[i] != expected_b[value][SHORT_SCALE_INDEX]:
+					_fail("large array element %d formatted as %s" % [i, large[i]])
+					break
+
+
+func _fail(message: String) -> void:
+	failures_mutex.lock()
+	failures += 1
+	if first_failure.is_empty():
+		first_failure = message
+	failures_mutex.unlock()
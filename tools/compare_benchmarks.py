@@ -0,0 +1,106 @@
+"""Compare two JSON reports written by test_project/headless_benchmark.gd.
+
+Usage:
+    python tools/compare_benchmarks.py old.json new.json [--threshold 5] [--fail-on-regression]
+
+A case counts as slower or faster when its median moved by more than the
+threshold (in percent) AND the change is larger than the spread between the
+median and p95 of the old run. That way a noisy case does not show up as a
+regression. Allocation changes are always reported.
+"""
+import argparse
+import json
+import sys
+from typing import Dict, List, Tuple
+
+
+def load_report(path: str) -> Dict:
+    """Load a report, exiting with a message when it is not a benchmark report."""
+    try:
+        with open(path, "r", encoding="utf-8") as f:
+            report = json.load(f)
+    except (OSError, json.JSONDecodeError) as e:
+        print(f"Error: could not read '{path}': {e}")
+        sys.exit(2)
+
+    if "results" not in report:
+        print(f"Error: '{path}' is not a benchmark report.")
+        sys.exit(2)
+    return report
+
+
+def classify(old: Dict, new: Dict, threshold: float) -> Tuple[float, str]:
+    """Return the median change in percent and a verdict for one case."""
+    old_median = old["median_ns"]
+    new_median = new["median_ns"]
+    if old_median <= 0.0:
+        return 0.0, "same"
+
+    change = (new_median - old_median) / old_median * 100.0
+    noise = max(old["p95_ns"] - old_median, 0.0)
+    if abs(change) <= threshold or abs(new_median - old_median) <= noise:
+        return change, "same"
+    return change, "slower" if change > 0.0 else "faster"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Compare two BigNumber benchmark reports.")
+    parser.add_argument("old", help="Baseline report")
+    parser.add_argument("new", help="Report to compare against the baseline")
+    parser.add_argument("--threshold", type=float, default=5.0, help="Median change in percent to report (default 5)")
+    parser.add_argument("--fail-on-regression", action="store_true", help="Exit with status 1 if any case got slower or allocates more")
+    args = parser.parse_args()
+
+    old_report = load_report(args.old)
+    new_report = load_report(args.new)
+    old_results = old_report["results"]
+    new_results = new_report["results"]
+
+    for key in ("engine", "build", "processor"):
+        if old_report.get(key) != new_report.get(key):
+            print(f"Warning: {key} differs ({old_report.get(key)} vs {new_report.get(key)}), results may not be comparable.")
+
+    rows: List[Tuple[str, float, float, float, str, str]] = []
+    regressions = 0
+    for name in sorted(set(old_results) & set(new_results)):
+        old = old_results[name]
+        new = new_results[name]
+        change, verdict = classify(old, new, args.threshold)
+
+        notes = []
+        old_allocations = old.get("allocations_per_call", 0.0)
+        new_allocations = new.get("allocations_per_call", 0.0)
+        if abs(new_allocations - old_allocations) > 1e-9:
+            notes.append(f"allocations {old_allocations:g} -> {new_allocations:g}")
+            if new_allocations > old_allocations:
+                regressions += 1
+        if verdict == "slower":
+            regressions += 1
+
+        rows.append((name, old["median_ns"], new["median_ns"], change, verdict, ", ".join(notes)))
+
+    print(f"{'case':<40} {'old ns':>10} {'new ns':>10} {'change':>9}  verdict")
+    for name, old_median, new_median, change, verdict, notes in rows:
+        line = f"{name:<40} {old_median:>10.1f} {new_median:>10.1f} {change:>+8.1f}%  {verdict}"
+        if notes:
+            line += f"  ({notes})"
+        print(line)
+
+    only_old = sorted(set(old_results) - set(new_results))
+    only_new = sorted(set(new_results) - set(old_results))
+    if only_old:
+        print(f"\nOnly in {args.old}: {', '.join(only_old)}")
+    if only_new:
+        print(f"\nOnly in {args.new}: {', '.join(only_new)}")
+
+    slower = sum(1 for row in rows if row[4] == "slower")
+    faster = sum(1 for row in rows if row[4] == "faster")
+    print(f"\n{len(rows)} cases compared: {slower} slower, {faster} faster, threshold {args.threshold:g}%")
+
+    if args.fail_on_regression and regressions > 0:
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())